@@ -22,6 +22,8 @@
 extern int clm_iefb_handle_input_frame (
    clm_t * clm,
    uint32_t now,
+   uint32_t port_timestamp,
+   bool port_timestamp_valid,
    uint8_t * buffer,
    size_t recv_len,
    cl_ipaddr_t remote_ip,
@@ -95,13 +97,15 @@ int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size)
    clm_iefb_handle_input_frame (
       &clm,
       0,
+      0,
+      false,
       (uint8_t *)data,
       size,
       cfg.hier.groups[0].slave_devices[0].slave_id, /* Remote IP */
       CL_CCIEFB_PORT);
 
    /* Check if timers have triggered, after 1 simulated second */
-   clm_iefb_monitor_all_group_timers (&clm, 1000000);
+   clm_iefb_monitor_timers (&clm, 1000000);
 
    return 0;
 }
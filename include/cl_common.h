@@ -56,6 +56,78 @@ typedef enum cl_slave_appl_operation_status
    CL_SLAVE_APPL_OPERATION_STATUS_OPERATING = 1,
 } cl_slave_appl_operation_status_t;
 
+/** Max number of sockets that the stack application needs to monitor
+    for incoming data. */
+#define CL_MAX_SOCKETS 3
+
+/** Role of a socket used by the c-link stack.
+    This enum is used by both slave and master. */
+typedef enum cl_socket_role
+{
+   /** CCIEFB cyclic data */
+   CL_SOCKET_ROLE_CCIEFB = 0,
+
+   /** CCIEFB frames from other masters. Master only, and only if
+       \a use_separate_arbitration_socket is enabled. */
+   CL_SOCKET_ROLE_CCIEFB_ARBITRATION,
+
+   /** Incoming SLMP frames (node search, set IP address) */
+   CL_SOCKET_ROLE_SLMP,
+} cl_socket_role_t;
+
+/** Socket used by the c-link stack, for monitoring incoming data in an
+    external event loop. */
+typedef struct cl_socket_info
+{
+   /** Socket handle, as used by the platform abstraction layer. On Linux
+       this is a file descriptor. */
+   int handle;
+
+   /** What the socket is used for */
+   cl_socket_role_t role;
+} cl_socket_info_t;
+
+/** Max socket priority that can be set without special privileges */
+#define CL_SOCKET_PRIORITY_MAX 6
+
+/** Max DSCP value (6 bits) */
+#define CL_SOCKET_DSCP_MAX 63
+
+/** Socket tuning for the CCIEFB cyclic data socket(s).
+    Used by both slave and master.
+
+    All fields default to zero/false, which leaves the operating system
+    settings unchanged. Settings not supported by the platform are ignored,
+    and reported back as zero/false. */
+typedef struct cl_socket_profile
+{
+   /** Busy poll time in microseconds when receiving (SO_BUSY_POLL on
+       Linux). Use 0 to disable. */
+   uint32_t busy_poll_us;
+
+   /** Receive buffer size in bytes (SO_RCVBUF on Linux). Use 0 to keep the
+       operating system default. Ignored if
+       \a receive_buffer_for_burst is enabled. */
+   uint32_t receive_buffer_size;
+
+   /** Size the receive buffer for the worst case burst of incoming CCIEFB
+       frames, as calculated by the stack from the configuration. */
+   bool receive_buffer_for_burst;
+
+   /** Socket priority for outgoing frames (SO_PRIORITY on Linux).
+       Allowed 0..CL_SOCKET_PRIORITY_MAX, where 0 keeps the default. */
+   uint8_t priority;
+
+   /** DSCP value for outgoing frames, placed in the IP header TOS field.
+       Allowed 0..CL_SOCKET_DSCP_MAX, where 0 keeps the default. */
+   uint8_t dscp;
+
+   /** Queue ICMP errors on the socket instead of silently dropping them
+       (IP_RECVERR on Linux). The stack reads the queued errors, logs them
+       and counts them in the socket statistics. */
+   bool enable_error_queue;
+} cl_socket_profile_t;
+
 /** Number of words (16-bit registers) in one RWr or RWw area */
 #define CL_WORDSIGNALS_PER_AREA 32
 
@@ -102,6 +174,28 @@ typedef struct cl_rx
    uint8_t bytes[CL_BYTES_PER_BITAREA];
 } cl_rx_t;
 
+/** Max number of occupied stations for one slave device */
+#define CL_MAX_OCCUPIED_STATIONS_PER_DEVICE 16
+
+/** Changed incoming cyclic data for a slave device, with one bit per signal.
+    For the master this is RX and RWr, and for the slave RY and RWw.
+
+    Area 0 is the first occupied station of the slave device. */
+typedef struct cl_changed_signals
+{
+   /** Number of occupied stations. The first \a num_occupied_stations
+       elements in \a bits and \a words are valid. */
+   uint16_t num_occupied_stations;
+
+   /** Changed bit signals. Bit n is set if bit signal n in the area has
+       changed. */
+   uint64_t bits[CL_MAX_OCCUPIED_STATIONS_PER_DEVICE];
+
+   /** Changed word signals (registers). Bit n is set if register n in the
+       area has changed. */
+   uint32_t words[CL_MAX_OCCUPIED_STATIONS_PER_DEVICE];
+} cl_changed_signals_t;
+
 /**
  * Get c-link stack version
  *
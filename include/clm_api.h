@@ -110,13 +110,18 @@ typedef enum clm_device_state
 
 /** Error messages reported in the callback \a clm_error_ind_t()
  *  Literals are implemented in the internal function
- *  cl_literals_get_master_error_message() */
+ *  cl_literals_get_master_error_message()
+ *
+ *  For CLM_ERROR_CCIEFB_FRAMES_DROPPED the IP address is the master IP
+ *  address, and argument_2 is the number of incoming frames dropped by the
+ *  operating system. */
 typedef enum clm_error_message
 {
    CLM_ERROR_ARBITRATION_FAILED,
    CLM_ERROR_SLAVE_DUPLICATION,
    CLM_ERROR_SLAVE_REPORTS_WRONG_NUMBER_OCCUPIED,
-   CLM_ERROR_SLAVE_REPORTS_MASTER_DUPLICATION
+   CLM_ERROR_SLAVE_REPORTS_MASTER_DUPLICATION,
+   CLM_ERROR_CCIEFB_FRAMES_DROPPED
 } clm_error_message_t;
 
 /**
@@ -280,6 +285,57 @@ typedef void (*clm_changed_slave_info_ind_t) (
    uint16_t slave_err_code,
    uint32_t local_management_info);
 
+/**
+ * Indication to the application that incoming cyclic data (RX or RWr) from
+ * a slave device has changed.
+ *
+ * Called when a response frame is stored, with the signals that changed
+ * compared to the previously stored data. If the cyclic transmission bit
+ * for the slave device is off when the response frame is stored, the data is
+ * stored as zeros, which also might change signals. A disconnect by itself
+ * does not change the stored data, so it is not reported here.
+ *
+ * It is optional to implement this callback.
+ *
+ * @param clm                    The master stack instance
+ * @param arg                    User-defined data (not used by c-link)
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param changed                Changed RX bits and RWr registers. Area 0 is
+ *                               the first occupied station of the device.
+ */
+typedef void (*clm_inputs_changed_ind_t) (
+   clm_t * clm,
+   void * arg,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   const cl_changed_signals_t * changed);
+
+/** Statistics for a CCIEFB socket in the master */
+typedef struct clm_socket_statistics
+{
+   /** True if the platform reports the number of incoming frames dropped
+       by the operating system (SO_RXQ_OVFL on Linux). If false, the
+       other fields are zero. */
+   bool drops_available;
+
+   /** Number of incoming frames dropped by the operating system before
+       reaching the stack, for example due to a full receive buffer */
+   uint32_t number_of_dropped_frames;
+
+   /** Number of receive batches where dropped frames were detected */
+   uint32_t number_of_drop_events;
+
+   /** Latest cumulative drop counter reported by the operating system for
+       the socket. Not affected by \a clm_clear_statistics(). */
+   uint32_t os_drop_counter;
+
+   /** Number of ICMP errors read from the socket error queue. Only used if
+       \a enable_error_queue is set in the socket profile. */
+   uint32_t number_of_icmp_errors;
+} clm_socket_statistics_t;
+
 /** For reporting back the master status details to users */
 typedef struct clm_master_status_details
 {
@@ -297,6 +353,35 @@ typedef struct clm_master_status_details
     */
    int set_ip_request_serial;
 
+   /** Socket tuning actually applied to the CCIEFB socket. Settings not
+       supported by the platform are reported as zero/false. The resulting
+       receive buffer size is reported also when sized for burst. */
+   cl_socket_profile_t cciefb_socket_profile;
+
+   /** Socket tuning actually applied to the CCIEFB arbitration socket.
+       Only used if \a use_separate_arbitration_socket is enabled. */
+   cl_socket_profile_t arbitration_socket_profile;
+
+   /** Statistics for the CCIEFB socket */
+   clm_socket_statistics_t cciefb_socket_statistics;
+
+   /** Statistics for the CCIEFB arbitration socket. Only used if
+       \a use_separate_arbitration_socket is enabled. */
+   clm_socket_statistics_t arbitration_socket_statistics;
+
+   /** Number of incoming frames and events dropped because the queue to a
+       shard was full. Only used if \a number_of_shards is larger than 1. */
+   uint32_t shard_queue_overflows;
+
+   /** Number of application callbacks dropped because the callback queue
+       was full. Only used if \a use_async_callbacks is enabled or
+       \a number_of_shards is larger than 1. */
+   uint32_t callback_queue_overflows;
+
+   /** Number of link scan callbacks merged into an identical queued
+       callback. Only used if \a coalesce_linkscan_callbacks is enabled. */
+   uint32_t coalesced_linkscan_callbacks;
+
 } clm_master_status_details_t;
 
 /** For reporting back the group status details to users */
@@ -322,8 +407,40 @@ typedef struct clm_group_status_details
    /** Group state */
    clm_group_state_t group_state;
 
+   /** Slave devices that the current link scan waits for. Bit n is set for
+    *  slave device index n. */
+   uint16_t awaiting_responses;
+
+   /** Slave devices that did not respond in the latest link scan. Bit n is
+    *  set for slave device index n. Zero if the latest link scan completed.
+    *  Useful in the \a linkscan_cb callback when the link scan timed out. */
+   uint16_t missing_responses;
+
 } clm_group_status_details_t;
 
+/** Consistent copy of the incoming cyclic data (RX and RWr), for
+ *  applications reading the data from another thread than the stack.
+ *  The data is little endian, as in the frames. */
+typedef struct clm_input_snapshot
+{
+   /** Frame sequence number of the link scan where the latest of the data
+    *  was received */
+   uint16_t frame_sequence_no;
+
+   /** Timestamp in microseconds when that link scan started */
+   uint32_t timestamp_link_scan_start;
+
+   /** Number of occupied slave stations in the snapshot. The first
+    *  \a num_occupied_stations areas in \a rx and \a rwr are valid. */
+   uint16_t num_occupied_stations;
+
+   /** RX areas */
+   cl_rx_t rx[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
+
+   /** RWr areas */
+   cl_rwr_t rwr[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
+} clm_input_snapshot_t;
+
 /** Information from slave response frame headers, stored in master.
  *  Valid for latest received frame from this slave.
  *  Converted endianness. */
@@ -369,7 +486,9 @@ typedef struct clm_device_framevalues
    /** Frame sequence number */
    uint16_t frame_sequence_no;
 
-   /** Time since request, in microseconds */
+   /** Time since request, in microseconds. Uses reception and transmission
+       timestamps from the network stack if both are available, otherwise
+       the application ticks. */
    uint32_t response_time;
 } clm_device_framevalues_t;
 
@@ -519,6 +638,85 @@ typedef void (
 typedef void (
    *clm_set_ip_cfm_t) (clm_t * clm, void * arg, clm_master_setip_status_t status);
 
+/** Commands that can be submitted by \a clm_submit_command() */
+typedef enum clm_command_type
+{
+   /** See \a clm_set_slave_communication_status() */
+   CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS,
+
+   /** See \a clm_force_cyclic_transmission_bit() */
+   CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT,
+
+   /** See \a clm_set_master_application_status() */
+   CLM_COMMAND_SET_MASTER_APPLICATION_STATUS,
+
+   /** See \a clm_perform_node_search() */
+   CLM_COMMAND_PERFORM_NODE_SEARCH,
+
+   /** See \a clm_set_slave_ipaddr() */
+   CLM_COMMAND_SET_SLAVE_IPADDR,
+} clm_command_type_t;
+
+/** Command to the master stack, from any application thread.
+    Only the fields used by the command type need to be set. */
+typedef struct clm_command
+{
+   clm_command_type_t type;
+
+   /** User-defined value, returned in the command callback */
+   uint32_t tag;
+
+   /** Group index (starts from 0). For
+       CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS and
+       CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT. */
+   uint16_t group_index;
+
+   /** Device index in group (starts from 0). For
+       CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS and
+       CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT. */
+   uint16_t slave_device_index;
+
+   /** For CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS */
+   bool enabled;
+
+   /** For CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT */
+   bool force;
+
+   /** For CLM_COMMAND_SET_MASTER_APPLICATION_STATUS */
+   bool running;
+   bool stopped_by_user;
+
+   /** For CLM_COMMAND_SET_SLAVE_IPADDR */
+   cl_macaddr_t slave_mac_addr;
+   cl_ipaddr_t slave_new_ip_addr;
+   cl_ipaddr_t slave_new_netmask;
+} clm_command_t;
+
+/**
+ * Indication to the application that a command from
+ * \a clm_submit_command() has been executed.
+ *
+ * Called from the thread running \a clm_handle_periodic(), or by
+ * \a clm_dispatch_callbacks() for commands executed by master shards if
+ * \a use_async_callbacks is enabled. For node search
+ * and set IP address, the result only tells whether the request could be
+ * started. The outcome is reported by the node search and set IP
+ * callbacks.
+ *
+ * It is optional to implement this callback.
+ *
+ * @param clm              The stack instance
+ * @param arg              User-defined data (not used by c-link)
+ * @param command          The executed command
+ * @param result           0 on success, -1 on failure. Same as the return
+ *                         value of the corresponding API function.
+ */
+typedef void (*clm_command_cfm_t) (
+   clm_t * clm,
+   void * arg,
+   const clm_command_t * command,
+   int result);
+
 /** IP address and number of occupied stations for a slave device */
 typedef struct clm_slave_device_setting
 {
@@ -596,6 +794,10 @@ typedef struct clm_cfg
     * Use \a NULL if not implemented */
    clm_changed_slave_info_ind_t changed_slave_info_cb;
 
+   /** Callback for changed incoming cyclic data (RX and RWr).
+    * Use \a NULL if not implemented */
+   clm_inputs_changed_ind_t inputs_changed_cb;
+
    /** Callback for when node search is completed or \a NULL if
     * not implemented */
    clm_node_search_cfm_t node_search_cfm_cb;
@@ -604,6 +806,10 @@ typedef struct clm_cfg
     * not implemented */
    clm_set_ip_cfm_t set_ip_cfm_cb;
 
+   /** Callback for when a command from \a clm_submit_command() has been
+    * executed, or \a NULL if not implemented */
+   clm_command_cfm_t command_cfm_cb;
+
    /** Slave IP addresses etc for each group */
    clm_slave_hierarchy_t hier;
 
@@ -637,6 +843,15 @@ typedef struct clm_cfg
     *  on operating system based on LwIP (for example RT-Kernel). */
    bool use_separate_arbitration_socket;
 
+   /** Receive all CCIEFB frames on a single socket bound to all
+    *  interfaces, both responses from slaves and broadcasts from other
+    *  masters. Frames that are not sent to the master IP address or to a
+    *  broadcast address are dropped. The operating system must report the
+    *  destination address of incoming frames (IP_PKTINFO on Linux).
+    *  When enabled, \a use_separate_arbitration_socket is ignored.
+    *  If unsure, set it to false. */
+   bool use_wildcard_cciefb_socket;
+
    /** Send SLMP messages as directed broadcast (x.x.x.255) instead
     *  of local broadcast (255.255.255.255).
     *  If unsure, set it to false. */
@@ -647,6 +862,64 @@ typedef struct clm_cfg
     *  (for example RT-Kernel), but not on Windows or Linux. */
    bool use_single_slmp_socket;
 
+   /** Let the application write RY and RWw directly into an inactive
+    *  request frame for each group, instead of having the stack copy the
+    *  memory areas to the outgoing frame at each link scan. The new values
+    *  are sent from the next link scan after \a clm_publish_outputs().
+    *  Getting a memory area pointer marks its areas as changed. Values
+    *  written via a pointer kept from before the last publish must be
+    *  reported by \a clm_mark_outputs_dirty(), or they are not kept after
+    *  the next publish. If unsure, set it to false. */
+   bool use_double_buffered_outputs;
+
+   /** Copy RY and RWw to the outgoing frame at link scan start only for
+    *  the slave stations whose outputs have changed. Values written by
+    *  \a clm_set_ry_bit() and \a clm_set_rww_value() are tracked
+    *  automatically, and getting a memory area pointer marks its areas as
+    *  changed. Values written via a pointer kept from before the last link
+    *  scan start must be reported by \a clm_mark_outputs_dirty(), or they
+    *  are not sent.
+    *  Ignored if \a use_double_buffered_outputs is enabled.
+    *  If unsure, set it to false. */
+   bool use_output_dirty_tracking;
+
+   /** Run the SLMP communication (node search and set IP) in a separate
+    *  thread, by calling \a clm_handle_slmp_periodic(). Then
+    *  \a clm_handle_periodic() only handles the cyclic communication.
+    *  If unsure, set it to false. */
+   bool use_separate_slmp_thread;
+
+   /** Queue the connect, disconnect, link scan, alarm frame and changed
+    *  slave info callbacks, instead of calling them while handling the
+    *  incoming frames and timers. The application delivers them from its
+    *  own thread by calling \a clm_dispatch_callbacks(). Callbacks are
+    *  dropped if the queue is full, see \a callback_queue_overflows.
+    *  If unsure, set it to false. */
+   bool use_async_callbacks;
+
+   /** Do not queue a link scan callback if the latest callback waiting in
+    *  the queue is an identical link scan callback for the same group.
+    *  Only used if \a use_async_callbacks is enabled.
+    *  If unsure, set it to false. */
+   bool coalesce_linkscan_callbacks;
+
+   /** Number of shards to distribute the groups on, each run by its own
+    *  thread. Group index n belongs to shard n % \a number_of_shards.
+    *  The application calls \a clm_handle_shard_periodic() for each shard
+    *  from a separate thread, while \a clm_handle_periodic() receives
+    *  the incoming frames and handles arbitration. The application
+    *  callbacks for the groups are queued by the shards, and called from
+    *  the thread running \a clm_handle_periodic() (or by
+    *  \a clm_dispatch_callbacks() if \a use_async_callbacks is enabled).
+    *  Allowed 0..CLM_MAX_SHARDS, where 0 and 1 run all groups in the
+    *  thread calling \a clm_handle_periodic(). If unsure, use 0. */
+   uint16_t number_of_shards;
+
+   /** Socket tuning for the CCIEFB socket(s). Use all zero to keep the
+    *  operating system defaults. The settings actually applied are
+    *  reported by \a clm_get_master_status(). */
+   cl_socket_profile_t cciefb_socket_profile;
+
    /** Master IP address. Also known as MyMasterID in the specification. */
    cl_ipaddr_t master_id;
 
@@ -695,6 +968,150 @@ int clm_init_only (clm_t * clm, const clm_cfg_t * cfg);
  */
 CL_EXPORT void clm_handle_periodic (clm_t * clm);
 
+/**
+ * Get the time until the c-link master stack needs to run next.
+ *
+ * Instead of calling \a clm_handle_periodic() at a fixed interval, the
+ * application can wait until this deadline has passed or until data is
+ * available on any of the stack sockets, and then call
+ * \a clm_handle_periodic().
+ *
+ * The deadline is the earliest expiry among the arbitration timer, the
+ * link scan timers of all groups and the SLMP node search and set IP
+ * timers. Call this function again after each \a clm_handle_periodic()
+ * and after any other API call, as these might start new timers. The SLMP
+ * timers are not included if \a use_separate_slmp_thread is enabled.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param time_to_deadline Resulting time until the next deadline, in
+ *                         microseconds. It is 0 if the deadline already has
+ *                         passed.
+ * @return 0 if there is a deadline, -1 if no timer is running (wait for
+ *         incoming data only) or on failure.
+ */
+CL_EXPORT int clm_get_next_deadline_us (
+   clm_t * clm,
+   uint32_t * time_to_deadline);
+
+/**
+ * Get the sockets used by the c-link master stack for incoming data
+ *
+ * Intended for applications using an external event loop (for example
+ * epoll). When a socket is readable, call \a clm_handle_cciefb_readable()
+ * or \a clm_handle_slmp_readable() depending on the socket role. Call
+ * \a clm_handle_periodic() when the deadline given by
+ * \a clm_get_next_deadline_us() has passed.
+ *
+ * The socket handles are valid until \a clm_exit() is called. The
+ * application must not read from or close the sockets.
+ *
+ * @param clm                 c-link master stack instance handle
+ * @param sockets             Resulting list of sockets
+ * @param max_sockets         Number of elements in \a sockets. Use
+ *                            CL_MAX_SOCKETS to fit all sockets.
+ * @param number_of_sockets   Resulting number of sockets in the list
+ * @return 0 on success, -1 on failure (for example if the list is too
+ *         small)
+ */
+CL_EXPORT int clm_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Execute the groups of one shard
+ *
+ * Only used if \a number_of_shards in the configuration is larger than 1.
+ * Handles the group state machines, the link scan timers, the incoming
+ * response frames, the outgoing request frames and the queued commands for
+ * the groups in the shard. Call it periodically from one thread per shard,
+ * for example at the same interval as \a clm_handle_periodic(). Callbacks
+ * for the groups in the shard are queued, and called from the thread
+ * running \a clm_handle_periodic().
+ *
+ * The shards and \a clm_handle_periodic() must not be called before
+ * \a clm_init() has returned, and not after \a clm_exit() is called.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard_index      Shard index, 0..number_of_shards-1
+ * @return 0 on success, -1 on failure (invalid shard index, or sharding
+ *         not enabled)
+ */
+CL_EXPORT int clm_handle_shard_periodic (clm_t * clm, uint16_t shard_index);
+
+/**
+ * Get the time until a shard needs to run next.
+ *
+ * Similar to \a clm_get_next_deadline_us(), but for the link scan timers
+ * of the groups in the shard. Incoming frames for the shard are not
+ * reported, so the shard must also be run periodically. Call it from the
+ * thread of the shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard_index      Shard index, 0..number_of_shards-1
+ * @param time_to_deadline Resulting time until the next deadline, in
+ *                         microseconds. It is 0 if the deadline already has
+ *                         passed.
+ * @return 0 if there is a deadline, -1 if no timer is running or on
+ *         failure.
+ */
+CL_EXPORT int clm_get_shard_next_deadline_us (
+   clm_t * clm,
+   uint16_t shard_index,
+   uint32_t * time_to_deadline);
+
+/**
+ * Handle incoming data on the CCIEFB sockets
+ *
+ * Receives and handles all available frames on the sockets with role
+ * CL_SOCKET_ROLE_CCIEFB and CL_SOCKET_ROLE_CCIEFB_ARBITRATION.
+ * No timers are handled, see \a clm_get_sockets().
+ *
+ * @param clm              c-link master stack instance handle
+ */
+CL_EXPORT void clm_handle_cciefb_readable (clm_t * clm);
+
+/**
+ * Handle incoming data on the SLMP socket
+ *
+ * Receives and handles all available frames on the socket with role
+ * CL_SOCKET_ROLE_SLMP. No timers are handled, see \a clm_get_sockets().
+ *
+ * @param clm              c-link master stack instance handle
+ */
+CL_EXPORT void clm_handle_slmp_readable (clm_t * clm);
+
+/**
+ * Execute the SLMP communication within the c-link master stack
+ *
+ * Only used if \a use_separate_slmp_thread in the configuration is
+ * enabled. Handles the requests from \a clm_perform_node_search() and
+ * \a clm_set_slave_ipaddr(), the SLMP timers and the incoming SLMP
+ * frames. Call it periodically from a thread with lower priority than the
+ * thread calling \a clm_handle_periodic(), for example every 10 ms. The
+ * node search and set IP callbacks are called from this thread.
+ *
+ * @param clm              c-link master stack instance handle
+ * @return 0 on success, -1 on failure (the SLMP thread is not enabled)
+ */
+CL_EXPORT int clm_handle_slmp_periodic (clm_t * clm);
+
+/**
+ * Deliver the queued application callbacks
+ *
+ * Only used if \a use_async_callbacks in the configuration is enabled.
+ * Calls the queued connect, disconnect, link scan, alarm frame and changed
+ * slave info callbacks, in the order they were triggered for each group.
+ * Call it periodically from the application thread that should run the
+ * callbacks, for example after each call to \a clm_handle_periodic().
+ *
+ * @param clm              c-link master stack instance handle
+ * @return Number of callbacks delivered, or -1 on failure (asynchronous
+ *         callbacks are not enabled)
+ */
+CL_EXPORT int clm_dispatch_callbacks (clm_t * clm);
+
 /**
  * Set the master application status "Own station unit information"
  *
@@ -741,13 +1158,19 @@ CL_EXPORT uint16_t clm_get_master_application_status (clm_t * clm);
  *
  * Use \a clm_get_device_connection_details() to read current value.
  *
+ * With master shards (\a number_of_shards larger than 1) the change is
+ * queued to the shard running the group, and is applied by its next
+ * \a clm_handle_shard_periodic(). This function can then be called from
+ * any thread.
+ *
  * @param clm                    c-link master stack instance handle
  * @param group_index            Group index (starts from 0).
  *                               Note that group number 1 has group_index 0.
  * @param slave_device_index     Device index in group (starts from 0).
  * @param enabled                True if the cyclic data communication is
  *                               enabled, false otherwise
- * @return 0 on success, or -1 on illegal argument values.
+ * @return 0 on success, or -1 on illegal argument values or if the shard
+ *         command queue is full.
  */
 CL_EXPORT int clm_set_slave_communication_status (
    clm_t * clm,
@@ -766,13 +1189,19 @@ CL_EXPORT int clm_set_slave_communication_status (
  *
  * Use \a clm_get_device_connection_details() to read current value.
  *
+ * With master shards (\a number_of_shards larger than 1) the change is
+ * queued to the shard running the group, and is applied by its next
+ * \a clm_handle_shard_periodic(). This function can then be called from
+ * any thread.
+ *
  * @param clm                    c-link master stack instance handle
  * @param group_index            Group index (starts from 0).
  *                               Note that group number 1 has group_index 0.
  * @param slave_device_index     Device index in group (starts from 0).
  * @param force                  True if the corresponding bit should be forced,
  *                               or false to stop forcing the bit value.
- * @return 0 on success, or -1 on illegal argument values.
+ * @return 0 on success, or -1 on illegal argument values or if the shard
+ *         command queue is full.
  */
 CL_EXPORT int clm_force_cyclic_transmission_bit (
    clm_t * clm,
@@ -783,7 +1212,8 @@ CL_EXPORT int clm_force_cyclic_transmission_bit (
 /**
  * Clear statistics for communication with slave devices
  *
- * This clears all statistics.
+ * This clears all statistics, including the number of frames dropped
+ * on the CCIEFB sockets.
  *
  * @param clm                    c-link master stack instance handle
  */
@@ -827,21 +1257,49 @@ CL_EXPORT int clm_get_group_status (
  *
  * This function is intended for debugging and for automated tests.
  *
+ * The statistics and the latest frame values in the result are updated by
+ * the stack as frames arrive. The other fields are updated at each call to
+ * this function.
+ *
  * @param clm                    c-link master stack instance handle
  * @param group_index            Group index (starts from 0).
  *                               Note that group number 1 has group_index 0.
  * @param slave_device_index     Device index in group (starts from 0).
  * @return Pointer to slave device connection details, or NULL on error.
- *         No copying is done.
  *
  * @req REQ_CLM_DIAGNOSIS_01
  *
  */
 CL_EXPORT const clm_slave_device_data_t * clm_get_device_connection_details (
-   const clm_t * clm,
+   clm_t * clm,
    uint16_t group_index,
    uint16_t slave_device_index);
 
+/**
+ * Read out connection details for a slave device.
+ *
+ * This function is intended for debugging and for automated tests.
+ *
+ * Copies the same information as \a clm_get_device_connection_details() to
+ * the resulting struct. Does not modify the stack instance, so it can be
+ * used with a const handle.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param details                Resulting details
+ * @return 0 on success, or -1 on error.
+ *
+ * @req REQ_CLM_DIAGNOSIS_01
+ *
+ */
+CL_EXPORT int clm_get_device_connection_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_slave_device_data_t * details);
+
 /**
  * Exit c-link master stack.
  *
@@ -864,9 +1322,14 @@ CL_EXPORT int clm_exit (clm_t * clm);
  *
  * No new node search will be triggered if there already is one in progress.
  *
+ * If \a use_separate_slmp_thread is enabled, the request is queued and
+ * sent by \a clm_handle_slmp_periodic(). A failure to send it is then
+ * only logged.
+ *
  * @param clm              c-link master stack instance handle
- * @return 0 on success, or -1 on failure to send the request. Note that the
- * result of the node search itself is reported in the callback.
+ * @return 0 on success, or -1 on failure to send (or queue) the request.
+ * Note that the result of the node search itself is reported in the
+ * callback.
  */
 CL_EXPORT int clm_perform_node_search (clm_t * clm);
 
@@ -883,6 +1346,10 @@ CL_EXPORT const clm_node_search_db_t * clm_get_node_search_result (clm_t * clm);
  *
  * Triggers the callback set_ip_cfm_cb to inform about the result.
  *
+ * If \a use_separate_slmp_thread is enabled, the request is queued and
+ * sent by \a clm_handle_slmp_periodic(). A failure to send it is then
+ * reported in the callback.
+ *
  * @param clm                c-link master stack instance handle
  * @param slave_mac_addr     Slave MAC address
  * @param slave_new_ip_addr  New IP address for the slave device
@@ -897,6 +1364,30 @@ CL_EXPORT int clm_set_slave_ipaddr (
    cl_ipaddr_t slave_new_ip_addr,
    cl_ipaddr_t slave_new_netmask);
 
+/**
+ * Submit a command to the master stack, from any thread
+ *
+ * The functions changing the master stack state, for example
+ * \a clm_set_slave_communication_status(), may only be called from the
+ * thread running \a clm_handle_periodic(). Other application threads can
+ * instead submit commands to a queue, without locks. The commands are
+ * executed in order at the start of the next \a clm_handle_periodic(),
+ * and the result is reported by the \a command_cfm_cb callback.
+ *
+ * With master shards (\a number_of_shards larger than 1) the group data is
+ * owned by the thread running the shard. The commands
+ * CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS and
+ * CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT are then handed over to the
+ * shard running the group, and executed by its next
+ * \a clm_handle_shard_periodic(). Their results are reported like the
+ * other callbacks from the shards.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param command          Command to be executed. Copied by the stack.
+ * @return 0 if the command was queued, -1 on failure (the queue is full)
+ */
+CL_EXPORT int clm_submit_command (clm_t * clm, const clm_command_t * command);
+
 /********************* Memory areas *****************************************/
 
 /**
@@ -932,6 +1423,15 @@ CL_EXPORT const cl_rx_t * clm_get_first_rx_area (
  * The data is copied directly to outgoing frame (which is little endian).
  * You need to handle endianness conversion.
  *
+ * If \a use_double_buffered_outputs is enabled, this points into the
+ * inactive request frame. The pointer is only valid until the next call to
+ * \a clm_publish_outputs().
+ *
+ * If \a use_output_dirty_tracking or \a use_double_buffered_outputs is
+ * enabled, all memory areas in the group are marked as changed, see
+ * \a clm_mark_outputs_dirty(). Fetch the pointer again before writing
+ * new values, to have them sent.
+ *
  * Note that the RY, RX, RWw and RWr memory areas are not guaranteed to be
  * adjacent.
  *
@@ -982,6 +1482,15 @@ CL_EXPORT const cl_rwr_t * clm_get_first_rwr_area (
  * The data is copied directly to outgoing frame (which is little endian).
  * You need to handle endianness conversion.
  *
+ * If \a use_double_buffered_outputs is enabled, this points into the
+ * inactive request frame. The pointer is only valid until the next call to
+ * \a clm_publish_outputs().
+ *
+ * If \a use_output_dirty_tracking or \a use_double_buffered_outputs is
+ * enabled, all memory areas in the group are marked as changed, see
+ * \a clm_mark_outputs_dirty(). Fetch the pointer again before writing
+ * new values, to have them sent.
+ *
  * Note that the RY, RX, RWw and RWr memory areas are not guaranteed to be
  * adjacent.
  *
@@ -1034,6 +1543,15 @@ CL_EXPORT const cl_rx_t * clm_get_first_device_rx_area (
  * The data is copied directly to outgoing frame (which is little endian).
  * You need to handle endianness conversion.
  *
+ * If \a use_double_buffered_outputs is enabled, this points into the
+ * inactive request frame. The pointer is only valid until the next call to
+ * \a clm_publish_outputs().
+ *
+ * If \a use_output_dirty_tracking or \a use_double_buffered_outputs is
+ * enabled, all memory areas for the device are marked as changed, see
+ * \a clm_mark_outputs_dirty(). Fetch the pointer again before writing
+ * new values, to have them sent.
+ *
  * Note that the RY, RX, RWw and RWr memory areas are not guaranteed to be
  * adjacent.
  *
@@ -1090,6 +1608,15 @@ CL_EXPORT const cl_rwr_t * clm_get_first_device_rwr_area (
  * The data is copied directly to outgoing frame (which is little endian).
  * You need to handle endianness conversion.
  *
+ * If \a use_double_buffered_outputs is enabled, this points into the
+ * inactive request frame. The pointer is only valid until the next call to
+ * \a clm_publish_outputs().
+ *
+ * If \a use_output_dirty_tracking or \a use_double_buffered_outputs is
+ * enabled, all memory areas for the device are marked as changed, see
+ * \a clm_mark_outputs_dirty(). Fetch the pointer again before writing
+ * new values, to have them sent.
+ *
  * Note that the RY, RX, RWw and RWr memory areas are not guaranteed to be
  * adjacent.
  *
@@ -1107,6 +1634,143 @@ CL_EXPORT cl_rww_t * clm_get_first_device_rww_area (
    uint16_t slave_device_index,
    uint16_t * num_occupied_stations);
 
+/**
+ * Publish the RY and RWw values for a group, when double buffered outputs
+ * are used.
+ *
+ * The inactive request frame (where the application has written its
+ * outputs) becomes the active frame, and is sent from the next link scan.
+ * All values are published at once. The values changed since the previous
+ * publish are then copied to the new inactive frame, so the application
+ * can continue to update individual values. Changes made via
+ * \a clm_set_ry_bit() and \a clm_set_rww_value() are tracked
+ * automatically, while changes written via the pointers must be reported
+ * by \a clm_mark_outputs_dirty().
+ *
+ * The pointers given by \a clm_get_first_ry_area(),
+ * \a clm_get_first_rww_area(), \a clm_get_first_device_ry_area() and
+ * \a clm_get_first_device_rww_area() change when publishing. Fetch them
+ * again after this call.
+ *
+ * The frames are swapped without locking. Call this from the thread
+ * running \a clm_handle_periodic(), or \a clm_handle_shard_periodic() for
+ * the shard running the group.
+ *
+ * While a slave device is disconnected zeros are sent to it, and its
+ * outputs are sent again after the next publish.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param group_index      Group index (starts from 0).
+ *                         Note that group number 1 has group_index 0.
+ * @return 0 on success, or -1 on error (for example if
+ *         \a use_double_buffered_outputs is not enabled).
+ */
+CL_EXPORT int clm_publish_outputs (clm_t * clm, uint16_t group_index);
+
+/**
+ * Mark RY and RWw values as changed, for a range of slave stations in a
+ * group, when output dirty tracking or double buffered outputs are used.
+ *
+ * Use this after writing via a pointer given by
+ * \a clm_get_first_ry_area(), \a clm_get_first_rww_area(),
+ * \a clm_get_first_device_ry_area() or \a clm_get_first_device_rww_area(),
+ * if the pointer was fetched before the last link scan start or publish.
+ * Getting the pointer marks its memory areas as changed.
+ * The marked stations are copied to the outgoing frame at the next link
+ * scan start, or to the new inactive frame at the next
+ * \a clm_publish_outputs(). Not needed for \a clm_set_ry_bit() and
+ * \a clm_set_rww_value().
+ *
+ * Does nothing (but returns 0) if neither \a use_output_dirty_tracking
+ * nor \a use_double_buffered_outputs is enabled.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param group_index      Group index (starts from 0).
+ *                         Note that group number 1 has group_index 0.
+ * @param first_area       Index of the first changed memory area in the
+ *                         group (starts from 0).
+ * @param num_areas        Number of changed memory areas
+ * @return 0 on success, or -1 on error
+ */
+CL_EXPORT int clm_mark_outputs_dirty (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t first_area,
+   uint16_t num_areas);
+
+/**
+ * Copy a consistent snapshot of the incoming RX and RWr data for a group.
+ *
+ * Can be called from another thread than the one running the stack,
+ * without locking. The stack updates a sequence counter around each write
+ * of incoming data, and the copy is repeated if it overlapped a write.
+ * The areas from \a clm_get_first_rx_area() and
+ * \a clm_get_first_rwr_area() might be partially updated if read from
+ * another thread.
+ *
+ * Note that the slave devices respond at different times during a link
+ * scan, so the snapshot might contain data from two consecutive link scans.
+ * The data for each slave device is consistent.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param group_index      Group index (starts from 0).
+ *                         Note that group number 1 has group_index 0.
+ * @param snapshot         Resulting snapshot, with all slave stations in
+ *                         the group.
+ * @return 0 on success, or -1 on error (also if no consistent snapshot
+ *         could be read)
+ */
+CL_EXPORT int clm_get_group_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   clm_input_snapshot_t * snapshot);
+
+/**
+ * Copy a consistent snapshot of the incoming RX and RWr data for a slave
+ * device.
+ *
+ * See \a clm_get_group_input_snapshot(). The first area in the snapshot
+ * is the first occupied slave station of the device.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param snapshot               Resulting snapshot
+ * @return 0 on success, or -1 on error (also if no consistent snapshot
+ *         could be read)
+ */
+CL_EXPORT int clm_get_device_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_input_snapshot_t * snapshot);
+
+/**
+ * Get the incoming cyclic data (RX and RWr) that has changed for a slave
+ * device, since the previous call to this function.
+ *
+ * The changes are accumulated by the stack for each stored response frame,
+ * and cleared by this function. Use it to find the signals to read, instead
+ * of comparing the whole memory area.
+ *
+ * Call this function from the same thread as the stack.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param changed                Resulting changed RX bits and RWr registers.
+ *                               Area 0 is the first occupied station of the
+ *                               device.
+ * @return 0 on success, or -1 on error
+ */
+CL_EXPORT int clm_get_changed_inputs (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   cl_changed_signals_t * changed);
+
 /******************** Data convenience functions *****************************/
 
 /**
@@ -1231,6 +1895,114 @@ CL_EXPORT uint16_t clm_get_rww_value (
    uint16_t slave_device_index,
    uint16_t number);
 
+/**
+ * Read a range of bits (RX) from a slave, with one value per bit.
+ *
+ * This is faster than calling \a clm_get_rx_bit() for each bit, as the
+ * arguments are validated once and whole bytes are unpacked at a time.
+ *
+ * Note that the slave has \a 64*num_occupied_stations of these bits.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First bit number. Use 0 for RX0.
+ * @param num_bits               Number of bits to read
+ * @param values                 Resulting bit values, with room for
+ *                               \a num_bits values.
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas of the slave)
+ */
+CL_EXPORT int clm_get_rx_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values);
+
+/**
+ * Set a range of bits (RY) for sending to a slave, from one value per bit.
+ *
+ * This is faster than calling \a clm_set_ry_bit() for each bit, as the
+ * arguments are validated once and whole bytes are packed at a time.
+ *
+ * Note that the slave has \a 64*num_occupied_stations of these bits.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First bit number. Use 0 for RY0.
+ * @param num_bits               Number of bits to set
+ * @param values                 Bit values to send to the slave
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas of the slave)
+ */
+CL_EXPORT int clm_set_ry_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values);
+
+/**
+ * Read a range of 16-bit register values (RWr) from a slave.
+ *
+ * The endianness is handled automatically. This is faster than calling
+ * \a clm_get_rwr_value() for each register, as the arguments are
+ * validated once.
+ *
+ * Note that the slave has \a 32*num_occupied_stations of these registers.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First register number. Use 0 for RWr0.
+ * @param num_values             Number of registers to read
+ * @param values                 Resulting register values, with room for
+ *                               \a num_values values.
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas of the slave)
+ */
+CL_EXPORT int clm_get_rwr_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values);
+
+/**
+ * Set a range of 16-bit register values (RWw) for sending to a slave.
+ *
+ * The endianness is handled automatically. This is faster than calling
+ * \a clm_set_rww_value() for each register, as the arguments are
+ * validated once.
+ *
+ * Note that the slave has \a 32*num_occupied_stations of these registers.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First register number. Use 0 for RWw0.
+ * @param num_values             Number of registers to set
+ * @param values                 Register values to send to the slave
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas of the slave)
+ */
+CL_EXPORT int clm_set_rww_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values);
+
 #ifdef __cplusplus
 }
 #endif
@@ -88,6 +88,27 @@ typedef struct cls_master_connection
    uint16_t total_occupied_station_count;
 } cls_master_connection_t;
 
+/** Statistics for incoming CCIEFB frames to the slave */
+typedef struct cls_cciefb_receive_statistics
+{
+   /** Number of frames handled in the latest tick */
+   uint16_t processed_latest;
+
+   /** Max number of frames handled in a single tick */
+   uint16_t processed_max;
+
+   /** Total number of handled frames */
+   uint32_t processed_total;
+
+   /** Number of ticks where CLS_CCIEFB_MAX_FRAMES_PER_TICK frames were
+       handled. Remaining frames (if any) were deferred to the next tick. */
+   uint32_t deferred_ticks;
+
+   /** Number of ICMP errors read from the socket error queue. Only used if
+       \a enable_error_queue is set in the socket profile. */
+   uint32_t icmp_errors;
+} cls_cciefb_receive_statistics_t;
+
 /** Error messages reported in the callback \a cls_error_ind_t()
  *  Literals are implemented in the internal function
  *  cl_literals_get_slave_error_message() */
@@ -252,6 +273,77 @@ typedef void (*cls_set_ip_ind_t) (
    bool ip_setting_allowed,
    bool did_set_ip);
 
+/**
+ * Indication to the application that incoming cyclic data (RY or RWw) from
+ * the master has changed.
+ *
+ * Called when a request frame is handled, with the signals that changed
+ * compared to the previously stored data. The data is set to zero when
+ * the master stops sending cyclic data to us, which also might change
+ * signals.
+ *
+ * It is optional to implement this callback.
+ *
+ * @param cls                 The slave stack instance
+ * @param arg                 User-defined data (not used by c-link)
+ * @param changed             Changed RY bits and RWw registers
+ */
+typedef void (*cls_inputs_changed_ind_t) (
+   cls_t * cls,
+   void * arg,
+   const cl_changed_signals_t * changed);
+
+/** Commands that can be submitted by \a cls_submit_command() */
+typedef enum cls_command_type
+{
+   /** See \a cls_set_slave_application_status() */
+   CLS_COMMAND_SET_SLAVE_APPLICATION_STATUS,
+
+   /** See \a cls_set_local_management_info() */
+   CLS_COMMAND_SET_LOCAL_MANAGEMENT_INFO,
+
+   /** See \a cls_set_slave_error_code() */
+   CLS_COMMAND_SET_SLAVE_ERROR_CODE,
+} cls_command_type_t;
+
+/** Command to the slave stack, from any application thread.
+    Only the field used by the command type needs to be set. */
+typedef struct cls_command
+{
+   cls_command_type_t type;
+
+   /** User-defined value, returned in the command callback */
+   uint32_t tag;
+
+   /** For CLS_COMMAND_SET_SLAVE_APPLICATION_STATUS */
+   cl_slave_appl_operation_status_t slave_application_status;
+
+   /** For CLS_COMMAND_SET_LOCAL_MANAGEMENT_INFO */
+   uint32_t local_management_info;
+
+   /** For CLS_COMMAND_SET_SLAVE_ERROR_CODE */
+   uint16_t slave_err_code;
+} cls_command_t;
+
+/**
+ * Indication to the application that a command from
+ * \a cls_submit_command() has been executed.
+ *
+ * Called from the thread running \a cls_handle_periodic().
+ *
+ * It is optional to implement this callback.
+ *
+ * @param cls                 The slave stack instance
+ * @param arg                 User-defined data (not used by c-link)
+ * @param command             The executed command
+ * @param result              0 on success, -1 on failure
+ */
+typedef void (*cls_command_cfm_t) (
+   cls_t * cls,
+   void * arg,
+   const cls_command_t * command,
+   int result);
+
 /** Configuration for the c-link slave stack */
 typedef struct cls_cfg
 {
@@ -301,6 +393,14 @@ typedef struct cls_cfg
     * use it.  */
    cls_set_ip_ind_t set_ip_cb;
 
+   /** Callback for changed incoming cyclic data (RY and RWw), or \a NULL if
+    * not implemented */
+   cls_inputs_changed_ind_t inputs_changed_cb;
+
+   /** Callback for when a command from \a cls_submit_command() has been
+    * executed, or \a NULL if not implemented */
+   cls_command_cfm_t command_cfm_cb;
+
    /** Which IP address the IEFB socket should bind to.
     *  Use CL_IPADDR_ANY to listen on all interfaces, or
     *  the IP address of the interface.
@@ -314,6 +414,16 @@ typedef struct cls_cfg
     *  If unsure, set it to false. */
    bool use_slmp_directed_broadcast;
 
+   /** Run the SLMP communication (node search and set IP) in a separate
+    *  thread, by calling \a cls_handle_slmp_periodic(). Then
+    *  \a cls_handle_periodic() only handles the cyclic communication.
+    *  If unsure, set it to false. */
+   bool use_separate_slmp_thread;
+
+   /** Socket tuning for the CCIEFB socket. Use all zero to keep the
+    *  operating system defaults. */
+   cl_socket_profile_t cciefb_socket_profile;
+
 } cls_cfg_t;
 
 /********************** General functions ***********************************/
@@ -344,6 +454,92 @@ CL_EXPORT int cls_init_only (cls_t * cls, const cls_cfg_t * cfg);
  */
 CL_EXPORT void cls_handle_periodic (cls_t * cls);
 
+/**
+ * Get the time until the c-link slave stack needs to run next.
+ *
+ * Instead of calling \a cls_handle_periodic() at a fixed interval, the
+ * application can wait until this deadline has passed or until data is
+ * available on any of the stack sockets, and then call
+ * \a cls_handle_periodic().
+ *
+ * The deadline is the earliest expiry among the timer monitoring the
+ * incoming cyclic data, the timer for disabling the slave and the SLMP
+ * node search response timer. Call this function again after each
+ * \a cls_handle_periodic() and after any other API call, as these might
+ * start new timers. The SLMP timer is not included if
+ * \a use_separate_slmp_thread is enabled.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param time_to_deadline Resulting time until the next deadline, in
+ *                         microseconds. It is 0 if the deadline already has
+ *                         passed.
+ * @return 0 if there is a deadline, -1 if no timer is running (wait for
+ *         incoming data only) or on failure.
+ */
+CL_EXPORT int cls_get_next_deadline_us (
+   cls_t * cls,
+   uint32_t * time_to_deadline);
+
+/**
+ * Get the sockets used by the c-link slave stack for incoming data
+ *
+ * Intended for applications using an external event loop (for example
+ * epoll). When a socket is readable, call \a cls_handle_cciefb_readable()
+ * or \a cls_handle_slmp_readable() depending on the socket role. Call
+ * \a cls_handle_periodic() when the deadline given by
+ * \a cls_get_next_deadline_us() has passed.
+ *
+ * The socket handles are valid until \a cls_exit() is called. The
+ * application must not read from or close the sockets.
+ *
+ * @param cls                 c-link slave stack instance handle
+ * @param sockets             Resulting list of sockets
+ * @param max_sockets         Number of elements in \a sockets. Use
+ *                            CL_MAX_SOCKETS to fit all sockets.
+ * @param number_of_sockets   Resulting number of sockets in the list
+ * @return 0 on success, -1 on failure (for example if the list is too
+ *         small)
+ */
+CL_EXPORT int cls_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Handle incoming data on the CCIEFB socket
+ *
+ * Receives and handles incoming frames on the socket with role
+ * CL_SOCKET_ROLE_CCIEFB. No timers are handled, see \a cls_get_sockets().
+ *
+ * @param cls              c-link slave stack instance handle
+ */
+CL_EXPORT void cls_handle_cciefb_readable (cls_t * cls);
+
+/**
+ * Handle incoming data on the SLMP socket
+ *
+ * Receives and handles incoming frames on the socket with role
+ * CL_SOCKET_ROLE_SLMP. No timers are handled, see \a cls_get_sockets().
+ *
+ * @param cls              c-link slave stack instance handle
+ */
+CL_EXPORT void cls_handle_slmp_readable (cls_t * cls);
+
+/**
+ * Execute the SLMP communication within the c-link stack
+ *
+ * Only used if \a use_separate_slmp_thread in the configuration is
+ * enabled. Handles the SLMP timer and the incoming SLMP frames. Call it
+ * periodically from a thread with lower priority than the thread calling
+ * \a cls_handle_periodic(), for example every 10 ms. The node search and
+ * set IP callbacks are called from this thread.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @return 0 on success, -1 on failure (the SLMP thread is not enabled)
+ */
+CL_EXPORT int cls_handle_slmp_periodic (cls_t * cls);
+
 /**
  * Exit c-link stack.
  *
@@ -475,6 +671,22 @@ CL_EXPORT void cls_set_slave_error_code (cls_t * cls, uint16_t slave_err_code);
  */
 CL_EXPORT uint16_t cls_get_slave_error_code (cls_t * cls);
 
+/**
+ * Submit a command to the slave stack, from any thread
+ *
+ * The functions changing the slave stack state, for example
+ * \a cls_set_slave_error_code(), may only be called from the thread
+ * running \a cls_handle_periodic(). Other application threads can instead
+ * submit commands to a queue, without locks. The commands are executed in
+ * order at the start of the next \a cls_handle_periodic(), and the result
+ * is reported by the \a command_cfm_cb callback.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param command          Command to be executed. Copied by the stack.
+ * @return 0 if the command was queued, -1 on failure (the queue is full)
+ */
+CL_EXPORT int cls_submit_command (cls_t * cls, const cls_command_t * command);
+
 /**
  * Get a pointer to the master connection details (stored in slave).
  *
@@ -486,6 +698,25 @@ CL_EXPORT uint16_t cls_get_slave_error_code (cls_t * cls);
 CL_EXPORT const cls_master_connection_t * cls_get_master_connection_details (
    cls_t * cls);
 
+/**
+ * Get a pointer to the statistics for incoming CCIEFB frames.
+ *
+ * At most CLS_CCIEFB_MAX_FRAMES_PER_TICK frames are handled in each call to
+ * \a cls_handle_periodic() or \a cls_handle_cciefb_readable().
+ *
+ * @param cls        c-link slave stack instance handle
+ * @return           Pointer to the statistics, or NULL on error
+ */
+CL_EXPORT const cls_cciefb_receive_statistics_t *
+cls_get_cciefb_receive_statistics (cls_t * cls);
+
+/**
+ * Clear the statistics for incoming CCIEFB frames.
+ *
+ * @param cls        c-link slave stack instance handle
+ */
+CL_EXPORT void cls_clear_cciefb_receive_statistics (cls_t * cls);
+
 /********************* Memory areas *****************************************/
 
 /**
@@ -556,6 +787,22 @@ CL_EXPORT cl_rwr_t * cls_get_first_rwr_area (cls_t * cls);
  */
 CL_EXPORT const cl_rww_t * cls_get_first_rww_area (cls_t * cls);
 
+/**
+ * Get the incoming cyclic data (RY and RWw) that has changed since the
+ * previous call to this function.
+ *
+ * The changes are accumulated by the stack for each handled request frame,
+ * and cleared by this function. Use it to find the signals to read, instead
+ * of comparing the whole memory area.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param changed          Resulting changed RY bits and RWw registers
+ * @return 0 on success, or -1 on error
+ */
+CL_EXPORT int cls_get_changed_inputs (
+   cls_t * cls,
+   cl_changed_signals_t * changed);
+
 /******************** Data convenience functions *****************************/
 
 /**
@@ -636,6 +883,94 @@ CL_EXPORT uint16_t cls_get_rwr_value (cls_t * cls, uint16_t number);
  */
 CL_EXPORT uint16_t cls_get_rww_value (cls_t * cls, uint16_t number);
 
+/**
+ * Set a range of bits (RX) for sending to the PLC, from one value per bit.
+ *
+ * This is faster than calling \a cls_set_rx_bit() for each bit, as the
+ * arguments are validated once and whole bytes are packed at a time.
+ *
+ * Note that the slave has \a 64*num_occupied_stations of these bits.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First bit number. Use 0 for RX0.
+ * @param num_bits         Number of bits to set
+ * @param values           Bit values to send to the PLC
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas)
+ */
+CL_EXPORT int cls_set_rx_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values);
+
+/**
+ * Read a range of bits (RY) from the PLC, with one value per bit.
+ *
+ * This is faster than calling \a cls_get_ry_bit() for each bit, as the
+ * arguments are validated once and whole bytes are unpacked at a time.
+ *
+ * Note that the slave has \a 64*num_occupied_stations of these bits.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First bit number. Use 0 for RY0.
+ * @param num_bits         Number of bits to read
+ * @param values           Resulting bit values, with room for \a num_bits
+ *                         values.
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas)
+ */
+CL_EXPORT int cls_get_ry_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values);
+
+/**
+ * Set a range of 16-bit register values (RWr) for sending to the PLC.
+ *
+ * The endianness is handled automatically. This is faster than calling
+ * \a cls_set_rwr_value() for each register, as the arguments are
+ * validated once.
+ *
+ * Note that the slave has \a 32*num_occupied_stations of these registers.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First register number. Use 0 for RWr0.
+ * @param num_values       Number of registers to set
+ * @param values           Register values to send to the PLC
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas)
+ */
+CL_EXPORT int cls_set_rwr_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values);
+
+/**
+ * Read a range of 16-bit register values (RWw) from the PLC.
+ *
+ * The endianness is handled automatically. This is faster than calling
+ * \a cls_get_rww_value() for each register, as the arguments are
+ * validated once.
+ *
+ * Note that the slave has \a 32*num_occupied_stations of these registers.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First register number. Use 0 for RWw0.
+ * @param num_values       Number of registers to read
+ * @param values           Resulting register values, with room for
+ *                         \a num_values values.
+ * @return 0 on success, or -1 on error (for example if the range is
+ *         outside the memory areas)
+ */
+CL_EXPORT int cls_get_rww_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values);
+
 #ifdef __cplusplus
 }
 #endif
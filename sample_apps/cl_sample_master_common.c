@@ -238,6 +238,13 @@ void masterapp_error_ind (
       printf ("You must restart the application after adjusting your "
               "configuration.\n");
       break;
+   case CLM_ERROR_CCIEFB_FRAMES_DROPPED:
+      printf (
+         "The operating system dropped %" PRIu16 " incoming CCIEFB frames.\n",
+         argument_2);
+      printf ("Consider a larger socket receive buffer, see the "
+              "cciefb_socket_profile configuration.\n");
+      break;
    default:
       printf ("Unknown error\n");
       break;
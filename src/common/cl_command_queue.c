@@ -0,0 +1,120 @@
+/*********************************************************************
+ *        _       _         _
+ *  _ __ | |_  _ | |  __ _ | |__   ___
+ * | '__|| __|(_)| | / _` || '_ \ / __|
+ * | |   | |_  _ | || (_| || |_) |\__ \
+ * |_|    \__|(_)|_| \__,_||_.__/ |___/
+ *
+ * www.rt-labs.com
+ * Copyright 2022 rt-labs AB, Sweden. All rights reserved.
+ *
+ * See the file LICENSE.md distributed with this software for full
+ * license information.
+ ********************************************************************/
+
+/**
+ * @file
+ * @brief Queue for commands from several application threads to the
+ *        stack thread, without locks
+ *
+ * A slot with sequence number equal to the position is free for that
+ * position, and a slot with sequence number equal to the position plus one
+ * holds a published command. When released, the sequence number is set
+ * to the position of the next lap.
+ *
+ * No mocking should be necessary for testing these functions.
+ */
+
+#include "cl_command_queue.h"
+
+#include "common/clal.h"
+
+#include "osal.h"
+
+CC_STATIC_ASSERT (
+   (CL_COMMAND_QUEUE_SIZE & (CL_COMMAND_QUEUE_SIZE - 1)) == 0);
+
+void cl_command_queue_init (cl_command_queue_t * queue)
+{
+   uint32_t i;
+
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      queue->sequences[i] = i;
+   }
+   queue->write_position = 0;
+   queue->read_position  = 0;
+   clal_memory_barrier();
+}
+
+uint16_t cl_command_queue_slot (uint32_t position)
+{
+   return (uint16_t)(position & (CL_COMMAND_QUEUE_SIZE - 1));
+}
+
+int cl_command_queue_reserve (cl_command_queue_t * queue, uint32_t * position)
+{
+   uint32_t candidate;
+   int32_t difference;
+
+   while (true)
+   {
+      candidate = queue->write_position;
+      clal_memory_barrier();
+      difference =
+         (int32_t)(queue->sequences[cl_command_queue_slot (candidate)] -
+                   candidate);
+
+      if (difference < 0)
+      {
+         /* The slot still holds a command from the previous lap */
+         return -1;
+      }
+
+      if (
+         difference == 0 &&
+         clal_compare_and_swap (
+            &queue->write_position,
+            candidate,
+            candidate + 1))
+      {
+         *position = candidate;
+         return 0;
+      }
+
+      /* Another producer reserved the position first. Try the next one. */
+   }
+}
+
+void cl_command_queue_publish (cl_command_queue_t * queue, uint32_t position)
+{
+   /* Write the sequence number after the command */
+   clal_memory_barrier();
+   queue->sequences[cl_command_queue_slot (position)] = position + 1;
+}
+
+bool cl_command_queue_peek (cl_command_queue_t * queue, uint32_t * position)
+{
+   uint32_t candidate = queue->read_position;
+
+   if (queue->sequences[cl_command_queue_slot (candidate)] != candidate + 1)
+   {
+      return false;
+   }
+
+   /* Read the command after the sequence number */
+   clal_memory_barrier();
+   *position = candidate;
+   return true;
+}
+
+void cl_command_queue_release (cl_command_queue_t * queue)
+{
+   uint32_t position = queue->read_position;
+
+   /* Free the slot after the command has been handled */
+   clal_memory_barrier();
+   queue->sequences[cl_command_queue_slot (position)] =
+      position + CL_COMMAND_QUEUE_SIZE;
+   queue->read_position = position + 1;
+}
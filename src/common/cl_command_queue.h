@@ -0,0 +1,108 @@
+/*********************************************************************
+ *        _       _         _
+ *  _ __ | |_  _ | |  __ _ | |__   ___
+ * | '__|| __|(_)| | / _` || '_ \ / __|
+ * | |   | |_  _ | || (_| || |_) |\__ \
+ * |_|    \__|(_)|_| \__,_||_.__/ |___/
+ *
+ * www.rt-labs.com
+ * Copyright 2022 rt-labs AB, Sweden. All rights reserved.
+ *
+ * See the file LICENSE.md distributed with this software for full
+ * license information.
+ ********************************************************************/
+
+#ifndef CL_COMMAND_QUEUE_H
+#define CL_COMMAND_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Number of commands that can be queued. Must be a power of two. */
+#define CL_COMMAND_QUEUE_SIZE 16
+
+/** Bounded queue with multiple producers (application threads) and a single
+    consumer (the stack thread), without locks.
+
+    The queue only keeps track of the slots. The owner stores the commands
+    in an array with CL_COMMAND_QUEUE_SIZE elements, indexed by
+    cl_command_queue_slot().
+
+    Each slot has a sequence number telling whether it is free, reserved or
+    published. A producer reserves a position by compare-and-swap of the
+    write position, writes the command and then publishes the slot. */
+typedef struct cl_command_queue
+{
+   volatile uint32_t sequences[CL_COMMAND_QUEUE_SIZE];
+
+   /** Next position to be reserved by a producer */
+   volatile uint32_t write_position;
+
+   /** Next position to be read by the consumer */
+   uint32_t read_position;
+} cl_command_queue_t;
+
+/**
+ * Initialise the command queue
+ *
+ * @param queue         Command queue
+ */
+void cl_command_queue_init (cl_command_queue_t * queue);
+
+/**
+ * Calculate the slot for a queue position
+ *
+ * @param position      Queue position
+ * @return Slot index, 0..CL_COMMAND_QUEUE_SIZE-1
+ */
+uint16_t cl_command_queue_slot (uint32_t position);
+
+/**
+ * Reserve a slot for a new command. Producer only.
+ *
+ * Write the command to the slot, and then call
+ * cl_command_queue_publish().
+ *
+ * @param queue         Command queue
+ * @param position      Resulting queue position
+ * @return 0 on success, -1 if the queue is full
+ */
+int cl_command_queue_reserve (cl_command_queue_t * queue, uint32_t * position);
+
+/**
+ * Make a command visible to the consumer. Producer only.
+ *
+ * @param queue         Command queue
+ * @param position      Queue position from cl_command_queue_reserve()
+ */
+void cl_command_queue_publish (cl_command_queue_t * queue, uint32_t position);
+
+/**
+ * Find the oldest published command. Consumer only.
+ *
+ * Commands are read in the order the positions were reserved. A command
+ * that is reserved but not yet published blocks the later commands
+ * until it is published.
+ *
+ * @param queue         Command queue
+ * @param position      Resulting queue position
+ * @return true if a command is available
+ */
+bool cl_command_queue_peek (cl_command_queue_t * queue, uint32_t * position);
+
+/**
+ * Release the oldest command, after it has been handled. Consumer only.
+ *
+ * @param queue         Command queue
+ */
+void cl_command_queue_release (cl_command_queue_t * queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CL_COMMAND_QUEUE_H */
@@ -505,6 +505,161 @@ int cl_iefb_request_get_slave_id (
    return 0;
 }
 
+/**
+ * Read a 64-bit word from a frame, in little endian byte order.
+ *
+ * @param bytes            First byte of the word. Might be unaligned.
+ * @return the word
+ */
+static uint64_t cl_iefb_load_le64 (const uint8_t * bytes)
+{
+   uint64_t value = 0;
+   size_t i;
+
+   for (i = sizeof (value); i > 0; i--)
+   {
+      value = (value << 8) | bytes[i - 1];
+   }
+
+   return value;
+}
+
+/**
+ * Select all bits of a header part in a template mask.
+ *
+ * @param mask_part        Part of the template mask
+ * @param size             Size of the part
+ */
+static void cl_iefb_template_select_all (void * mask_part, size_t size)
+{
+   uint8_t * mask_bytes = (uint8_t *)mask_part;
+   size_t i;
+
+   for (i = 0; i < size; i++)
+   {
+      mask_bytes[i] = UINT8_MAX;
+   }
+}
+
+/**
+ * Store the selected header values of a frame in a template.
+ *
+ * @param header_template  Template to be updated
+ * @param buffer           Frame that has passed the full validation
+ * @param mask_bytes       Template mask, one byte per frame byte
+ * @param frame_len        Required UDP payload length, or 0
+ */
+static void cl_iefb_template_store (
+   cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer,
+   const uint8_t * mask_bytes,
+   size_t frame_len)
+{
+   size_t i;
+
+   for (i = 0; i < CL_CCIEFB_HEADER_TEMPLATE_WORDS; i++)
+   {
+      header_template->mask[i] =
+         cl_iefb_load_le64 (&mask_bytes[i * sizeof (uint64_t)]);
+      header_template->expected[i] =
+         cl_iefb_load_le64 (&buffer[i * sizeof (uint64_t)]) &
+         header_template->mask[i];
+   }
+
+   header_template->frame_len = frame_len;
+   header_template->is_valid  = true;
+}
+
+void cl_iefb_learn_request_template (
+   cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer,
+   size_t recv_len)
+{
+   uint8_t mask_bytes[sizeof (header_template->mask)] = {0};
+   cl_cciefb_cyclic_req_full_headers_t * mask =
+      (cl_cciefb_cyclic_req_full_headers_t *)mask_bytes;
+   const cl_cciefb_cyclic_req_full_headers_t * full_headers =
+      (const cl_cciefb_cyclic_req_full_headers_t *)buffer;
+   uint16_t unit_info_bits =
+      (CC_FROM_LE16 (full_headers->cyclic_header.protocol_ver) == 1)
+         ? CL_CCIEFB_MASTER_STATION_NOTIFICATION_MASK_BITS_VER1
+         : CL_CCIEFB_MASTER_STATION_NOTIFICATION_MASK_BITS_VER2;
+
+   /* The frame length is fixed, so also the dl field */
+   cl_iefb_template_select_all (&mask->req_header, sizeof (mask->req_header));
+   cl_iefb_template_select_all (
+      &mask->cyclic_header,
+      sizeof (mask->cyclic_header));
+   mask->master_station_notification.master_local_unit_info =
+      CC_TO_LE16 (unit_info_bits);
+   mask->master_station_notification.reserved = UINT16_MAX;
+   mask->cyclic_data_header.master_id         = UINT32_MAX;
+   mask->cyclic_data_header.group_no          = UINT8_MAX;
+   mask->cyclic_data_header.reserved3         = UINT8_MAX;
+   mask->cyclic_data_header.slave_total_occupied_station_count = UINT16_MAX;
+   mask->cyclic_data_header.reserved4                          = UINT16_MAX;
+
+   cl_iefb_template_store (header_template, buffer, mask_bytes, recv_len);
+}
+
+void cl_iefb_learn_response_template (
+   cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer)
+{
+   uint8_t mask_bytes[sizeof (header_template->mask)] = {0};
+   cl_cciefb_cyclic_resp_full_headers_t * mask =
+      (cl_cciefb_cyclic_resp_full_headers_t *)mask_bytes;
+
+   /* The frame length differs between the slave devices in a group, so
+      the dl field is checked separately */
+   cl_iefb_template_select_all (&mask->resp_header, sizeof (mask->resp_header));
+   mask->resp_header.dl = 0;
+   cl_iefb_template_select_all (
+      &mask->cyclic_header,
+      sizeof (mask->cyclic_header));
+   mask->cyclic_header.end_code               = 0;
+   mask->slave_station_notification.reserved1 = UINT16_MAX;
+   mask->slave_station_notification.reserved2 = UINT16_MAX;
+   mask->slave_station_notification.slave_local_unit_info =
+      CC_TO_LE16 (CL_CCIEFB_SLAVE_STATION_NOTIFICATION_MASK_BITS);
+   mask->cyclic_data_header.group_no  = UINT8_MAX;
+   mask->cyclic_data_header.reserved2 = UINT8_MAX;
+
+   cl_iefb_template_store (header_template, buffer, mask_bytes, 0);
+}
+
+bool cl_iefb_matches_header_template (
+   const cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer,
+   size_t recv_len)
+{
+   size_t i;
+
+   if (!header_template->is_valid || recv_len < sizeof (header_template->mask))
+   {
+      return false;
+   }
+
+   if (
+      header_template->frame_len != 0 &&
+      recv_len != header_template->frame_len)
+   {
+      return false;
+   }
+
+   for (i = 0; i < CL_CCIEFB_HEADER_TEMPLATE_WORDS; i++)
+   {
+      if (
+         (cl_iefb_load_le64 (&buffer[i * sizeof (uint64_t)]) &
+          header_template->mask[i]) != header_template->expected[i])
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
 int cl_iefb_parse_req_full_cyclic_headers (
    uint8_t * buffer,
    size_t recv_len,
@@ -566,6 +721,7 @@ int cl_iefb_parse_cyclic_request (
    cl_ipaddr_t remote_ip,
    uint16_t remote_port,
    cl_ipaddr_t local_ip,
+   cl_cciefb_header_template_t * header_template,
    cls_cciefb_cyclic_request_info_t * request)
 {
    int result_parse_cyclic = 0;
@@ -579,9 +735,27 @@ int cl_iefb_parse_cyclic_request (
       return -1;
    }
 
-   if (cl_iefb_validate_req_full_cyclic_headers (request->full_headers, recv_len, remote_ip) != 0)
+   /* Headers equal to those of a previously validated frame (from the same
+      master) need no further validation */
+   if (
+      header_template == NULL ||
+      !cl_iefb_matches_header_template (header_template, buffer, recv_len) ||
+      CC_FROM_LE32 (request->full_headers->cyclic_data_header.master_id) !=
+         remote_ip)
    {
-      return -1;
+      if (
+         cl_iefb_validate_req_full_cyclic_headers (
+            request->full_headers,
+            recv_len,
+            remote_ip) != 0)
+      {
+         return -1;
+      }
+
+      if (header_template != NULL)
+      {
+         cl_iefb_learn_request_template (header_template, buffer, recv_len);
+      }
    }
 
    result_parse_cyclic = cl_iefb_parse_request_cyclic_data (
@@ -893,6 +1067,141 @@ uint16_t cl_iefb_register_calculate_areanumber (
    return number >> 5U;
 }
 
+bool cl_iefb_is_signal_range_valid (
+   uint16_t first_number,
+   uint16_t num_signals,
+   uint32_t max_signals)
+{
+   return (uint32_t)first_number + num_signals <= max_signals;
+}
+
+void cl_iefb_unpack_bits (
+   const uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values)
+{
+   uint32_t pos       = first_number;
+   const uint32_t end = (uint32_t)first_number + num_bits;
+   uint8_t byte;
+   uint16_t i;
+
+   /* Bits before the first byte boundary */
+   while (pos < end && (pos & 0x07U) != 0)
+   {
+      *values++ = ((first_byte[pos >> 3U] >> (pos & 0x07U)) & 0x01U) != 0;
+      pos++;
+   }
+
+   /* Whole bytes */
+   while (end - pos >= 8U)
+   {
+      byte = first_byte[pos >> 3U];
+      for (i = 0; i < 8U; i++)
+      {
+         values[i] = ((byte >> i) & 0x01U) != 0;
+      }
+      values += 8;
+      pos += 8U;
+   }
+
+   /* Remaining bits */
+   while (pos < end)
+   {
+      *values++ = ((first_byte[pos >> 3U] >> (pos & 0x07U)) & 0x01U) != 0;
+      pos++;
+   }
+}
+
+void cl_iefb_pack_bits (
+   uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values)
+{
+   uint32_t pos       = first_number;
+   const uint32_t end = (uint32_t)first_number + num_bits;
+   uint8_t mask;
+   uint8_t byte;
+   uint16_t i;
+
+   /* Bits before the first byte boundary */
+   while (pos < end && (pos & 0x07U) != 0)
+   {
+      mask = BIT (pos & 0x07U) & UINT8_MAX;
+      if (*values++)
+      {
+         first_byte[pos >> 3U] |= mask;
+      }
+      else
+      {
+         first_byte[pos >> 3U] &= ~mask;
+      }
+      pos++;
+   }
+
+   /* Whole bytes */
+   while (end - pos >= 8U)
+   {
+      byte = 0;
+      for (i = 0; i < 8U; i++)
+      {
+         byte |= (uint8_t)((values[i] ? 1U : 0U) << i);
+      }
+      first_byte[pos >> 3U] = byte;
+      values += 8;
+      pos += 8U;
+   }
+
+   /* Remaining bits */
+   while (pos < end)
+   {
+      mask = BIT (pos & 0x07U) & UINT8_MAX;
+      if (*values++)
+      {
+         first_byte[pos >> 3U] |= mask;
+      }
+      else
+      {
+         first_byte[pos >> 3U] &= ~mask;
+      }
+      pos++;
+   }
+}
+
+void cl_iefb_read_words (
+   const uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_words,
+   uint16_t * values)
+{
+   const uint8_t * source = first_byte + 2U * first_number;
+   uint16_t i;
+
+   /* Byte-wise, to be independent of alignment and host endianness */
+   for (i = 0; i < num_words; i++)
+   {
+      values[i] = (uint16_t)(source[2U * i] | (source[2U * i + 1U] << 8U));
+   }
+}
+
+void cl_iefb_write_words (
+   uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_words,
+   const uint16_t * values)
+{
+   uint8_t * destination = first_byte + 2U * first_number;
+   uint16_t i;
+
+   /* Byte-wise, to be independent of alignment and host endianness */
+   for (i = 0; i < num_words; i++)
+   {
+      destination[2U * i]      = (uint8_t)(values[i] & UINT8_MAX);
+      destination[2U * i + 1U] = (uint8_t)(values[i] >> 8U);
+   }
+}
+
 int cl_iefb_parse_response_header (
    uint8_t * buffer,
    size_t recv_len,
@@ -1127,10 +1436,12 @@ int cl_iefb_parse_cyclic_response (
    cl_ipaddr_t remote_ip,
    uint16_t remote_port,
    uint32_t now,
+   cl_cciefb_header_template_t * header_template,
    clm_cciefb_cyclic_response_info_t * response)
 {
    int result_parse_cyclic              = 0;
    uint16_t number_of_occupied_stations = 0;
+   cl_cciefb_cyclic_resp_full_headers_t * full_headers;
 
    response->remote_port         = remote_port;
    response->remote_ip           = remote_ip;
@@ -1140,14 +1451,33 @@ int cl_iefb_parse_cyclic_response (
    {
       return -1;
    }
+   full_headers = response->full_headers;
 
+   /* Headers equal to those of a previously validated frame (from the same
+      group) need no further validation, apart from the fields that differ
+      between the slave devices */
    if (
-      cl_iefb_validate_resp_full_cyclic_headers (
-         response->full_headers,
-         recv_len,
-         remote_ip) != 0)
+      header_template == NULL ||
+      !cl_iefb_matches_header_template (header_template, buffer, recv_len) ||
+      CC_FROM_LE16 (full_headers->resp_header.dl) +
+            CL_CCIEFB_RESP_HEADER_DL_OFFSET !=
+         recv_len ||
+      remote_ip == CL_IPADDR_INVALID ||
+      CC_FROM_LE32 (full_headers->cyclic_data_header.slave_id) != remote_ip)
    {
-      return -1;
+      if (
+         cl_iefb_validate_resp_full_cyclic_headers (
+            full_headers,
+            recv_len,
+            remote_ip) != 0)
+      {
+         return -1;
+      }
+
+      if (header_template != NULL)
+      {
+         cl_iefb_learn_response_template (header_template, buffer);
+      }
    }
 
    /* Validate that the size is correct with regards to the number of
@@ -279,6 +279,98 @@ uint16_t cl_iefb_register_calculate_areanumber (
    uint16_t number,
    uint16_t * register_in_area);
 
+/**
+ * Check that a range of signals fits within the memory areas of a device.
+ *
+ * @param first_number     First RX, RY, RWr or RWw number in the range
+ * @param num_signals      Number of signals in the range. Might be 0.
+ * @param max_signals      Number of signals in the memory areas
+ * @return true if the range is valid
+ */
+bool cl_iefb_is_signal_range_valid (
+   uint16_t first_number,
+   uint16_t num_signals,
+   uint32_t max_signals);
+
+/**
+ * Unpack a range of bit signals (RX or RY) to an array with one value per
+ * bit.
+ *
+ * The memory areas for a device are arranged linearly, so bit \a number
+ * is found in byte \a number/8 from the start of the first area.
+ * Whole bytes are unpacked at a time, when possible.
+ *
+ * No validation is done on input parameters.
+ *
+ * @param first_byte       Start of the first memory area
+ * @param first_number     First bit number
+ * @param num_bits         Number of bits
+ * @param values           Resulting values, with room for \a num_bits
+ */
+void cl_iefb_unpack_bits (
+   const uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values);
+
+/**
+ * Pack an array with one value per bit into a range of bit signals (RX or
+ * RY).
+ *
+ * Whole bytes are written at a time, when possible. Other bits in the
+ * first and last bytes are kept.
+ *
+ * No validation is done on input parameters.
+ *
+ * @param first_byte       Start of the first memory area
+ * @param first_number     First bit number
+ * @param num_bits         Number of bits
+ * @param values           Values to be packed
+ */
+void cl_iefb_pack_bits (
+   uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values);
+
+/**
+ * Read a range of word signals (RWr or RWw) and convert them from little
+ * endian to host endianness.
+ *
+ * The memory areas might be unaligned (in a frame buffer).
+ *
+ * No validation is done on input parameters.
+ *
+ * @param first_byte       Start of the first memory area
+ * @param first_number     First register number
+ * @param num_words        Number of registers
+ * @param values           Resulting values, with room for \a num_words
+ */
+void cl_iefb_read_words (
+   const uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_words,
+   uint16_t * values);
+
+/**
+ * Write a range of word signals (RWr or RWw), converting them from host
+ * endianness to little endian.
+ *
+ * The memory areas might be unaligned (in a frame buffer).
+ *
+ * No validation is done on input parameters.
+ *
+ * @param first_byte       Start of the first memory area
+ * @param first_number     First register number
+ * @param num_words        Number of registers
+ * @param values           Values to be written
+ */
+void cl_iefb_write_words (
+   uint8_t * first_byte,
+   uint16_t first_number,
+   uint16_t num_words,
+   const uint16_t * values);
+
 /**
  * Validate CCIEFB cyclic request header
  *
@@ -387,6 +479,50 @@ int cl_iefb_analyze_slave_ids (
    uint16_t * my_slave_station_no,
    uint16_t * implied_occupation_count);
 
+/**
+ * Learn the expected headers of cyclic requests from a frame.
+ *
+ * Selects the header fields that are constant for a master and group, and
+ * that are needed for the validation. The frame must have passed
+ * cl_iefb_validate_req_full_cyclic_headers().
+ *
+ * @param header_template  Resulting template
+ * @param buffer           Validated request frame
+ * @param recv_len         UDP payload length
+ */
+void cl_iefb_learn_request_template (
+   cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer,
+   size_t recv_len);
+
+/**
+ * Learn the expected headers of cyclic responses from a frame.
+ *
+ * Selects the header fields that are constant for the slave devices in a
+ * group, and that are needed for the validation. The frame must have passed
+ * cl_iefb_validate_resp_full_cyclic_headers().
+ *
+ * @param header_template  Resulting template
+ * @param buffer           Validated response frame
+ */
+void cl_iefb_learn_response_template (
+   cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer);
+
+/**
+ * Compare the headers of a frame to a template, using a few masked 64-bit
+ * compares.
+ *
+ * @param header_template  Template
+ * @param buffer           Frame to be checked
+ * @param recv_len         UDP payload length
+ * @return true if the template is valid and the frame matches it
+ */
+bool cl_iefb_matches_header_template (
+   const cl_cciefb_header_template_t * header_template,
+   const uint8_t * buffer,
+   size_t recv_len);
+
 /**
  * Parse CCIEFB cyclic request message headers
  *
@@ -540,6 +676,9 @@ void cl_iefb_update_cyclic_response_frame (
  *                         verification.
  * @param remote_port      Remote UDP port. Will be used at response.
  * @param local_ip         Local IP address. Will be used at response.
+ * @param header_template  Expected headers, or NULL. If the headers match,
+ *                         the full validation is skipped. Otherwise the
+ *                         template is updated from the frame if valid.
  * @param request          Resulting parsed request
  * @return 0 on success, -1 on failure
  */
@@ -549,6 +688,7 @@ int cl_iefb_parse_cyclic_request (
    cl_ipaddr_t remote_ip,
    uint16_t remote_port,
    cl_ipaddr_t local_ip,
+   cl_cciefb_header_template_t * header_template,
    cls_cciefb_cyclic_request_info_t * request);
 
 /**
@@ -701,6 +841,9 @@ int cl_iefb_parse_response_cyclic_data (
  * @param remote_ip        Remote IP. Also used for validation.
  * @param remote_port      Remote UDP port.
  * @param now              Current timestamp, in microseconds
+ * @param header_template  Expected headers, or NULL. If the headers match,
+ *                         the full validation is skipped. Otherwise the
+ *                         template is updated from the frame if valid.
  * @param response         Resulting parsed response
  * @return 0 on success, -1 on failure
  *
@@ -711,6 +854,7 @@ int cl_iefb_parse_cyclic_response (
    cl_ipaddr_t remote_ip,
    uint16_t remote_port,
    uint32_t now,
+   cl_cciefb_header_template_t * header_template,
    clm_cciefb_cyclic_response_info_t * response);
 
 #ifdef __cplusplus
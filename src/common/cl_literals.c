@@ -160,6 +160,8 @@ const char * cl_literals_get_master_error_message (clm_error_message_t message)
       return "SLAVE_REPORTS_WRONG_NUMBER_OCCUPIED";
    case CLM_ERROR_SLAVE_REPORTS_MASTER_DUPLICATION:
       return "SLAVE_REPORTS_MASTER_DUPLICATION";
+   case CLM_ERROR_CCIEFB_FRAMES_DROPPED:
+      return "CCIEFB_FRAMES_DROPPED";
    default:
       return "unknown error";
    }
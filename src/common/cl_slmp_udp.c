@@ -111,3 +111,78 @@ int cl_slmp_udp_send (
 
    return 0;
 }
+
+void cl_slmp_udp_close_persistent (cl_slmp_send_socket_t * send_socket)
+{
+   if (send_socket->handle != -1)
+   {
+      LOG_DEBUG (
+         CL_SLMP_LOG,
+         "SLMP(%d): Closing SLMP send socket %d.\n",
+         __LINE__,
+         send_socket->handle);
+      clal_udp_close (send_socket->handle);
+      send_socket->handle = -1;
+   }
+}
+
+int cl_slmp_udp_send_persistent (
+   cl_slmp_send_socket_t * send_socket,
+   uint8_t * buffer,
+   size_t buffer_size,
+   cl_ipaddr_t local_ip,
+   cl_ipaddr_t remote_ip,
+   uint16_t remote_port,
+   size_t message_size)
+{
+#if LOG_DEBUG_ENABLED(CL_SLMP_LOG)
+   char ip_string[CL_INET_ADDRSTR_SIZE] = {0}; /** Terminated string */
+#endif
+
+   if (message_size > buffer_size)
+   {
+      return -1;
+   }
+
+   /* Our IP address has changed since the socket was opened */
+   if (send_socket->handle != -1 && send_socket->local_ip != local_ip)
+   {
+      cl_slmp_udp_close_persistent (send_socket);
+   }
+
+   if (send_socket->handle == -1)
+   {
+#if LOG_DEBUG_ENABLED(CL_SLMP_LOG)
+      cl_util_ip_to_string (local_ip, ip_string);
+      LOG_DEBUG (
+         CL_SLMP_LOG,
+         "SLMP(%d): Opening socket for sending SLMP. Binding to IP "
+         "address %s port %u\n",
+         __LINE__,
+         ip_string,
+         CL_SLMP_PORT);
+#endif
+#ifndef FUZZ_TEST
+      send_socket->handle = clal_udp_open (local_ip, CL_SLMP_PORT);
+#endif
+      send_socket->local_ip = local_ip;
+   }
+
+   if (
+      cl_slmp_udp_send (
+         &send_socket->handle,
+         false,
+         buffer,
+         buffer_size,
+         local_ip,
+         remote_ip,
+         remote_port,
+         message_size) != 0)
+   {
+      /* Open a new socket on next attempt */
+      cl_slmp_udp_close_persistent (send_socket);
+      return -1;
+   }
+
+   return 0;
+}
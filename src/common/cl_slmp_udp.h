@@ -50,6 +50,46 @@ int cl_slmp_udp_send (
    uint16_t remote_port,
    size_t message_size);
 
+/**
+ * Send a SLMP message via UDP, on a socket that is kept open between calls
+ *
+ * The socket is bound to \a local_ip and CL_SLMP_PORT, so the frames have
+ * the same source address and port as when a new socket is opened for each
+ * message. As this binding is more specific than a receive socket bound to
+ * CL_IPADDR_ANY, incoming unicast SLMP frames might be delivered to this
+ * socket. The caller must read incoming frames from it as well.
+ *
+ * The socket is opened on first use. If \a local_ip differs from the
+ * IP address the socket is bound to (for example after a set IP request),
+ * the socket is closed and opened again. The socket is also closed if
+ * sending fails, so it is opened again on next call.
+ *
+ * @param send_socket         Socket to use. Set the handle to -1 before
+ *                            first use.
+ * @param buffer              Buffer with outgoing message
+ * @param buffer_size         Buffer size
+ * @param local_ip            Local IP address for opening the socket
+ * @param remote_ip           Remote (destination) IP address
+ * @param remote_port         Remote UDP port
+ * @param message_size        Number of bytes to send
+ * @return 0 on success, or -1 on error
+ */
+int cl_slmp_udp_send_persistent (
+   cl_slmp_send_socket_t * send_socket,
+   uint8_t * buffer,
+   size_t buffer_size,
+   cl_ipaddr_t local_ip,
+   cl_ipaddr_t remote_ip,
+   uint16_t remote_port,
+   size_t message_size);
+
+/**
+ * Close a SLMP send socket, if it is open.
+ *
+ * @param send_socket         Socket to close
+ */
+void cl_slmp_udp_close_persistent (cl_slmp_send_socket_t * send_socket);
+
 #ifdef __cplusplus
 }
 #endif
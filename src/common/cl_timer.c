@@ -88,6 +88,223 @@ bool cl_timer_is_running (cl_timer_t * timer)
    return timer->state == CL_TIMER_RUNNING;
 }
 
+bool cl_timer_get_remaining (
+   cl_timer_t * timer,
+   uint32_t now,
+   uint32_t * remaining)
+{
+   uint32_t delta;
+
+   if (timer->state == CL_TIMER_STOPPED)
+   {
+      return false;
+   }
+
+   delta = now - timer->timestamp;
+   if (delta > (UINT32_MAX >> 1U))
+   {
+      /* Timer started in the future */
+      *remaining = timer->period + (timer->timestamp - now);
+   }
+   else if (delta >= timer->period)
+   {
+      *remaining = 0;
+   }
+   else
+   {
+      *remaining = timer->period - delta;
+   }
+
+   return true;
+}
+
+void cl_timer_update_earliest_deadline (
+   cl_timer_t * timer,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   uint32_t remaining = 0;
+
+   if (!cl_timer_get_remaining (timer, now, &remaining))
+   {
+      return;
+   }
+
+   if (*found == false || remaining < *earliest)
+   {
+      *earliest = remaining;
+   }
+   *found = true;
+}
+
+/**
+ * Check if a heap entry should be placed before another one.
+ *
+ * @param a           Heap entry
+ * @param b           Other heap entry
+ * @return true if \a a has an earlier deadline, or the same deadline and
+ *         a lower id
+ */
+static bool cl_timer_heap_is_before (
+   const cl_timer_heap_entry_t * a,
+   const cl_timer_heap_entry_t * b)
+{
+   if (a->deadline != b->deadline)
+   {
+      return (int32_t)(a->deadline - b->deadline) < 0;
+   }
+
+   return a->id < b->id;
+}
+
+/**
+ * Place a heap entry at a position, and update the position lookup.
+ *
+ * @param heap        Timer heap
+ * @param position    Index in \a heap->entries
+ * @param entry       Heap entry to place
+ */
+static void cl_timer_heap_place (
+   cl_timer_heap_t * heap,
+   uint16_t position,
+   const cl_timer_heap_entry_t * entry)
+{
+   heap->entries[position]    = *entry;
+   heap->positions[entry->id] = position + 1;
+}
+
+/**
+ * Restore the heap order for an entry that might be placed too low or too
+ * high in the heap.
+ *
+ * @param heap        Timer heap
+ * @param position    Index in \a heap->entries of the entry to move
+ */
+static void cl_timer_heap_sift (cl_timer_heap_t * heap, uint16_t position)
+{
+   cl_timer_heap_entry_t entry = heap->entries[position];
+   uint16_t parent;
+   uint16_t child;
+
+   /* Move towards the root */
+   while (position > 0)
+   {
+      parent = (position - 1) / 2;
+      if (!cl_timer_heap_is_before (&entry, &heap->entries[parent]))
+      {
+         break;
+      }
+      cl_timer_heap_place (heap, position, &heap->entries[parent]);
+      position = parent;
+   }
+
+   /* Move towards the leaves */
+   for (;;)
+   {
+      child = 2 * position + 1;
+      if (child >= heap->size)
+      {
+         break;
+      }
+      if (
+         child + 1 < heap->size &&
+         cl_timer_heap_is_before (
+            &heap->entries[child + 1],
+            &heap->entries[child]))
+      {
+         child++;
+      }
+      if (!cl_timer_heap_is_before (&heap->entries[child], &entry))
+      {
+         break;
+      }
+      cl_timer_heap_place (heap, position, &heap->entries[child]);
+      position = child;
+   }
+
+   cl_timer_heap_place (heap, position, &entry);
+}
+
+void cl_timer_heap_init (cl_timer_heap_t * heap)
+{
+   uint16_t id;
+
+   heap->size = 0;
+   for (id = 0; id < CL_TIMER_HEAP_MAX_TIMERS; id++)
+   {
+      heap->positions[id] = 0;
+   }
+}
+
+int cl_timer_heap_schedule (
+   cl_timer_heap_t * heap,
+   uint16_t id,
+   const cl_timer_t * timer)
+{
+   uint16_t position;
+
+   if (id >= CL_TIMER_HEAP_MAX_TIMERS)
+   {
+      return -1;
+   }
+
+   if (timer->state == CL_TIMER_STOPPED)
+   {
+      cl_timer_heap_remove (heap, id);
+      return 0;
+   }
+
+   if (heap->positions[id] == 0)
+   {
+      position = heap->size;
+      heap->size++;
+   }
+   else
+   {
+      position = heap->positions[id] - 1;
+   }
+
+   heap->entries[position].deadline = timer->timestamp + timer->period;
+   heap->entries[position].id       = id;
+   cl_timer_heap_sift (heap, position);
+
+   return 0;
+}
+
+void cl_timer_heap_remove (cl_timer_heap_t * heap, uint16_t id)
+{
+   uint16_t position;
+
+   if (id >= CL_TIMER_HEAP_MAX_TIMERS || heap->positions[id] == 0)
+   {
+      return;
+   }
+
+   position            = heap->positions[id] - 1;
+   heap->positions[id] = 0;
+   heap->size--;
+
+   if (position < heap->size)
+   {
+      /* Fill the gap with the last entry */
+      cl_timer_heap_place (heap, position, &heap->entries[heap->size]);
+      cl_timer_heap_sift (heap, position);
+   }
+}
+
+bool cl_timer_heap_peek (const cl_timer_heap_t * heap, uint16_t * id)
+{
+   if (heap->size == 0)
+   {
+      return false;
+   }
+
+   *id = heap->entries[0].id;
+
+   return true;
+}
+
 void cl_timer_show (cl_timer_t * timer, uint32_t now)
 {
    uint32_t delta;
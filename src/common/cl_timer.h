@@ -37,6 +37,31 @@ typedef struct cl_timer
    uint32_t timestamp;
 } cl_timer_t;
 
+/** Max number of timers in a timer heap */
+#define CL_TIMER_HEAP_MAX_TIMERS 256
+
+typedef struct cl_timer_heap_entry
+{
+   uint32_t deadline; /** Timestamp + period, in microseconds */
+   uint16_t id;
+} cl_timer_heap_entry_t;
+
+/** Binary min-heap of timer deadlines, for finding the timer that expires
+    first without checking all timers. Each timer is identified by a number
+    0..CL_TIMER_HEAP_MAX_TIMERS-1, chosen by the user of the heap. */
+typedef struct cl_timer_heap
+{
+   /** Number of scheduled timers */
+   uint16_t size;
+
+   /** Scheduled timers, with the earliest deadline first */
+   cl_timer_heap_entry_t entries[CL_TIMER_HEAP_MAX_TIMERS];
+
+   /** Index in \a entries plus one for each timer id, or 0 if the timer is
+       not scheduled */
+   uint16_t positions[CL_TIMER_HEAP_MAX_TIMERS];
+} cl_timer_heap_t;
+
 /**
  * Start the timer
  *
@@ -112,6 +137,92 @@ bool cl_timer_is_expired (cl_timer_t * timer, uint32_t now);
  */
 bool cl_timer_is_running (cl_timer_t * timer);
 
+/**
+ * Calculate the time remaining until the timer expires.
+ *
+ * This function handles wrapping correctly. If \a now is less than the
+ * time when the timer was started, the remaining time will be longer than
+ * the period.
+ *
+ * @param timer       Timer instance
+ * @param now         Current timestamp, in microseconds
+ * @param remaining   Resulting time until the timer expires, in
+ *                    microseconds. Set to 0 if the timer has expired.
+ *                    Not updated if the timer is stopped.
+ * @return true if the timer is running, false otherwise
+ */
+bool cl_timer_get_remaining (
+   cl_timer_t * timer,
+   uint32_t now,
+   uint32_t * remaining);
+
+/**
+ * Update the earliest deadline, if the timer expires before it.
+ *
+ * Intended for finding the earliest expiry among several timers. Set
+ * \a found to false before checking the first timer.
+ *
+ * @param timer       Timer instance
+ * @param now         Current timestamp, in microseconds
+ * @param found       Set to true if the timer is running. Not updated if the
+ *                    timer is stopped.
+ * @param earliest    Time until the earliest deadline found so far, in
+ *                    microseconds. Updated if the timer is running and
+ *                    expires earlier, or if no deadline was found before.
+ */
+void cl_timer_update_earliest_deadline (
+   cl_timer_t * timer,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
+/**
+ * Initialise a timer heap, with no scheduled timers.
+ *
+ * @param heap        Timer heap
+ */
+void cl_timer_heap_init (cl_timer_heap_t * heap);
+
+/**
+ * Schedule a timer in the heap, after it has been started or stopped.
+ *
+ * A running timer is inserted, or moved if already scheduled. A stopped
+ * timer is removed from the heap.
+ *
+ * Timers with the same deadline are sorted by id.
+ *
+ * @param heap        Timer heap
+ * @param id          Timer id. Max value is CL_TIMER_HEAP_MAX_TIMERS-1.
+ * @param timer       Timer instance
+ * @return 0 on success, -1 on failure (invalid id)
+ */
+int cl_timer_heap_schedule (
+   cl_timer_heap_t * heap,
+   uint16_t id,
+   const cl_timer_t * timer);
+
+/**
+ * Remove a timer from the heap.
+ *
+ * Do nothing if the timer is not scheduled.
+ *
+ * @param heap        Timer heap
+ * @param id          Timer id
+ */
+void cl_timer_heap_remove (cl_timer_heap_t * heap, uint16_t id);
+
+/**
+ * Find the scheduled timer with the earliest deadline.
+ *
+ * Deadlines are compared with wrapping, so all scheduled timers must expire
+ * within UINT32_MAX/2 microseconds from each other.
+ *
+ * @param heap        Timer heap
+ * @param id          Resulting timer id. Not updated if the heap is empty.
+ * @return true if a timer is scheduled, false if the heap is empty
+ */
+bool cl_timer_heap_peek (const cl_timer_heap_t * heap, uint16_t * id);
+
 /**
  * Show timer state, for debugging.
  *
@@ -22,6 +22,7 @@ extern "C" {
 #include "cl_options.h"
 #include "clm_api.h"
 #include "cls_api.h"
+#include "common/cl_command_queue.h"
 #include "common/cl_limiter.h"
 #include "common/cl_timer.h"
 #include "common/clal.h"
@@ -43,6 +44,14 @@ extern "C" {
 /* UDP payload buffer size */
 #define CL_BUFFER_LEN 1500
 
+/* Estimated operating system bookkeeping per datagram in a socket receive
+   buffer, used when sizing the buffer for a burst of frames */
+#define CL_SOCKET_RECEIVE_OVERHEAD_PER_FRAME 256
+
+/* Max number of attempts to read a consistent input snapshot, while the
+   stack is updating the incoming data */
+#define CLM_INPUT_SNAPSHOT_MAX_ATTEMPTS 100
+
 #define CL_INET_ADDRSTR_SIZE 16 /** Incl termination */
 #define CL_ETH_ADDRSTR_SIZE  18 /** Incl termination */
 
@@ -591,6 +600,35 @@ typedef struct CC_PACKED cl_cciefb_cyclic_resp_full_headers
 } cl_cciefb_cyclic_resp_full_headers_t;
 CC_PACKED_END
 
+/** Number of 64-bit words in a header template. Covers the full headers of
+    both cyclic requests and cyclic responses. */
+#define CL_CCIEFB_HEADER_TEMPLATE_WORDS 9
+
+CC_STATIC_ASSERT (
+   CL_CCIEFB_HEADER_TEMPLATE_WORDS * sizeof (uint64_t) >=
+   sizeof (cl_cciefb_cyclic_req_full_headers_t));
+CC_STATIC_ASSERT (
+   CL_CCIEFB_HEADER_TEMPLATE_WORDS * sizeof (uint64_t) >=
+   sizeof (cl_cciefb_cyclic_resp_full_headers_t));
+
+/** Expected header values for fast validation of incoming cyclic frames.
+
+    Learned from a frame that has passed the full validation. A frame
+    matches if the bits selected by \a mask are equal to \a expected, which
+    then implies that the frame headers are valid. The words are read from
+    the frame in little endian byte order. */
+typedef struct cl_cciefb_header_template
+{
+   bool is_valid;
+
+   /** Required UDP payload length, or 0 if the length is checked via the
+       dl field in the frame */
+   size_t frame_len;
+
+   uint64_t expected[CL_CCIEFB_HEADER_TEMPLATE_WORDS];
+   uint64_t mask[CL_CCIEFB_HEADER_TEMPLATE_WORDS];
+} cl_cciefb_header_template_t;
+
 typedef struct cls_cciefb_cyclic_response_info
 {
    uint8_t * buffer;
@@ -623,7 +661,26 @@ typedef struct clm_cciefb_cyclic_response_info
    cl_rx_t * first_rx;
 } clm_cciefb_cyclic_response_info_t;
 
-/** Runtime data for one group, including transmission buffer */
+/** Runtime data for one slave device, used when handling each frame.
+
+    Stored densely in the group data, to keep the per-frame handling within
+    few cache lines. The rarely used frame values and statistics are stored
+    separately, see \a device_details in \a clm_group_data_t. */
+typedef struct clm_slave_device_hot
+{
+   clm_device_state_t device_state;
+   uint16_t device_index;       /** Within a group. Starts at 0. */
+   uint16_t slave_station_no;   /** Within a group. Starts at 1. */
+   uint16_t timeout_count;      /** Also known as ContinuousTimeoutCount */
+   bool enabled;                /** Also known as StartCyclicFlag */
+   bool transmission_bit;
+   bool force_transmission_bit; /** For slave testing only */
+} clm_slave_device_hot_t;
+
+/** Runtime data for one group, including transmission buffer.
+
+    Fields used when handling each frame are placed first, and the large
+    buffers and the rarely used device details last. */
 typedef struct clm_group_data
 {
    uint16_t group_index;       /** Group number, allowed 0..63 */
@@ -631,20 +688,336 @@ typedef struct clm_group_data
    uint16_t frame_sequence_no; /** Frame sequence counter */
    uint16_t cyclic_transmission_state; /** One bit per slave */
    uint32_t timestamp_link_scan_start;
+
+   /** Timestamp (application tick) when the request frame was sent */
+   uint32_t timestamp_request_sent;
+
+   /** Transmission timestamp of the request frame from the port, read
+       from the socket error queue. Only valid if
+       \a timestamp_request_transmitted_valid is true. The response time
+       uses either these port timestamps on both sides, or the application
+       ticks on both sides. */
+   uint32_t timestamp_request_transmitted;
+   bool timestamp_request_transmitted_valid;
+
+   /** Number of the latest request datagram on the CCIEFB socket plus
+       one, or zero if none. See clal_udp_read_error_queue(). */
+   uint32_t request_datagram_id;
    clm_group_state_t group_state;
    cl_timer_t response_wait_timer;
    cl_timer_t constant_linkscan_timer; /** Also known as ListenTimer */
 
-   /** Frame for CCIEFB requests, for sending outgoing RY and RWw data */
-   uint8_t sendbuf[CL_BUFFER_LEN];
+   clm_slave_device_hot_t slave_devices[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
+
+   /** One bit per slave station, set when the RY or RWw memory area has
+       changed since it was copied to \a req_frame. With double buffered
+       outputs, set when the station differs between \a req_frame and
+       \a staging_req_frame, and cleared when publishing. */
+   uint16_t dirty_outputs;
+
+   /** One bit per slave device index, set for the devices that the current
+       link scan waits for. The link scan is complete when no bit is set,
+       and \a responding_devices is non-zero. Both are updated after each
+       event to the device state machine. */
+   uint16_t awaiting_responses;
+   uint16_t responding_devices;
+
+   /** One bit per slave device index, set for the devices that did not
+       respond in the latest link scan. Zero if it completed. */
+   uint16_t missing_responses;
+
+   /** Sequence counter protecting RX and RWr in \a memory_area, for
+       application threads reading snapshots. Odd while the stack is
+       updating the incoming data. Only accessed via
+       clm_iefb_input_write_begin() and the related functions. */
+   volatile uint32_t input_sequence;
+
+   /** Frame sequence number and link scan start of the latest stored
+       incoming data. Protected by \a input_sequence. */
+   uint16_t input_frame_sequence_no;
+   uint32_t input_timestamp_link_scan_start;
+
+   /** Request frame, pointing into \a sendbuf or \a staging_sendbuf */
    clm_cciefb_cyclic_request_info_t req_frame;
 
-   clm_slave_device_data_t slave_devices[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
+   /** Inactive request frame, where the application writes RY and RWw.
+       Only used with double buffered outputs. The buffers are swapped with
+       \a req_frame by clm_iefb_publish_outputs(), so \a req_frame and
+       \a staging_req_frame might use either of the two buffers. */
+   clm_cciefb_cyclic_request_info_t staging_req_frame;
+
+   /** Expected headers of cyclic responses in this group */
+   cl_cciefb_header_template_t response_template;
+
+   /** Changed RX bits and RWr registers per slave station, accumulated
+       until read by the application */
+   uint64_t changed_rx[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
+   uint32_t changed_rwr[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
 
    /** Memory area for user data. RX, RY, RWr and RWw. */
    clm_group_memory_area_t memory_area;
+
+   /** Buffers for CCIEFB requests, for sending outgoing RY and RWw data */
+   uint8_t sendbuf[CL_BUFFER_LEN];
+   uint8_t staging_sendbuf[CL_BUFFER_LEN];
+
+   /** Latest frame values and statistics per slave device, written by the
+       stack. The remaining fields are only written when assembling the view
+       given by clm_iefb_get_device_connection_details(), so they are only
+       valid after such a call. */
+   clm_slave_device_data_t device_details[CLM_MAX_OCCUPIED_STATIONS_PER_GROUP];
 } clm_group_data_t;
 
+/** Number of slots in the master slave lookup index. Must be a power of two,
+    and at least twice the max number of slave devices so that the probe
+    sequences stay short. */
+#define CLM_SLAVE_INDEX_SIZE                                                   \
+   (2 * CL_CCIEFB_MAX_OCCUPIED_STATIONS_FOR_ALL_GROUPS)
+
+CC_STATIC_ASSERT ((CLM_SLAVE_INDEX_SIZE & (CLM_SLAVE_INDEX_SIZE - 1)) == 0);
+
+/** Timer ids in the master timer heap. The arbitration timer is followed by
+    the response wait timer and the constant link scan timer of each group.
+    See clm_iefb_schedule_timer(). */
+#define CLM_TIMER_ID_ARBITRATION                    0
+#define CLM_TIMER_ID_RESPONSE_WAIT(group_index)     (1 + 2 * (group_index))
+#define CLM_TIMER_ID_CONSTANT_LINKSCAN(group_index) (2 + 2 * (group_index))
+#define CLM_NUMBER_OF_TIMER_IDS                     (1 + 2 * CLM_MAX_GROUPS)
+
+CC_STATIC_ASSERT (CLM_NUMBER_OF_TIMER_IDS <= CL_TIMER_HEAP_MAX_TIMERS);
+
+/** Entry in the master slave lookup index, for finding the slave device
+    from the source IP address of an incoming response frame.
+
+    Rebuilt from the configured hierarchy at startup and for each new
+    configuration. See clm_iefb_build_slave_index(). */
+typedef struct clm_slave_index_entry
+{
+   /** Slave IP address. CL_IPADDR_INVALID for an empty slot. */
+   cl_ipaddr_t slave_id;
+   uint16_t group_index;
+   uint16_t device_index; /** Within group */
+} clm_slave_index_entry_t;
+
+/** Outgoing CCIEFB request frames, waiting to be sent in one batch */
+typedef struct clm_send_queue
+{
+   /** At most one frame per group */
+   clal_udp_message_t messages[CLM_MAX_GROUPS];
+   uint16_t count;
+
+   /** Queue outgoing CCIEFB request frames instead of sending them
+       directly. Enabled while the stack handles timers and incoming
+       frames, so that request frames to several groups are sent
+       together. */
+   bool deferred;
+} clm_send_queue_t;
+
+/** Number of application callbacks that can be queued, per queue, if
+    \a use_async_callbacks is enabled or master shards are used. Must be a
+    power of two. */
+#define CLM_CALLBACK_QUEUE_SIZE 32
+
+CC_STATIC_ASSERT (
+   (CLM_CALLBACK_QUEUE_SIZE & (CLM_CALLBACK_QUEUE_SIZE - 1)) == 0);
+
+typedef enum clm_callback_type
+{
+   CLM_CALLBACK_CONNECT,
+   CLM_CALLBACK_DISCONNECT,
+   CLM_CALLBACK_LINKSCAN,
+   CLM_CALLBACK_ALARMFRAME,
+   CLM_CALLBACK_SLAVEINFO,
+   CLM_CALLBACK_ERROR,          /** Only queued from master shards */
+   CLM_CALLBACK_INPUTS_CHANGED, /** Only queued from master shards */
+   CLM_CALLBACK_COMMAND_CFM,    /** Only queued from master shards */
+} clm_callback_type_t;
+
+/** Application callback, waiting to be delivered by
+    clm_iefb_dispatch_callbacks() */
+typedef struct clm_callback_record
+{
+   uint8_t type; /** clm_callback_type_t */
+   bool success; /** Only for CLM_CALLBACK_LINKSCAN and
+                     CLM_CALLBACK_COMMAND_CFM */
+   uint16_t group_index;
+   uint16_t slave_device_index;
+
+   /** Only for CLM_CALLBACK_ALARMFRAME and CLM_CALLBACK_SLAVEINFO */
+   uint16_t end_code;
+   uint16_t slave_err_code;
+   uint32_t local_management_info;
+
+   /** Only for CLM_CALLBACK_CONNECT and CLM_CALLBACK_DISCONNECT, and the
+       IP address for CLM_CALLBACK_ERROR */
+   cl_ipaddr_t slave_id;
+
+   /** Only for CLM_CALLBACK_ERROR */
+   uint16_t error_message; /** clm_error_message_t */
+   uint16_t argument_2;
+
+   /** Only for CLM_CALLBACK_INPUTS_CHANGED */
+   cl_changed_signals_t changed;
+
+   /** Only for CLM_CALLBACK_COMMAND_CFM */
+   clm_command_t command;
+} clm_callback_record_t;
+
+/** Application callbacks, waiting to be delivered on the application
+    thread. Used if \a use_async_callbacks is enabled, and for the
+    callbacks from master shards.
+
+    Single producer (the thread running the groups) and single consumer
+    (the thread calling clm_dispatch_callbacks(), or the thread running
+    clm_iefb_periodic() for master shards), without locks. */
+typedef struct clm_callback_queue
+{
+   clm_callback_record_t records[CLM_CALLBACK_QUEUE_SIZE];
+   uint32_t write_count;
+   uint32_t read_count;
+
+   /** Callbacks dropped due to a full queue. Updated by the producer. */
+   uint32_t overflows;
+
+   /** Link scan callbacks not queued, as the latest callback waiting in
+       the queue was an identical link scan callback for the same group.
+       Updated by the producer. */
+   uint32_t coalesced_linkscans;
+} clm_callback_queue_t;
+
+/** Smallest power of two that is at least \a x, for \a x up to 1024 */
+#define CL_POWER_OF_TWO_AT_LEAST(x)                                            \
+   ((x) <= 1     ? 1                                                           \
+    : (x) <= 2   ? 2                                                           \
+    : (x) <= 4   ? 4                                                           \
+    : (x) <= 8   ? 8                                                           \
+    : (x) <= 16  ? 16                                                          \
+    : (x) <= 32  ? 32                                                          \
+    : (x) <= 64  ? 64                                                          \
+    : (x) <= 128 ? 128                                                         \
+    : (x) <= 256 ? 256                                                         \
+    : (x) <= 512 ? 512                                                         \
+                 : 1024)
+
+/** Number of groups in each master shard, if CLM_MAX_SHARDS shards are used
+    for CLM_MAX_GROUPS groups */
+#define CLM_SHARD_MAX_GROUPS                                                   \
+   ((CLM_MAX_GROUPS + CLM_MAX_SHARDS - 1) / CLM_MAX_SHARDS)
+
+/** Number of frames in the incoming frame queue of each master shard.
+    Fits the responses from a full link scan of CLM_SHARD_MAX_GROUPS groups.
+    Must be a power of two. If a shard runs more groups, or falls behind,
+    the frames that do not fit are dropped and counted in
+    \a queue_overflows. */
+#define CLM_SHARD_FRAME_QUEUE_SIZE                                             \
+   ((CLM_MAX_SHARDS > 1) ? CL_POWER_OF_TWO_AT_LEAST (                          \
+                              CLM_SHARD_MAX_GROUPS *                           \
+                              CLM_MAX_OCCUPIED_STATIONS_PER_GROUP)             \
+                         : 1)
+
+/** Number of group events in the event queue of each master shard.
+    Must be a power of two. */
+#define CLM_SHARD_EVENT_QUEUE_SIZE ((CLM_MAX_SHARDS > 1) ? 16 : 1)
+
+CC_STATIC_ASSERT (
+   (CLM_SHARD_FRAME_QUEUE_SIZE & (CLM_SHARD_FRAME_QUEUE_SIZE - 1)) == 0);
+CC_STATIC_ASSERT (
+   CLM_SHARD_MAX_GROUPS * CLM_MAX_OCCUPIED_STATIONS_PER_GROUP <= 1024);
+CC_STATIC_ASSERT (
+   (CLM_SHARD_EVENT_QUEUE_SIZE & (CLM_SHARD_EVENT_QUEUE_SIZE - 1)) == 0);
+
+/** Incoming response frame, steered to the shard owning the group */
+typedef struct clm_shard_frame
+{
+   uint32_t port_timestamp;
+   bool port_timestamp_valid;
+   cl_ipaddr_t remote_ip;
+   uint16_t remote_port;
+   uint16_t len;
+   uint8_t buffer[CL_BUFFER_LEN];
+} clm_shard_frame_t;
+
+/** Command for a group, waiting to be executed by the shard owning the
+    group */
+typedef struct clm_shard_command
+{
+   clm_command_t command;
+
+   /** Report the result via the command callback. Set for commands from
+       clm_submit_command(). */
+   bool confirm;
+} clm_shard_command_t;
+
+/** Runtime data for a master shard, that runs a subset of the groups in
+    its own thread. See \a number_of_shards in the configuration.
+
+    The frame and event queues have a single producer (the thread running
+    clm_iefb_periodic()) and a single consumer (the thread running the
+    shard). No locks are used. Each read and write counter is only updated
+    by one of the threads, after a memory barrier. The command queue allows
+    several producers. */
+typedef struct clm_shard
+{
+   /** Incoming response frames for the groups in the shard */
+   clm_shard_frame_t frames[CLM_SHARD_FRAME_QUEUE_SIZE];
+   uint32_t frame_write_count;
+   uint32_t frame_read_count;
+
+   /** Group events for all groups in the shard */
+   clm_group_event_t events[CLM_SHARD_EVENT_QUEUE_SIZE];
+   uint32_t event_write_count;
+   uint32_t event_read_count;
+
+   /** Frames and events dropped due to a full queue. Updated by the
+       producer. */
+   uint32_t queue_overflows;
+
+   /** Commands for the groups in the shard, from the application threads
+       and from clm_master_handle_commands() */
+   cl_command_queue_t command_queue;
+   clm_shard_command_t commands[CL_COMMAND_QUEUE_SIZE];
+
+   /** Running link scan timers for the groups in the shard */
+   cl_timer_heap_t timer_heap;
+
+   /** Outgoing request frames for the groups in the shard */
+   clm_send_queue_t send_queue;
+
+   /** Application callbacks from the groups in the shard */
+   clm_callback_queue_t callback_queue;
+
+   /** To avoid repeated error callbacks from the shard */
+   cl_limiter_t errorlimiter;
+
+   /** Master state requested by the groups in the shard. The master state
+       reported to the application is the lowest among the shards. */
+   clm_master_state_t master_state;
+
+   /** Number of master duplication alarms received by the shard, and the
+       number of them that have been forwarded to all groups (updated by
+       the producer). */
+   uint32_t masterdupl_alarm_count;
+   uint32_t masterdupl_alarm_handled;
+} clm_shard_t;
+
+typedef enum clm_slmp_request_type
+{
+   CLM_SLMP_REQUEST_NODE_SEARCH,
+   CLM_SLMP_REQUEST_SET_IP,
+} clm_slmp_request_type_t;
+
+/** SLMP request from the application, waiting to be handled by the thread
+    running the SLMP communication */
+typedef struct clm_slmp_request
+{
+   clm_slmp_request_type_t type;
+
+   /** Only used for CLM_SLMP_REQUEST_SET_IP */
+   cl_macaddr_t slave_mac_addr;
+   cl_ipaddr_t slave_new_ip_addr;
+   cl_ipaddr_t slave_new_netmask;
+} clm_slmp_request_t;
+
 /************************** Slave state machine ***************************/
 
 typedef struct cls_slave_fsm
@@ -707,7 +1080,7 @@ typedef struct clm_device_fsm
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
 } clm_device_fsm_t;
@@ -718,14 +1091,14 @@ typedef struct clm_device_fsm_entry_exit
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
    clm_device_event_t (*on_exit) (
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
 } clm_device_fsm_entry_exit_t;
@@ -739,7 +1112,7 @@ typedef struct clm_device_fsm_transition
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
 } clm_device_fsm_transition_t;
@@ -751,14 +1124,14 @@ typedef struct clm_device_fsm_on_entry_exit_table
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
    clm_device_event_t (*on_exit) (
       clm_t * clm,
       uint32_t now,
       clm_group_data_t * group_data,
-      clm_slave_device_data_t * slave_device_data,
+      clm_slave_device_hot_t * slave_device_data,
       clm_device_event_t event,
       clm_device_state_t new_state);
 } clm_device_fsm_on_entry_exit_table_t;
@@ -984,6 +1357,14 @@ CC_PACKED_END
 CC_STATIC_ASSERT (
    sizeof (cl_slmp_error_resp_t) == sizeof (cl_slmp_resp_header_t) + 9);
 
+/** Socket for sending SLMP frames. It is opened on first use, and is
+    kept open until the local IP address changes. */
+typedef struct cl_slmp_send_socket
+{
+   int handle;           /** Socket handle, or -1 if not open */
+   cl_ipaddr_t local_ip; /** IP address that the socket is bound to */
+} cl_slmp_send_socket_t;
+
 /*************************** Files ****************************************/
 
 CC_PACKED_BEGIN
@@ -1026,20 +1407,45 @@ struct cls
    uint32_t local_management_info;
    uint16_t slave_err_code;
 
+   /** Commands from application threads, executed by cls_handle_periodic().
+       See cls_submit_command(). */
+   cl_command_queue_t command_queue;
+   cls_command_t commands[CL_COMMAND_QUEUE_SIZE];
+
    /** Data area for incoming RY and RWw from master
        Note that the content is little-endian (copied directly from
        incoming frame). */
    cls_memory_area_t cyclic_data_area;
 
+   /** Changed RY bits and RWw registers per occupied station, accumulated
+       until read by the application */
+   uint64_t changed_ry[CLS_MAX_OCCUPIED_STATIONS];
+   uint32_t changed_rww[CLS_MAX_OCCUPIED_STATIONS];
+
    /* Receive and send buffers */
 
    int cciefb_socket;
-   int slmp_send_socket;
+
+   /** Socket profile in effect for the CCIEFB socket */
+   cl_socket_profile_t cciefb_socket_profile;
+   cl_slmp_send_socket_t slmp_send_socket;
    int slmp_receive_socket;
    uint8_t cciefb_receivebuf[CL_BUFFER_LEN];
    uint8_t slmp_receivebuf[CL_BUFFER_LEN];
    uint8_t slmp_sendbuf[CL_BUFFER_LEN];
 
+   /** Expected headers of cyclic requests, from the latest master */
+   cl_cciefb_header_template_t request_template;
+
+   /** Size of cyclic requests for the current station assignment, valid in
+       state CLS_SLAVE_STATE_MASTER_CONTROL. Together with \a master_id,
+       \a parameter_no and \a group_no in \a master it decides whether
+       an incoming request can reuse \a master.slave_station_no. */
+   size_t expected_request_size;
+
+   /** Statistics for incoming CCIEFB frames */
+   cls_cciefb_receive_statistics_t cciefb_receive_statistics;
+
    /** Frame for CCIEFB normal responses. Holds outgoing RX and RWr data.
        Note that the cyclic data is little-endian. */
    uint8_t cciefb_sendbuf_normal[CL_BUFFER_LEN];
@@ -1140,9 +1546,27 @@ struct clm
    /** Node search database */
    clm_node_search_db_t node_search_db;
 
+   /** SLMP requests from the application. Only used if
+       \a use_separate_slmp_thread is enabled. Several producers (the
+       application threads, and clm_handle_periodic() for submitted
+       commands) and a single consumer (the SLMP thread), without locks. */
+   cl_command_queue_t slmp_request_queue;
+   clm_slmp_request_t slmp_requests[CL_COMMAND_QUEUE_SIZE];
+
+   /** Commands from application threads, executed by clm_handle_periodic().
+       See clm_submit_command(). */
+   cl_command_queue_t command_queue;
+   clm_command_t commands[CL_COMMAND_QUEUE_SIZE];
+
    /** Group runtime data */
    clm_group_data_t groups[CLM_MAX_GROUPS];
 
+   /** Slave devices by IP address, open addressed with linear probing */
+   clm_slave_index_entry_t slave_index[CLM_SLAVE_INDEX_SIZE];
+
+   /** Running state machine timers, with the earliest deadline first */
+   cl_timer_heap_t timer_heap;
+
    /** To avoid repeated error callbacks for the same messagetype */
    cl_limiter_t errorlimiter;
 
@@ -1150,9 +1574,36 @@ struct clm
 
    int cciefb_socket;
    int cciefb_arbitration_socket;
-   int slmp_send_socket;
+
+   /** Socket profiles in effect for the CCIEFB sockets */
+   cl_socket_profile_t cciefb_socket_profile;
+   cl_socket_profile_t arbitration_socket_profile;
+
+   /** Frames dropped by the operating system, per CCIEFB socket */
+   clm_socket_statistics_t cciefb_socket_statistics;
+   clm_socket_statistics_t arbitration_socket_statistics;
+   cl_slmp_send_socket_t slmp_send_socket;
    int slmp_receive_socket;
-   uint8_t cciefb_receivebuf[CL_BUFFER_LEN];
+
+   /** CCIEFB receive buffers, one for each frame in a batch receive */
+   uint8_t cciefb_receivebufs[CLM_CCIEFB_RECEIVE_BATCH_SIZE][CL_BUFFER_LEN];
+   clal_udp_message_t cciefb_receive_messages[CLM_CCIEFB_RECEIVE_BATCH_SIZE];
+
+   /** Outgoing CCIEFB request frames, waiting to be sent in one batch */
+   clm_send_queue_t cciefb_send_queue;
+
+   /** Number of datagrams sent on the CCIEFB socket since it was opened.
+       Used to match transmission timestamps to the groups. */
+   uint32_t cciefb_datagrams_sent;
+
+   /** Application callbacks, waiting to be delivered on the application
+       thread. Only used if \a use_async_callbacks is enabled. */
+   clm_callback_queue_t callback_queue;
+
+   /** Shards running the groups in separate threads. Only used if
+       \a number_of_shards in the configuration is larger than 1. */
+   clm_shard_t shards[CLM_MAX_SHARDS];
+
    uint8_t slmp_receivebuf[CL_BUFFER_LEN];
    uint8_t slmp_sendbuf[CL_BUFFER_LEN];
 };
@@ -113,6 +113,112 @@ bool cl_utils_is_ipaddr_range_valid (cl_ipaddr_t ip_addr)
    return true;
 }
 
+bool cl_utils_is_socket_profile_valid (const cl_socket_profile_t * profile)
+{
+   if (profile->priority > CL_SOCKET_PRIORITY_MAX)
+   {
+      return false;
+   }
+
+   if (profile->dscp > CL_SOCKET_DSCP_MAX)
+   {
+      return false;
+   }
+
+   return true;
+}
+
+void cl_util_socket_profile_from_clal (
+   const clal_socket_profile_t * applied,
+   bool for_burst,
+   cl_socket_profile_t * profile)
+{
+   clal_clear_memory (profile, sizeof (*profile));
+   profile->busy_poll_us             = applied->busy_poll_us;
+   profile->receive_buffer_size      = applied->receive_buffer_size;
+   profile->receive_buffer_for_burst = for_burst;
+   profile->priority                 = applied->priority;
+   profile->dscp                     = applied->dscp;
+   profile->enable_error_queue       = applied->enable_error_queue;
+}
+
+/* The areas are compared 8 bytes at a time, so they must be whole
+   multiples of 8 bytes. Then there is no byte tail to handle. */
+CC_STATIC_ASSERT (CL_BYTES_PER_BITAREA == sizeof (uint64_t));
+CC_STATIC_ASSERT ((CL_WORDSIGNALS_PER_AREA * 2) % sizeof (uint64_t) == 0);
+
+/**
+ * Calculate the difference between 8 bytes in two areas, as a little
+ * endian value.
+ *
+ * The areas might be unaligned in a frame buffer, so the bytes are copied
+ * to aligned variables before the XOR. The copy is typically compiled to
+ * a single load.
+ *
+ * @param previous      Previous area
+ * @param next          Next area. NULL is interpreted as all zeros.
+ * @param offset        Offset in bytes from the start of the areas
+ * @return XOR of the 8 bytes. Byte n of the areas is in bits 8n..8n+7.
+ */
+static uint64_t cl_util_calc_difference (
+   const uint8_t * previous,
+   const uint8_t * next,
+   size_t offset)
+{
+   uint64_t previous_value = 0;
+   uint64_t next_value     = 0;
+
+   clal_memcpy (
+      &previous_value,
+      sizeof (previous_value),
+      &previous[offset],
+      sizeof (previous_value));
+   if (next != NULL)
+   {
+      clal_memcpy (
+         &next_value,
+         sizeof (next_value),
+         &next[offset],
+         sizeof (next_value));
+   }
+
+   return CC_FROM_LE64 (previous_value ^ next_value);
+}
+
+uint64_t cl_util_calc_changed_bits (
+   const uint8_t * previous,
+   const uint8_t * next)
+{
+   return cl_util_calc_difference (previous, next, 0);
+}
+
+uint32_t cl_util_calc_changed_words (
+   const uint8_t * previous,
+   const uint8_t * next)
+{
+   uint32_t changed = 0;
+   uint64_t difference;
+   size_t offset;
+   uint16_t i;
+
+   for (offset = 0; offset < CL_WORDSIGNALS_PER_AREA * 2U;
+        offset += sizeof (difference))
+   {
+      difference = cl_util_calc_difference (previous, next, offset);
+
+      /* Four registers per 8 bytes, one bit per register */
+      for (i = 0; i < 4; i++)
+      {
+         if (((difference >> (16U * i)) & 0xFFFFU) != 0)
+         {
+            changed |= (uint32_t)1U << (offset / 2U + i);
+         }
+      }
+   }
+
+   return changed;
+}
+
 void cl_util_buffer_show (const uint8_t * data, int size, int indent_size)
 {
    int i;
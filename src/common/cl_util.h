@@ -82,6 +82,59 @@ bool cl_utils_is_netmask_valid (cl_ipaddr_t netmask);
  */
 bool cl_utils_is_ipaddr_range_valid (cl_ipaddr_t ip_addr);
 
+/**
+ * Validate the values in a socket profile
+ *
+ * Priority is allowed 0..CL_SOCKET_PRIORITY_MAX and DSCP is allowed
+ * 0..CL_SOCKET_DSCP_MAX.
+ *
+ * @param profile          Socket profile to be validated
+ * @return true if the socket profile is valid, and false if not
+ */
+bool cl_utils_is_socket_profile_valid (const cl_socket_profile_t * profile);
+
+/**
+ * Convert the socket settings in effect, as reported by the port, to a
+ * socket profile.
+ *
+ * @param applied          Settings in effect, from clal_udp_set_profile()
+ * @param for_burst        Whether the receive buffer was sized for burst
+ * @param profile          Resulting socket profile
+ */
+void cl_util_socket_profile_from_clal (
+   const clal_socket_profile_t * applied,
+   bool for_burst,
+   cl_socket_profile_t * profile);
+
+/**
+ * Calculate which bit signals differ between two bit areas (RX or RY)
+ *
+ * Uses a single 64-bit XOR, as the area is 8 bytes.
+ *
+ * @param previous      Previous area, CL_BYTES_PER_BITAREA bytes
+ * @param next          Next area, CL_BYTES_PER_BITAREA bytes. NULL is
+ *                      interpreted as all zeros.
+ * @return Mask where bit n is set if bit signal n differs
+ */
+uint64_t cl_util_calc_changed_bits (
+   const uint8_t * previous,
+   const uint8_t * next);
+
+/**
+ * Calculate which registers differ between two word areas (RWr or RWw)
+ *
+ * The areas are compared with 64-bit XOR, four registers at a time. They
+ * might be unaligned in a frame buffer.
+ *
+ * @param previous      Previous area, 2 * CL_WORDSIGNALS_PER_AREA bytes
+ * @param next          Next area, 2 * CL_WORDSIGNALS_PER_AREA bytes. NULL is
+ *                      interpreted as all zeros.
+ * @return Mask where bit n is set if register n differs
+ */
+uint32_t cl_util_calc_changed_words (
+   const uint8_t * previous,
+   const uint8_t * next);
+
 /**
  * Display buffer contents
  *
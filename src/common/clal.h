@@ -21,6 +21,7 @@ extern "C" {
 
 #include "clal_sys.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /** Incl termination. The interface name is used for logs, and
@@ -70,6 +71,38 @@ void clal_clear_memory (void * dest, size_t n);
  */
 void clal_memcpy (void * dest, size_t dest_size, const void * src, size_t n);
 
+/**
+ * Full memory barrier
+ *
+ * Memory accesses before the barrier are completed before any memory access
+ * after the barrier, as seen from other CPU cores. Also prevents the compiler
+ * from reordering memory accesses across the barrier.
+ *
+ * Used for sharing data between the stack and application threads without
+ * locks, for example \a clm_get_group_input_snapshot().
+ */
+void clal_memory_barrier (void);
+
+/**
+ * Atomically compare and swap a value
+ *
+ * Sets \a value to \a desired if it equals \a expected, as a single atomic
+ * operation. Acts as a full memory barrier.
+ *
+ * Used by the command queues, where several application threads can add
+ * commands without locks.
+ *
+ * @param value         Value to be updated
+ * @param expected      Expected current value
+ * @param desired       New value
+ * @return true if the value was updated, false if it did not equal
+ *         \a expected
+ */
+bool clal_compare_and_swap (
+   volatile uint32_t * value,
+   uint32_t expected,
+   uint32_t desired);
+
 /**
  * Copy a string
  *
@@ -200,7 +233,9 @@ int clal_get_mac_address (int ifindex, uint8_t (*mac_address)[6]);
 /**
  * Open an UDP socket
  *
- * It should enable reuseaddr, broadcast and packetinfo
+ * It should enable reuseaddr, broadcast and packetinfo. If supported, it
+ * should also enable reporting of dropped datagrams (SO_RXQ_OVFL on Linux),
+ * see \a clal_udp_recvfrom_batch().
  *
  * @param ip               IP address to listen on
  * @param port             UDP port to listen on
@@ -271,6 +306,224 @@ ssize_t clal_udp_recvfrom_with_ifindex (
    void * data,
    size_t size);
 
+/** One UDP datagram in a batch receive or batch send.
+    See \a clal_udp_recvfrom_batch() and \a clal_udp_sendto_batch() */
+typedef struct clal_udp_message
+{
+   /** Buffer for received data, or data to be sent */
+   void * data;
+
+   /** Size of buffer for received data. Not used when sending. */
+   size_t size;
+
+   /** Resulting number of bytes received, or number of bytes to send */
+   size_t len;
+
+   /** Resulting source (remote) IP address, or destination IP address */
+   uint32_t remote_ip;
+
+   /** Resulting source (remote) UDP port, or destination UDP port */
+   uint16_t remote_port;
+
+   /** Resulting destination (local) IP address of a received datagram,
+       or 0 if not available. Not used when sending. */
+   uint32_t local_ip;
+
+   /** Resulting timestamp in microseconds when the datagram was received,
+       using the same clock as os_get_current_time_us(). Only valid if
+       \a timestamp_valid is true. Not used when sending, see
+       clal_udp_read_error_queue(). */
+   uint32_t timestamp_us;
+
+   /** Resulting flag, true if the port provides \a timestamp_us */
+   bool timestamp_valid;
+
+   /** Resulting cumulative number of datagrams dropped by the operating
+       system on this socket since it was opened, as reported with the
+       received datagram. Only valid if \a drop_count_valid is true.
+       Not used when sending. */
+   uint32_t drop_count;
+
+   /** Resulting flag, true if the port provides \a drop_count */
+   bool drop_count_valid;
+} clal_udp_message_t;
+
+/**
+ * Receive several UDP datagrams in one call.
+ *
+ * This is a nonblocking function, and it returns 0 immediately if no
+ * data is available. Otherwise it fills in up to \a num_messages entries
+ * from the start of \a messages, without waiting for more data to arrive.
+ *
+ * Ports with support for it (for example Linux and recvmmsg()) should
+ * fetch the datagrams in a single system call. Other ports can implement
+ * this by calling \a clal_udp_recvfrom() repeatedly until no more data is
+ * available or the array is full.
+ *
+ * Ports that can timestamp incoming datagrams (for example Linux with
+ * SO_TIMESTAMPING) should report the reception time in \a timestamp_us,
+ * as this gives more accurate response time statistics. Otherwise
+ * \a timestamp_valid is set to false.
+ *
+ * Ports should report the destination IP address of each datagram in
+ * \a local_ip (for example using IP_PKTINFO on Linux). This is needed
+ * for sockets bound to all interfaces.
+ *
+ * Ports that can tell how many datagrams the operating system has dropped
+ * on the socket (for example Linux with SO_RXQ_OVFL) should report the
+ * counter in \a drop_count. Otherwise \a drop_count_valid is set to false.
+ *
+ * Only used for CC-Link master stack.
+ *
+ * @param handle           Socket handle
+ * @param messages         Array of messages. The \a data and \a size fields
+ *                         must be set by the caller. The \a len,
+ *                         \a remote_ip, \a remote_port, \a local_ip,
+ *                         \a timestamp_us, \a timestamp_valid,
+ *                         \a drop_count and \a drop_count_valid fields
+ *                         are set for the received datagrams.
+ * @param num_messages     Number of elements in \a messages
+ * @return the number of datagrams received, or -1 if an error occurred.
+ */
+int clal_udp_recvfrom_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages);
+
+/**
+ * Send several UDP datagrams in one call.
+ *
+ * The datagrams are sent in the order given in \a messages.
+ *
+ * Ports with support for it (for example Linux with sendmmsg() or
+ * io_uring) should hand over all datagrams to the operating system in a
+ * single system call. Other ports can implement this by calling
+ * \a clal_udp_sendto() for each message.
+ *
+ * The transmission time is not known when this function returns. Ports
+ * that can timestamp outgoing datagrams report it later, see
+ * clal_udp_read_error_queue().
+ *
+ * A datagram counts as sent only if all of its \a len bytes were sent.
+ *
+ * Only used for CC-Link master stack.
+ *
+ * @param handle           Socket handle
+ * @param messages         Array of messages. The \a data, \a len,
+ *                         \a remote_ip and \a remote_port fields
+ *                         must be set by the caller.
+ * @param num_messages     Number of elements in \a messages
+ * @return the number of datagrams sent, or -1 if an error occurred before
+ *         any datagram was sent.
+ */
+int clal_udp_sendto_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages);
+
+typedef enum clal_udp_error_queue_type
+{
+   /** Transmission timestamp of a sent datagram */
+   CLAL_UDP_ERROR_QUEUE_TX_TIMESTAMP,
+
+   /** ICMP error for a sent datagram, for example port unreachable */
+   CLAL_UDP_ERROR_QUEUE_ICMP_ERROR,
+} clal_udp_error_queue_type_t;
+
+/** Entry read from the error queue of a socket */
+typedef struct clal_udp_error_queue_entry
+{
+   clal_udp_error_queue_type_t type;
+
+   /** Number of the sent datagram. The datagrams sent by
+       clal_udp_sendto_batch() are numbered per socket, from 0 for the
+       first datagram after the socket was opened. */
+   uint32_t id;
+
+   /** Timestamp in microseconds when the datagram was sent, using the same
+       clock as os_get_current_time_us(). Only for
+       CLAL_UDP_ERROR_QUEUE_TX_TIMESTAMP. */
+   uint32_t timestamp_us;
+
+   /** Error number (errno value on Linux). Only for
+       CLAL_UDP_ERROR_QUEUE_ICMP_ERROR. */
+   int error;
+
+   /** IP address of the node reporting the error. Only for
+       CLAL_UDP_ERROR_QUEUE_ICMP_ERROR. */
+   uint32_t offender_ip;
+} clal_udp_error_queue_entry_t;
+
+/**
+ * Read entries from the error queue of a socket.
+ *
+ * This is a nonblocking function, and it returns 0 immediately if the
+ * queue is empty.
+ *
+ * Ports that can timestamp outgoing datagrams (for example Linux with
+ * SO_TIMESTAMPING and SOF_TIMESTAMPING_OPT_ID, where the timestamps are
+ * read with MSG_ERRQUEUE) report the transmission times here, once the
+ * datagrams have been sent. If \a enable_error_queue was set by
+ * clal_udp_set_profile(), also the ICMP errors for the socket are reported
+ * (IP_RECVERR on Linux). Other ports return 0.
+ *
+ * Entries must be read until the queue is empty, as the operating system
+ * might stop queueing new entries when the queue is full.
+ *
+ * @param handle           Socket handle
+ * @param entries          Resulting entries
+ * @param num_entries      Number of elements in \a entries
+ * @return the number of entries read, or -1 if an error occurred.
+ */
+int clal_udp_read_error_queue (
+   int handle,
+   clal_udp_error_queue_entry_t * entries,
+   size_t num_entries);
+
+/** Socket settings for low-latency cyclic traffic.
+    See \a clal_udp_set_profile() */
+typedef struct clal_socket_profile
+{
+   /** Busy poll time in microseconds when receiving, or 0 */
+   uint32_t busy_poll_us;
+
+   /** Receive buffer size in bytes, or 0 */
+   uint32_t receive_buffer_size;
+
+   /** Socket priority for outgoing frames, or 0 */
+   uint8_t priority;
+
+   /** DSCP value for outgoing frames, or 0 */
+   uint8_t dscp;
+
+   /** Queue ICMP errors on the socket, to be read by
+       clal_udp_read_error_queue() */
+   bool enable_error_queue;
+} clal_socket_profile_t;
+
+/**
+ * Apply a socket profile to an UDP socket, for low-latency cyclic traffic.
+ *
+ * Fields that are zero in \a profile should leave the operating
+ * system setting unchanged. On Linux the profile corresponds to
+ * SO_BUSY_POLL, SO_RCVBUF, SO_PRIORITY, IP_TOS (DSCP) and IP_RECVERR.
+ *
+ * The settings actually in effect are reported in \a applied. Settings
+ * that are not supported by the port, or that the operating system
+ * rejected, are reported as zero. The receive buffer size should be
+ * reported as the value read back from the operating system.
+ *
+ * @param handle           Socket handle
+ * @param profile          Socket profile to apply
+ * @param applied          Resulting settings in effect
+ * @return 0 if all requested settings were applied, or -1 if any of them
+ *         failed.
+ */
+int clal_udp_set_profile (
+   int handle,
+   const clal_socket_profile_t * profile,
+   clal_socket_profile_t * applied);
+
 /**
  * Close an UDP socket
  *
@@ -82,10 +82,154 @@ void clm_handle_periodic (clm_t * clm)
 
    CC_ASSERT (clm != NULL);
 
-   clm_slmp_periodic (clm, now);
+   clm_master_handle_commands (clm, now);
+   if (!clm->config.use_separate_slmp_thread)
+   {
+      clm_slmp_periodic (clm, now);
+   }
    clm_iefb_periodic (clm, now);
 }
 
+int clm_handle_slmp_periodic (clm_t * clm)
+{
+   uint32_t now = os_get_current_time_us();
+
+   if (clm == NULL || !clm->config.use_separate_slmp_thread)
+   {
+      return -1;
+   }
+
+   clm_slmp_handle_queued_requests (clm, now);
+   clm_slmp_periodic (clm, now);
+
+   return 0;
+}
+
+int clm_dispatch_callbacks (clm_t * clm)
+{
+   if (clm == NULL || !clm->config.use_async_callbacks)
+   {
+      return -1;
+   }
+
+   return clm_iefb_dispatch_callbacks (clm);
+}
+
+int clm_get_next_deadline_us (clm_t * clm, uint32_t * time_to_deadline)
+{
+   uint32_t now      = os_get_current_time_us();
+   bool found        = false;
+   uint32_t earliest = 0;
+
+   if (clm == NULL || time_to_deadline == NULL)
+   {
+      return -1;
+   }
+
+   if (!clm->config.use_separate_slmp_thread)
+   {
+      clm_slmp_update_next_deadline (clm, now, &found, &earliest);
+   }
+   clm_iefb_update_next_deadline (clm, now, &found, &earliest);
+   if (!found)
+   {
+      return -1;
+   }
+
+   *time_to_deadline = earliest;
+   return 0;
+}
+
+int clm_handle_shard_periodic (clm_t * clm, uint16_t shard_index)
+{
+   uint32_t now = os_get_current_time_us();
+
+   if (
+      clm == NULL || clm->config.number_of_shards < 2 ||
+      shard_index >= clm->config.number_of_shards)
+   {
+      return -1;
+   }
+
+   clm_iefb_shard_periodic (clm, shard_index, now);
+
+   return 0;
+}
+
+int clm_get_shard_next_deadline_us (
+   clm_t * clm,
+   uint16_t shard_index,
+   uint32_t * time_to_deadline)
+{
+   uint32_t now      = os_get_current_time_us();
+   bool found        = false;
+   uint32_t earliest = 0;
+
+   if (
+      clm == NULL || time_to_deadline == NULL ||
+      clm->config.number_of_shards < 2 ||
+      shard_index >= clm->config.number_of_shards)
+   {
+      return -1;
+   }
+
+   clm_iefb_update_shard_next_deadline (
+      clm,
+      shard_index,
+      now,
+      &found,
+      &earliest);
+   if (!found)
+   {
+      return -1;
+   }
+
+   *time_to_deadline = earliest;
+   return 0;
+}
+
+int clm_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   uint16_t count = 0;
+
+   if (clm == NULL || sockets == NULL || number_of_sockets == NULL)
+   {
+      return -1;
+   }
+
+   if (
+      clm_iefb_get_sockets (clm, sockets, max_sockets, &count) != 0 ||
+      clm_slmp_get_sockets (clm, sockets, max_sockets, &count) != 0)
+   {
+      return -1;
+   }
+
+   *number_of_sockets = count;
+   return 0;
+}
+
+void clm_handle_cciefb_readable (clm_t * clm)
+{
+   uint32_t now = os_get_current_time_us();
+
+   CC_ASSERT (clm != NULL);
+
+   clm_iefb_handle_readable (clm, now);
+}
+
+void clm_handle_slmp_readable (clm_t * clm)
+{
+   uint32_t now = os_get_current_time_us();
+
+   CC_ASSERT (clm != NULL);
+
+   clm_slmp_handle_readable (clm, now);
+}
+
 void clm_set_master_application_status (clm_t * clm, bool running, bool stopped_by_user)
 {
    CC_ASSERT (clm != NULL);
@@ -106,8 +250,19 @@ int clm_set_slave_communication_status (
    uint16_t slave_device_index,
    bool enabled)
 {
+   clm_command_t command = {0};
+
    CC_ASSERT (clm != NULL);
 
+   if (clm->config.number_of_shards > 1)
+   {
+      command.type               = CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS;
+      command.group_index        = group_index;
+      command.slave_device_index = slave_device_index;
+      command.enabled            = enabled;
+      return clm_iefb_queue_shard_command (clm, &command, false);
+   }
+
    return clm_iefb_set_slave_communication_status (
       clm,
       group_index,
@@ -121,8 +276,19 @@ int clm_force_cyclic_transmission_bit (
    uint16_t slave_device_index,
    bool force)
 {
+   clm_command_t command = {0};
+
    CC_ASSERT (clm != NULL);
 
+   if (clm->config.number_of_shards > 1)
+   {
+      command.type               = CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT;
+      command.group_index        = group_index;
+      command.slave_device_index = slave_device_index;
+      command.force              = force;
+      return clm_iefb_queue_shard_command (clm, &command, false);
+   }
+
    return clm_iefb_force_cyclic_transmission_bit (
       clm,
       group_index,
@@ -161,7 +327,7 @@ int clm_get_group_status (
 }
 
 const clm_slave_device_data_t * clm_get_device_connection_details (
-   const clm_t * clm,
+   clm_t * clm,
    uint16_t group_index,
    uint16_t slave_device_index)
 {
@@ -176,12 +342,35 @@ const clm_slave_device_data_t * clm_get_device_connection_details (
       slave_device_index);
 }
 
+int clm_get_device_connection_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_slave_device_data_t * details)
+{
+   if (clm == NULL || details == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_device_connection_snapshot (
+      clm,
+      group_index,
+      slave_device_index,
+      details);
+}
+
 int clm_perform_node_search (clm_t * clm)
 {
    uint32_t now = os_get_current_time_us();
 
    CC_ASSERT (clm != NULL);
 
+   if (clm->config.use_separate_slmp_thread)
+   {
+      return clm_slmp_queue_node_search (clm);
+   }
+
    return clm_slmp_perform_node_search (clm, now);
 }
 
@@ -202,6 +391,15 @@ int clm_set_slave_ipaddr (
 
    CC_ASSERT (clm != NULL);
 
+   if (clm->config.use_separate_slmp_thread)
+   {
+      return clm_slmp_queue_set_ipaddr_request (
+         clm,
+         slave_mac_addr,
+         slave_new_ip_addr,
+         slave_new_netmask);
+   }
+
    return clm_slmp_perform_set_ipaddr_request (
       clm,
       now,
@@ -210,6 +408,16 @@ int clm_set_slave_ipaddr (
       slave_new_netmask);
 }
 
+int clm_submit_command (clm_t * clm, const clm_command_t * command)
+{
+   if (clm == NULL || command == NULL)
+   {
+      return -1;
+   }
+
+   return clm_master_submit_command (clm, command);
+}
+
 const cl_rx_t * clm_get_first_rx_area (
    clm_t * clm,
    uint16_t group_index,
@@ -229,13 +437,22 @@ cl_ry_t * clm_get_first_ry_area (
    uint16_t group_index,
    uint16_t * total_occupied)
 {
+   cl_ry_t * area;
+
    if (clm == NULL)
    {
       *total_occupied = 0;
       return NULL;
    }
 
-   return clm_iefb_get_first_ry_area (clm, group_index, total_occupied);
+   /* The application might write via the pointer */
+   area = clm_iefb_get_first_ry_area (clm, group_index, total_occupied);
+   if (area != NULL)
+   {
+      (void)clm_iefb_mark_outputs_dirty (clm, group_index, 0, *total_occupied);
+   }
+
+   return area;
 }
 
 const cl_rwr_t * clm_get_first_rwr_area (
@@ -257,13 +474,22 @@ cl_rww_t * clm_get_first_rww_area (
    uint16_t group_index,
    uint16_t * total_occupied)
 {
+   cl_rww_t * area;
+
    if (clm == NULL)
    {
       *total_occupied = 0;
       return NULL;
    }
 
-   return clm_iefb_get_first_rww_area (clm, group_index, total_occupied);
+   /* The application might write via the pointer */
+   area = clm_iefb_get_first_rww_area (clm, group_index, total_occupied);
+   if (area != NULL)
+   {
+      (void)clm_iefb_mark_outputs_dirty (clm, group_index, 0, *total_occupied);
+   }
+
+   return area;
 }
 
 const cl_rx_t * clm_get_first_device_rx_area (
@@ -291,17 +517,34 @@ cl_ry_t * clm_get_first_device_ry_area (
    uint16_t slave_device_index,
    uint16_t * num_occupied_stations)
 {
+   const cl_ry_t * first_group_area;
+   cl_ry_t * area;
+   uint16_t total_occupied = 0;
+
    if (clm == NULL)
    {
       *num_occupied_stations = 0;
       return NULL;
    }
 
-   return clm_iefb_get_first_device_ry_area (
+   /* The application might write via the pointer */
+   area = clm_iefb_get_first_device_ry_area (
       clm,
       group_index,
       slave_device_index,
       num_occupied_stations);
+   if (area != NULL)
+   {
+      first_group_area =
+         clm_iefb_get_first_ry_area (clm, group_index, &total_occupied);
+      (void)clm_iefb_mark_outputs_dirty (
+         clm,
+         group_index,
+         (uint16_t)(area - first_group_area),
+         *num_occupied_stations);
+   }
+
+   return area;
 }
 
 const cl_rwr_t * clm_get_first_device_rwr_area (
@@ -329,17 +572,107 @@ cl_rww_t * clm_get_first_device_rww_area (
    uint16_t slave_device_index,
    uint16_t * num_occupied_stations)
 {
+   const cl_rww_t * first_group_area;
+   cl_rww_t * area;
+   uint16_t total_occupied = 0;
+
    if (clm == NULL)
    {
       *num_occupied_stations = 0;
       return NULL;
    }
 
-   return clm_iefb_get_first_device_rww_area (
+   /* The application might write via the pointer */
+   area = clm_iefb_get_first_device_rww_area (
       clm,
       group_index,
       slave_device_index,
       num_occupied_stations);
+   if (area != NULL)
+   {
+      first_group_area =
+         clm_iefb_get_first_rww_area (clm, group_index, &total_occupied);
+      (void)clm_iefb_mark_outputs_dirty (
+         clm,
+         group_index,
+         (uint16_t)(area - first_group_area),
+         *num_occupied_stations);
+   }
+
+   return area;
+}
+
+int clm_publish_outputs (clm_t * clm, uint16_t group_index)
+{
+   if (clm == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_publish_outputs (clm, group_index);
+}
+
+int clm_mark_outputs_dirty (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t first_area,
+   uint16_t num_areas)
+{
+   if (clm == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_mark_outputs_dirty (clm, group_index, first_area, num_areas);
+}
+
+int clm_get_group_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   clm_input_snapshot_t * snapshot)
+{
+   if (clm == NULL || snapshot == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_group_input_snapshot (clm, group_index, snapshot);
+}
+
+int clm_get_device_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_input_snapshot_t * snapshot)
+{
+   if (clm == NULL || snapshot == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_device_input_snapshot (
+      clm,
+      group_index,
+      slave_device_index,
+      snapshot);
+}
+
+int clm_get_changed_inputs (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   cl_changed_signals_t * changed)
+{
+   if (clm == NULL || changed == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_changed_inputs (
+      clm,
+      group_index,
+      slave_device_index,
+      changed);
 }
 
 bool clm_get_rx_bit (
@@ -409,3 +742,91 @@ uint16_t clm_get_rww_value (
 
    return clm_iefb_get_rww_value (clm, group_index, slave_device_index, number);
 }
+
+int clm_get_rx_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values)
+{
+   if (clm == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_rx_bits (
+      clm,
+      group_index,
+      slave_device_index,
+      first_number,
+      num_bits,
+      values);
+}
+
+int clm_set_ry_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values)
+{
+   if (clm == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_set_ry_bits (
+      clm,
+      group_index,
+      slave_device_index,
+      first_number,
+      num_bits,
+      values);
+}
+
+int clm_get_rwr_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values)
+{
+   if (clm == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_get_rwr_values (
+      clm,
+      group_index,
+      slave_device_index,
+      first_number,
+      num_values,
+      values);
+}
+
+int clm_set_rww_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values)
+{
+   if (clm == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return clm_iefb_set_rww_values (
+      clm,
+      group_index,
+      slave_device_index,
+      first_number,
+      num_values,
+      values);
+}
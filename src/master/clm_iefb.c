@@ -21,8 +21,10 @@
 
 #ifdef UNIT_TEST
 #define clal_udp_open              mock_clal_udp_open
-#define clal_udp_recvfrom          mock_clal_udp_recvfrom
-#define clal_udp_sendto            mock_clal_udp_sendto
+#define clal_udp_recvfrom_batch    mock_clal_udp_recvfrom_batch
+#define clal_udp_sendto_batch      mock_clal_udp_sendto_batch
+#define clal_udp_read_error_queue  mock_clal_udp_read_error_queue
+#define clal_udp_set_profile       mock_clal_udp_set_profile
 #define clal_udp_close             mock_clal_udp_close
 #define clal_get_unix_timestamp_ms mock_clal_get_unix_timestamp_ms
 #endif
@@ -188,6 +190,149 @@ int clm_iefb_calc_slave_device_index (
    return -1;
 }
 
+/**
+ * Calculate the first slot to probe in the slave lookup index
+ *
+ * Uses the upper half of a multiplicative hash, so that addresses differing
+ * only in the last octet are spread over the table.
+ *
+ * @param ip_addr                Slave IP address
+ * @return slot index, 0 .. CLM_SLAVE_INDEX_SIZE - 1
+ */
+static uint16_t clm_iefb_calc_slave_index_slot (cl_ipaddr_t ip_addr)
+{
+   uint32_t hash = (uint32_t)(ip_addr * 0x9E3779B1UL);
+
+   return (uint16_t)((hash >> 16) & (CLM_SLAVE_INDEX_SIZE - 1));
+}
+
+/**
+ * Build the slave lookup index from the configured hierarchy
+ *
+ * Stores group index and device index for each slave device, with the IP
+ * address as key. Must be called whenever the configuration has been
+ * updated.
+ *
+ * Slave IP addresses are unique, see clm_validate_config_duplicates().
+ *
+ * @param clm                    c-link master stack instance handle
+ */
+void clm_iefb_build_slave_index (clm_t * clm)
+{
+   uint16_t group_index        = 0;
+   uint16_t slave_device_index = 0;
+   uint16_t slot               = 0;
+   uint16_t probes             = 0;
+   const clm_group_setting_t * group_setting;
+   const clm_slave_device_setting_t * slave_device_setting;
+   clm_slave_index_entry_t * entry;
+
+   clal_clear_memory (&clm->slave_index, sizeof (clm->slave_index));
+
+   for (group_index = 0; group_index < clm->config.hier.number_of_groups;
+        group_index++)
+   {
+      group_setting = &clm->config.hier.groups[group_index];
+
+      for (slave_device_index = 0;
+           slave_device_index < group_setting->num_slave_devices;
+           slave_device_index++)
+      {
+         slave_device_setting =
+            &group_setting->slave_devices[slave_device_index];
+         slot = clm_iefb_calc_slave_index_slot (slave_device_setting->slave_id);
+
+         for (probes = 0; probes < CLM_SLAVE_INDEX_SIZE; probes++)
+         {
+            if (clm->slave_index[slot].slave_id == CL_IPADDR_INVALID)
+            {
+               break;
+            }
+            slot = (slot + 1) & (CLM_SLAVE_INDEX_SIZE - 1);
+         }
+         CC_ASSERT (probes < CLM_SLAVE_INDEX_SIZE);
+
+         entry               = &clm->slave_index[slot];
+         entry->slave_id     = slave_device_setting->slave_id;
+         entry->group_index  = group_index;
+         entry->device_index = slave_device_index;
+      }
+   }
+}
+
+/**
+ * Find a slave device in the slave lookup index
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param ip_addr                Slave IP address
+ * @return the index entry, or NULL if the IP address not is found
+ */
+const clm_slave_index_entry_t * clm_iefb_find_slave (
+   const clm_t * clm,
+   cl_ipaddr_t ip_addr)
+{
+   uint16_t slot   = 0;
+   uint16_t probes = 0;
+   const clm_slave_index_entry_t * entry;
+
+   if (ip_addr == CL_IPADDR_INVALID)
+   {
+      return NULL;
+   }
+
+   slot = clm_iefb_calc_slave_index_slot (ip_addr);
+   for (probes = 0; probes < CLM_SLAVE_INDEX_SIZE; probes++)
+   {
+      entry = &clm->slave_index[slot];
+      if (entry->slave_id == ip_addr)
+      {
+         return entry;
+      }
+      if (entry->slave_id == CL_IPADDR_INVALID)
+      {
+         return NULL;
+      }
+      slot = (slot + 1) & (CLM_SLAVE_INDEX_SIZE - 1);
+   }
+
+   return NULL;
+}
+
+/**
+ * Find the header template for an incoming response frame, from the group
+ * number in the frame.
+ *
+ * The frame is not yet validated.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param buffer                 Incoming response frame
+ * @param recv_len               UDP payload length
+ * @return the template of the group, or NULL if the group number is invalid
+ */
+static cl_cciefb_header_template_t * clm_iefb_find_response_template (
+   clm_t * clm,
+   const uint8_t * buffer,
+   size_t recv_len)
+{
+   uint16_t group_no = 0;
+
+   if (recv_len < sizeof (cl_cciefb_cyclic_resp_full_headers_t))
+   {
+      return NULL;
+   }
+
+   group_no = ((const cl_cciefb_cyclic_resp_full_headers_t *)buffer)
+                 ->cyclic_data_header.group_no;
+   if (
+      group_no < CL_CCIEFB_MIN_GROUP_NO ||
+      group_no > clm->config.hier.number_of_groups)
+   {
+      return NULL;
+   }
+
+   return &clm->groups[group_no - 1].response_template;
+}
+
 /**
  * Check if we received responses from all (enabled) slave devices in the group
  *
@@ -213,7 +358,10 @@ int clm_iefb_calc_slave_device_index (
  * Note that the slave_device_data->enabled field affects which transitions
  * should occur, but does not affect the checks in this function.
  *
- * @param group_setting    Group setting
+ * The devices to wait for are tracked in \a awaiting_responses in the group
+ * data, see clm_iefb_update_awaiting_responses(). This function is thereby
+ * independent of the number of slave devices.
+ *
  * @param group_data       Group data
  * @return true if we have received data from all enabled slave devices,
  *         or false if not (then we should wait for more responses)
@@ -225,55 +373,262 @@ int clm_iefb_calc_slave_device_index (
  *
  */
 bool clm_iefb_group_have_received_from_all_devices (
-   const clm_group_setting_t * group_setting,
    const clm_group_data_t * group_data)
 {
-   uint16_t slave_device_index = 0;
-   bool has_received           = false;
-   const clm_slave_device_data_t * slave_device_data;
-   bool first_frame = group_data->frame_sequence_no == 0;
+   return group_data->awaiting_responses == 0 &&
+          group_data->responding_devices != 0;
+}
+
+/**
+ * Update the bits for one slave device in the masks used for detecting
+ * that a link scan is complete.
+ *
+ * For the first frame in a link scan sequence we wait for all devices in
+ * CLM_DEVICE_STATE_WAIT_TD, and at least one device must have responded
+ * (CLM_DEVICE_STATE_CYCLIC_SENT). For consecutive frames we wait for
+ * connected devices (with transmission bit on) in
+ * CLM_DEVICE_STATE_CYCLIC_SENDING, and there must be at least one connected
+ * device.
+ *
+ * Called after each event to the device state machine. The frame sequence
+ * number only changes between link scans, and all devices receive an event
+ * at link scan start.
+ *
+ * @param group_data             Group data
+ * @param slave_device_data      Runtime data for a slave device
+ */
+void clm_iefb_update_awaiting_responses (
+   clm_group_data_t * group_data,
+   const clm_slave_device_hot_t * slave_device_data)
+{
+   uint16_t device_bit = (uint16_t)(1U << slave_device_data->device_index);
+   bool first_frame    = group_data->frame_sequence_no == 0;
+   bool awaiting       = false;
+   bool responding     = false;
 
    if (first_frame)
    {
-      for (slave_device_index = 0;
-           slave_device_index < group_setting->num_slave_devices;
-           slave_device_index++)
-      {
-         slave_device_data = &group_data->slave_devices[slave_device_index];
+      awaiting = slave_device_data->device_state == CLM_DEVICE_STATE_WAIT_TD;
+      responding =
+         slave_device_data->device_state == CLM_DEVICE_STATE_CYCLIC_SENT;
+   }
+   else
+   {
+      awaiting = slave_device_data->transmission_bit &&
+                 slave_device_data->device_state ==
+                    CLM_DEVICE_STATE_CYCLIC_SENDING;
+      responding = slave_device_data->transmission_bit;
+   }
 
-         if (slave_device_data->device_state == CLM_DEVICE_STATE_WAIT_TD)
-         {
-            return false;
-         }
+   if (awaiting)
+   {
+      group_data->awaiting_responses |= device_bit;
+   }
+   else
+   {
+      group_data->awaiting_responses &= (uint16_t)~device_bit;
+   }
 
-         if (slave_device_data->device_state == CLM_DEVICE_STATE_CYCLIC_SENT)
-         {
-            has_received = true;
-         }
-      }
+   if (responding)
+   {
+      group_data->responding_devices |= device_bit;
+   }
+   else
+   {
+      group_data->responding_devices &= (uint16_t)~device_bit;
+   }
+}
+
+/**
+ * Check if the groups are run by shards, in separate threads.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @return true if sharding is enabled
+ */
+static bool clm_iefb_is_sharded (const clm_t * clm)
+{
+   return clm->config.number_of_shards > 1;
+}
+
+/**
+ * Get the shard running a group. Only valid if sharding is enabled.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0)
+ * @return Shard instance
+ */
+static clm_shard_t * clm_iefb_get_shard (clm_t * clm, uint16_t group_index)
+{
+   return &clm->shards[group_index % clm->config.number_of_shards];
+}
 
-      return has_received ? true : false;
+/**
+ * Get the queue for outgoing request frames to a group.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0)
+ * @return Send queue of the shard running the group, or the send queue of
+ *         the master if sharding is not enabled.
+ */
+static clm_send_queue_t * clm_iefb_get_send_queue (
+   clm_t * clm,
+   uint16_t group_index)
+{
+   if (clm_iefb_is_sharded (clm))
+   {
+      return &clm_iefb_get_shard (clm, group_index)->send_queue;
    }
 
-   /* Consecutive frames */
-   for (slave_device_index = 0;
-        slave_device_index < group_setting->num_slave_devices;
-        slave_device_index++)
+   return &clm->cciefb_send_queue;
+}
+
+/**
+ * Get the limiter for error callbacks triggered by a group.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0)
+ * @return Error limiter of the shard running the group, or the error
+ *         limiter of the master if sharding is not enabled.
+ */
+static cl_limiter_t * clm_iefb_get_errorlimiter (
+   clm_t * clm,
+   uint16_t group_index)
+{
+   if (clm_iefb_is_sharded (clm))
    {
-      slave_device_data = &group_data->slave_devices[slave_device_index];
+      return &clm_iefb_get_shard (clm, group_index)->errorlimiter;
+   }
 
-      if (slave_device_data->transmission_bit)
+   return &clm->errorlimiter;
+}
+
+/**
+ * Check whether application callbacks for the groups are queued, instead
+ * of being called directly.
+ *
+ * With master shards the callbacks are always queued, so that they are
+ * called from the thread running clm_iefb_periodic() (or the thread
+ * calling clm_dispatch_callbacks()) instead of from the shard threads.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @return true if the callbacks are queued
+ */
+static bool clm_iefb_use_callback_queue (const clm_t * clm)
+{
+   return clm->config.use_async_callbacks || clm_iefb_is_sharded (clm);
+}
+
+/**
+ * Get the queue for application callbacks triggered by a group.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0)
+ * @return Callback queue of the shard running the group, or the callback
+ *         queue of the master if sharding is not enabled.
+ */
+static clm_callback_queue_t * clm_iefb_get_callback_queue (
+   clm_t * clm,
+   uint16_t group_index)
+{
+   if (clm_iefb_is_sharded (clm))
+   {
+      return &clm_iefb_get_shard (clm, group_index)->callback_queue;
+   }
+
+   return &clm->callback_queue;
+}
+
+/**
+ * Send all queued CCIEFB request frames.
+ *
+ * The frames are handed over to the abstraction layer in a single call.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param queue                  Send queue
+ * @return 0 on success, -1 if any of the frames failed to be sent
+ *
+ * @req REQ_CL_UDP_01
+ */
+static int clm_iefb_send_queued_request_frames (
+   clm_t * clm,
+   clm_send_queue_t * queue)
+{
+   int num_sent;
+   int i;
+   uint16_t group_index;
+   uint16_t num_queued = queue->count;
+   const clal_udp_message_t * message;
+   clm_group_data_t * group_data;
+
+   if (num_queued == 0)
+   {
+      return 0;
+   }
+
+   queue->count = 0;
+   num_sent     = clal_udp_sendto_batch (
+      clm->cciefb_socket,
+      queue->messages,
+      num_queued);
+
+   /* Number the datagrams, to match the transmission timestamps read
+      later from the socket error queue. With master shards several
+      threads send on the socket, so the numbers are not known. */
+   for (i = 0; i < num_sent && !clm_iefb_is_sharded (clm); i++)
+   {
+      message = &queue->messages[i];
+      for (group_index = 0; group_index < clm->config.hier.number_of_groups;
+           group_index++)
       {
-         has_received = true;
+         group_data = &clm->groups[group_index];
+         if (message->data == group_data->req_frame.buffer)
+         {
+            group_data->request_datagram_id =
+               clm->cciefb_datagrams_sent + (uint32_t)i + 1;
+         }
       }
+   }
+   if (num_sent > 0)
+   {
+      clm->cciefb_datagrams_sent += (uint32_t)num_sent;
+   }
+
+   if (num_sent != (int)num_queued)
+   {
+      LOG_DEBUG (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Sent %d of %u request frames.\n",
+         __LINE__,
+         num_sent,
+         (unsigned)num_queued);
+      return -1;
+   }
+
+   return 0;
+}
+
+/**
+ * Check if a request frame for the group is waiting to be sent.
+ *
+ * @param queue                  Send queue
+ * @param group_data             Runtime data for one group
+ * @return true if the request frame buffer for the group is queued
+ */
+static bool clm_iefb_is_request_frame_queued (
+   const clm_send_queue_t * queue,
+   const clm_group_data_t * group_data)
+{
+   uint16_t i;
 
-      if (slave_device_data->transmission_bit && slave_device_data->device_state == CLM_DEVICE_STATE_CYCLIC_SENDING)
+   for (i = 0; i < queue->count; i++)
+   {
+      if (queue->messages[i].data == group_data->req_frame.buffer)
       {
-         return false;
+         return true;
       }
    }
 
-   return has_received ? true : false;
+   return false;
 }
 
 /**
@@ -281,14 +636,16 @@ bool clm_iefb_group_have_received_from_all_devices (
  *
  * Update outgoing frame in buffer.
  *
- * @param socket                 Socket handle
- * @param destination_ip_addr    Destination IP address
+ * While the stack is handling timers and incoming frames (see
+ * \a deferred in the send queue) the frame is queued, and is sent together
+ * with the request frames for other groups by
+ * \a clm_iefb_send_queued_request_frames(). Otherwise it is sent directly.
+ *
+ * @param clm                    c-link master stack instance handle
  * @param group_data             Runtime data for one group (has frame
  *                               buffer)
  * @param now                    Timestamp in microseconds
  * @param unix_timestamp_ms      Unix timestamp in ms, or 0 if not available
- * @param master_local_unit_info Is master application running or not. See
- *                               CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_xxx
  * @return 0 on success, -1 on failure
  *
  * @req REQ_CL_UDP_01
@@ -297,35 +654,44 @@ bool clm_iefb_group_have_received_from_all_devices (
  *
  */
 static int clm_iefb_send_cyclic_request_frame (
-   int socket,
-   cl_ipaddr_t destination_ip_addr,
+   clm_t * clm,
    clm_group_data_t * group_data,
    uint32_t now,
-   uint64_t unix_timestamp_ms,
-   uint16_t master_local_unit_info)
+   uint64_t unix_timestamp_ms)
 {
-   ssize_t sent_size = 0;
+   clal_udp_message_t * message;
+   clm_send_queue_t * queue =
+      clm_iefb_get_send_queue (clm, group_data->group_index);
 
    cl_iefb_update_request_frame_headers (
       &group_data->req_frame,
       group_data->frame_sequence_no,
       unix_timestamp_ms,
-      master_local_unit_info,
+      clm->master_local_unit_info,
       group_data->cyclic_transmission_state);
 
-   sent_size = clal_udp_sendto (
-      socket,
-      destination_ip_addr,
-      CL_CCIEFB_PORT,
-      group_data->req_frame.buffer,
-      group_data->req_frame.udp_payload_len);
+   if (queue->count >= NELEMENTS (queue->messages))
+   {
+      (void)clm_iefb_send_queued_request_frames (clm, queue);
+   }
 
-   if (sent_size < 0 || (size_t)sent_size != group_data->req_frame.udp_payload_len)
+   message                  = &queue->messages[queue->count];
+   message->data            = group_data->req_frame.buffer;
+   message->size            = group_data->req_frame.udp_payload_len;
+   message->len             = group_data->req_frame.udp_payload_len;
+   message->remote_ip       = clm->iefb_broadcast_ip;
+   message->remote_port     = CL_CCIEFB_PORT;
+   message->timestamp_valid = false;
+   queue->count++;
+
+   group_data->timestamp_request_transmitted_valid = false;
+
+   if (queue->deferred)
    {
-      return -1;
+      return 0;
    }
 
-   return 0;
+   return clm_iefb_send_queued_request_frames (clm, queue);
 }
 
 /**
@@ -417,16 +783,58 @@ void clm_iefb_update_request_slave_id (
    }
 }
 
+/**
+ * Check whether changed output stations are tracked in the per-group
+ * dirty bitmap.
+ *
+ * With output dirty tracking, the marked stations are copied to the
+ * request frame at link scan start. With double buffered outputs, they
+ * are copied to the new inactive frame when publishing.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @return true if the dirty bitmap is used
+ */
+static bool clm_iefb_is_output_tracking_used (const clm_t * clm)
+{
+   return clm->config.use_output_dirty_tracking ||
+          clm->config.use_double_buffered_outputs;
+}
+
+/**
+ * Calculate a mask with one bit per slave station, for a range of
+ * slave stations in a group.
+ *
+ * @param start_index            Index of first station. First station is 0.
+ * @param num_stations           Number of stations
+ * @return mask with bit \a start_index and higher set
+ */
+static uint16_t clm_iefb_calc_station_mask (
+   uint16_t start_index,
+   uint16_t num_stations)
+{
+   const uint32_t bits = (UINT32_C (1) << num_stations) - 1;
+
+   return (uint16_t)(bits << start_index);
+}
+
 /**
  * Update the cyclic data (RY and RWw) in an outgoing request frame, for one
  * device (all of its occupied stations).
  *
  * No validation is done on input parameters.
  *
- * Copying is done from \a group_cyclic_data to \a req_frame
+ * Copying is done from \a group_cyclic_data to \a req_frame, unless
+ * \a group_cyclic_data is NULL. That is used for double buffered outputs,
+ * where the application already has written the data to the frame.
+ *
+ * If \a dirty_outputs is not NULL, only the stations with their bit set
+ * are copied (and the bits are cleared). Stations written with zeros are
+ * marked, so they are copied when valid again.
  *
  * @param req_frame              Frame to be updated
- * @param group_cyclic_data      Memory area with cyclic data
+ * @param group_cyclic_data      Memory area with cyclic data, or NULL
+ * @param dirty_outputs          Changed stations (one bit per station),
+ *                               or NULL to copy all stations of the device
  * @param slave_station_no       Slave station number. First station is 1.
  * @param num_occupied_stations  Number of stations this device occupies
  * @param valid                  True if data should be written, or false if
@@ -435,6 +843,7 @@ void clm_iefb_update_request_slave_id (
 static void clm_iefb_update_request_frame_cyclic_data_one_device (
    clm_cciefb_cyclic_request_info_t * req_frame,
    const clm_group_memory_area_t * group_cyclic_data,
+   uint16_t * dirty_outputs,
    uint16_t slave_station_no,
    uint16_t num_occupied_stations,
    bool valid)
@@ -442,8 +851,36 @@ static void clm_iefb_update_request_frame_cyclic_data_one_device (
    const uint16_t start_index = slave_station_no - 1;
    const size_t num_rww_bytes = num_occupied_stations * sizeof (cl_rww_t);
    const size_t num_ry_bytes  = num_occupied_stations * sizeof (cl_ry_t);
+   uint16_t ix;
 
-   if (valid)
+   if (valid && group_cyclic_data == NULL)
+   {
+      return;
+   }
+
+   if (valid && dirty_outputs != NULL)
+   {
+      for (ix = start_index; ix < start_index + num_occupied_stations; ix++)
+      {
+         if ((*dirty_outputs & (1U << ix)) == 0)
+         {
+            continue;
+         }
+
+         clal_memcpy (
+            &req_frame->first_rww[ix],
+            sizeof (cl_rww_t),
+            &group_cyclic_data->rww[ix],
+            sizeof (cl_rww_t));
+         clal_memcpy (
+            &req_frame->first_ry[ix],
+            sizeof (cl_ry_t),
+            &group_cyclic_data->ry[ix],
+            sizeof (cl_ry_t));
+         *dirty_outputs &= (uint16_t) ~(1U << ix);
+      }
+   }
+   else if (valid)
    {
       clal_memcpy (
          &req_frame->first_rww[start_index],
@@ -460,30 +897,63 @@ static void clm_iefb_update_request_frame_cyclic_data_one_device (
    {
       clal_clear_memory (&req_frame->first_rww[start_index], num_rww_bytes);
       clal_clear_memory (&req_frame->first_ry[start_index], num_ry_bytes);
+
+      if (dirty_outputs != NULL)
+      {
+         *dirty_outputs |=
+            clm_iefb_calc_station_mask (start_index, num_occupied_stations);
+      }
    }
 }
 
+/**
+ * Calculate the response time of a slave device.
+ *
+ * The timestamps from the port are used only if they are available for
+ * both the request and the response. Otherwise the application ticks are
+ * used for both, as they are taken at other points in time.
+ *
+ * @param group_data             Group data
+ * @param now                    Current timestamp, in microseconds
+ * @param port_timestamp         Timestamp from the port when the response
+ *                               was received, in microseconds
+ * @param port_timestamp_valid   True if \a port_timestamp is available
+ * @return Time since the request, in microseconds
+ */
+static uint32_t clm_iefb_calc_response_time (
+   const clm_group_data_t * group_data,
+   uint32_t now,
+   uint32_t port_timestamp,
+   bool port_timestamp_valid)
+{
+   if (port_timestamp_valid && group_data->timestamp_request_transmitted_valid)
+   {
+      return port_timestamp - group_data->timestamp_request_transmitted;
+   }
+
+   return now - group_data->timestamp_request_sent;
+}
+
 /**
  * Store runtime info from incoming response frame headers.
  *
  * Converts endianness.
  *
  * @param cyclic_response        Incoming response frame
- * @param transmission_timestamp Timestamp when corresponding request was sent
+ * @param response_time          Time since the request, in microseconds
  * @param framevalues            Info to be updated
  *
  * @req REQ_CL_PROTOCOL_51
  */
 static void clm_iefb_store_incoming_slave_runtime_info (
    const clm_cciefb_cyclic_response_info_t * cyclic_response,
-   uint32_t transmission_timestamp,
+   uint32_t response_time,
    clm_device_framevalues_t * framevalues)
 {
    cl_cciefb_cyclic_resp_full_headers_t * headers = cyclic_response->full_headers;
 
    framevalues->has_been_received = true;
-   framevalues->response_time =
-      cyclic_response->reception_timestamp - transmission_timestamp;
+   framevalues->response_time     = response_time;
    framevalues->end_code = CC_FROM_LE16 (headers->cyclic_header.end_code);
    framevalues->num_occupied_stations = cyclic_response->number_of_occupied;
    framevalues->protocol_ver = CC_FROM_LE16 (headers->cyclic_header.protocol_ver);
@@ -561,32 +1031,140 @@ static void clm_iefb_latest_received_clear (clm_device_framevalues_t * latest_fr
    clal_clear_memory (latest_frame, sizeof (*latest_frame));
 }
 
+/**
+ * Start updating the incoming data (RX and RWr) of a group.
+ *
+ * The input sequence counter is made odd before any of the data is
+ * written. Only called by the thread running the group.
+ *
+ * @param group_data             Group data
+ */
+static void clm_iefb_input_write_begin (clm_group_data_t * group_data)
+{
+   group_data->input_sequence = group_data->input_sequence + 1;
+
+   /* The odd counter must be visible before the data is modified */
+   clal_memory_barrier();
+}
+
+/**
+ * Finish updating the incoming data (RX and RWr) of a group.
+ *
+ * The input sequence counter is made even after all of the data has been
+ * written.
+ *
+ * @param group_data             Group data
+ */
+static void clm_iefb_input_write_end (clm_group_data_t * group_data)
+{
+   /* The data must be visible before the even counter */
+   clal_memory_barrier();
+
+   group_data->input_sequence = group_data->input_sequence + 1;
+}
+
+/**
+ * Start reading the incoming data (RX and RWr) of a group, from any thread.
+ *
+ * @param group_data             Group data
+ * @param sequence               Resulting input sequence counter, to be
+ *                               given to clm_iefb_input_read_retry()
+ * @return true if the data can be read, false if an update is in progress
+ */
+static bool clm_iefb_input_read_begin (
+   const clm_group_data_t * group_data,
+   uint32_t * sequence)
+{
+   *sequence = group_data->input_sequence;
+
+   /* The data must not be read before the counter */
+   clal_memory_barrier();
+
+   return (*sequence & 1U) == 0;
+}
+
+/**
+ * Check whether the incoming data of a group was updated while it was read.
+ *
+ * @param group_data             Group data
+ * @param sequence               Input sequence counter from
+ *                               clm_iefb_input_read_begin()
+ * @return true if the data was updated, and the copy must be discarded
+ */
+static bool clm_iefb_input_read_retry (
+   const clm_group_data_t * group_data,
+   uint32_t sequence)
+{
+   /* All of the data must be read before the counter is read again */
+   clal_memory_barrier();
+
+   return group_data->input_sequence != sequence;
+}
+
 /**
  * Store cyclic data (RX and RWw) from incoming response frame.
  *
- * Copying is done from \a cyclic_response to \a group_cyclic_data
+ * Copying is done from \a cyclic_response to the group memory area.
  *
- * @param group_cyclic_data      Stored cyclic data to be updated
+ * The input sequence counter is odd during the update, so that application
+ * threads reading snapshots can detect a partial update.
+ *
+ * The signals that differ from the previously stored data are reported in
+ * \a changed, and are also accumulated in the group data.
+ *
+ * @param group_data             Group data, with memory area to be updated
  * @param cyclic_response        Incoming response frame
  * @param slave_station_no       Slave station number. Starts at 1.
  * @param num_occupied_stations  Number of occupied stations for slave device
  * @param valid                  True if incoming data should be stored,
  *                               or false if zeros should be stored
+ * @param changed                Resulting changed signals for the device
+ * @return true if any signal has changed
  *
  * @req REQ_CLM_STATUSBIT_04
  * @req REQ_CLM_STATUSBIT_06
  * @req REQ_CLM_STATUSBIT_09
  */
-static void clm_iefb_store_incoming_cyclic_data (
-   clm_group_memory_area_t * group_cyclic_data,
+static bool clm_iefb_store_incoming_cyclic_data (
+   clm_group_data_t * group_data,
    const clm_cciefb_cyclic_response_info_t * cyclic_response,
    uint16_t slave_station_no,
    uint16_t num_occupied_stations,
-   bool valid)
+   bool valid,
+   cl_changed_signals_t * changed)
 {
+   clm_group_memory_area_t * group_cyclic_data = &group_data->memory_area;
    const uint16_t first_index = slave_station_no - 1;
    const size_t num_rwr_bytes = num_occupied_stations * sizeof (cl_rwr_t);
    const size_t num_rx_bytes  = num_occupied_stations * sizeof (cl_rx_t);
+   const uint8_t * incoming_rwr;
+   const uint8_t * incoming_rx;
+   bool any_changed = false;
+   uint16_t i;
+
+   /* Compare before storing. The incoming areas might be unaligned. */
+   changed->num_occupied_stations = num_occupied_stations;
+   for (i = 0; i < num_occupied_stations; i++)
+   {
+      incoming_rwr = valid ? (const uint8_t *)&cyclic_response->first_rwr[i]
+                           : NULL;
+      incoming_rx  = valid ? (const uint8_t *)&cyclic_response->first_rx[i]
+                           : NULL;
+
+      changed->words[i] = cl_util_calc_changed_words (
+         (const uint8_t *)&group_cyclic_data->rwr[first_index + i],
+         incoming_rwr);
+      changed->bits[i] = cl_util_calc_changed_bits (
+         group_cyclic_data->rx[first_index + i].bytes,
+         incoming_rx);
+
+      group_data->changed_rwr[first_index + i] |= changed->words[i];
+      group_data->changed_rx[first_index + i] |= changed->bits[i];
+      any_changed = any_changed || changed->words[i] != 0 ||
+                    changed->bits[i] != 0;
+   }
+
+   clm_iefb_input_write_begin (group_data);
 
    if (valid)
    {
@@ -606,6 +1184,14 @@ static void clm_iefb_store_incoming_cyclic_data (
       clal_clear_memory (&group_cyclic_data->rwr[first_index], num_rwr_bytes);
       clal_clear_memory (&group_cyclic_data->rx[first_index], num_rx_bytes);
    }
+
+   group_data->input_frame_sequence_no = group_data->frame_sequence_no;
+   group_data->input_timestamp_link_scan_start =
+      group_data->timestamp_link_scan_start;
+
+   clm_iefb_input_write_end (group_data);
+
+   return any_changed;
 }
 
 /**
@@ -642,6 +1228,115 @@ static void clm_iefb_set_master_state (clm_t * clm, clm_master_state_t new_state
    }
 }
 
+/**
+ * Set the master state, as requested by the state machine of a group.
+ *
+ * If sharding is enabled the state is stored for the shard running the
+ * group. The master state is then updated (and the application callback
+ * is called) by \a clm_iefb_monitor_shards().
+ *
+ * @param clm              c-link master stack instance handle
+ * @param group_data       Group data
+ * @param new_state        New master state
+ */
+static void clm_iefb_set_master_state_from_group (
+   clm_t * clm,
+   const clm_group_data_t * group_data,
+   clm_master_state_t new_state)
+{
+   if (clm_iefb_is_sharded (clm))
+   {
+      clm_iefb_get_shard (clm, group_data->group_index)->master_state =
+         new_state;
+      return;
+   }
+
+   clm_iefb_set_master_state (clm, new_state);
+}
+
+/**
+ * Check whether the latest callback waiting in the callback queue is an
+ * identical link scan callback for the same group.
+ *
+ * Only the latest callback is considered, so that merging never changes
+ * the order of the callbacks as seen by the application.
+ *
+ * A stale read count from the consumer only makes a callback that is
+ * being delivered look like it is still waiting, which is harmless when
+ * coalescing.
+ *
+ * @param queue            Callback queue
+ * @param record           Link scan callback to be queued
+ * @return true if the callback can be merged into the queued one
+ */
+static bool clm_iefb_is_linkscan_callback_queued (
+   const clm_callback_queue_t * queue,
+   const clm_callback_record_t * record)
+{
+   const clm_callback_record_t * latest;
+   uint32_t write_count = queue->write_count;
+
+   if (write_count == queue->read_count)
+   {
+      return false;
+   }
+
+   latest = &queue->records[(write_count - 1) & (CLM_CALLBACK_QUEUE_SIZE - 1)];
+
+   return latest->type == CLM_CALLBACK_LINKSCAN &&
+          latest->group_index == record->group_index &&
+          latest->success == record->success;
+}
+
+/**
+ * Queue an application callback, to be delivered from the application
+ * thread by clm_iefb_dispatch_callbacks().
+ *
+ * The callback is dropped if the queue is full.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param record           Callback to be queued
+ */
+static void clm_iefb_queue_callback (
+   clm_t * clm,
+   const clm_callback_record_t * record)
+{
+   clm_callback_queue_t * queue =
+      clm_iefb_get_callback_queue (clm, record->group_index);
+   uint32_t write_count = queue->write_count;
+
+   if (
+      record->type == CLM_CALLBACK_LINKSCAN &&
+      clm->config.coalesce_linkscan_callbacks &&
+      clm_iefb_is_linkscan_callback_queued (queue, record))
+   {
+      queue->coalesced_linkscans++;
+      return;
+   }
+
+   if (write_count - queue->read_count >= CLM_CALLBACK_QUEUE_SIZE)
+   {
+      LOG_DEBUG (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Callback queue full. Dropping callback type %u for "
+         "group index %u.\n",
+         __LINE__,
+         record->type,
+         record->group_index);
+      queue->overflows++;
+      return;
+   }
+
+   clal_memcpy (
+      &queue->records[write_count & (CLM_CALLBACK_QUEUE_SIZE - 1)],
+      sizeof (queue->records[0]),
+      record,
+      sizeof (*record));
+
+   clal_memory_barrier();
+   queue->write_count = write_count + 1;
+}
+
 /**
  * Trigger the link scan application callback, if implemented.
  *
@@ -655,7 +1350,16 @@ static void clm_iefb_trigger_linkscan_callback (
    clm_group_data_t * group_data,
    bool success)
 {
-   if (clm->config.linkscan_cb != NULL)
+   clm_callback_record_t record = {0};
+
+   if (clm->config.linkscan_cb != NULL && clm_iefb_use_callback_queue (clm))
+   {
+      record.type        = CLM_CALLBACK_LINKSCAN;
+      record.group_index = group_data->group_index;
+      record.success     = success;
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.linkscan_cb != NULL)
    {
       clm->config.linkscan_cb (
          clm,
@@ -675,6 +1379,7 @@ static void clm_iefb_trigger_linkscan_callback (
  * the callback is triggered once only.
  *
  * @param clm              c-link master stack instance handle
+ * @param errorlimiter     Limiter for the thread triggering the callback
  * @param now              Current timestamp, in microseconds
  * @param error_message    Error message enum
  * @param ip_addr          IP address, if available
@@ -682,12 +1387,13 @@ static void clm_iefb_trigger_linkscan_callback (
  */
 static void clm_iefb_trigger_error_callback (
    clm_t * clm,
+   cl_limiter_t * errorlimiter,
    uint32_t now,
    clm_error_message_t error_message,
    cl_ipaddr_t ip_addr,
    uint16_t argument_2)
 {
-   if (!cl_limiter_should_run_now (&clm->errorlimiter, (int)error_message, now))
+   if (!cl_limiter_should_run_now (errorlimiter, (int)error_message, now))
    {
       return;
    }
@@ -712,6 +1418,55 @@ static void clm_iefb_trigger_error_callback (
    }
 }
 
+/**
+ * Trigger the error application callback for an error detected by a group.
+ *
+ * With master shards the callback is queued, to be called from the thread
+ * running clm_iefb_periodic(). The error limiter of the shard is used.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param group_index      Group index
+ * @param now              Current timestamp, in microseconds
+ * @param error_message    Error message enum
+ * @param ip_addr          IP address, if available
+ * @param argument_2       Numeric argument, if available
+ */
+static void clm_iefb_trigger_group_error_callback (
+   clm_t * clm,
+   uint16_t group_index,
+   uint32_t now,
+   clm_error_message_t error_message,
+   cl_ipaddr_t ip_addr,
+   uint16_t argument_2)
+{
+   cl_limiter_t * errorlimiter = clm_iefb_get_errorlimiter (clm, group_index);
+   clm_callback_record_t record = {0};
+
+   if (!clm_iefb_is_sharded (clm))
+   {
+      clm_iefb_trigger_error_callback (
+         clm,
+         errorlimiter,
+         now,
+         error_message,
+         ip_addr,
+         argument_2);
+      return;
+   }
+
+   if (
+      clm->config.error_cb != NULL &&
+      cl_limiter_should_run_now (errorlimiter, (int)error_message, now))
+   {
+      record.type          = CLM_CALLBACK_ERROR;
+      record.group_index   = group_index;
+      record.slave_id      = ip_addr;
+      record.error_message = (uint16_t)error_message;
+      record.argument_2    = argument_2;
+      clm_iefb_queue_callback (clm, &record);
+   }
+}
+
 /**
  * Trigger the connect callback, if implemented.
  *
@@ -722,7 +1477,7 @@ static void clm_iefb_trigger_error_callback (
 static void clm_iefb_trigger_connect_callback (
    clm_t * clm,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data)
+   clm_slave_device_hot_t * slave_device_data)
 {
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
    char ip_string[CL_INET_ADDRSTR_SIZE] = {0}; /** Terminated string */
@@ -732,6 +1487,7 @@ static void clm_iefb_trigger_connect_callback (
       &clm->config.hier.groups[group_data->group_index];
    clm_slave_device_setting_t * slave_device_setting =
       &group_setting->slave_devices[slave_device_data->device_index];
+   clm_callback_record_t record = {0};
 
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
    cl_util_ip_to_string (slave_device_setting->slave_id, ip_string);
@@ -746,7 +1502,15 @@ static void clm_iefb_trigger_connect_callback (
       ip_string);
 #endif
 
-   if (clm->config.connect_cb != NULL)
+   if (clm->config.connect_cb != NULL && clm_iefb_use_callback_queue (clm))
+   {
+      record.type               = CLM_CALLBACK_CONNECT;
+      record.group_index        = group_data->group_index;
+      record.slave_device_index = slave_device_data->device_index;
+      record.slave_id           = slave_device_setting->slave_id;
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.connect_cb != NULL)
    {
       clm->config.connect_cb (
          clm,
@@ -767,7 +1531,7 @@ static void clm_iefb_trigger_connect_callback (
 static void clm_iefb_trigger_disconnect_callback (
    clm_t * clm,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data)
+   clm_slave_device_hot_t * slave_device_data)
 {
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
    char ip_string[CL_INET_ADDRSTR_SIZE] = {0}; /** Terminated string */
@@ -777,6 +1541,7 @@ static void clm_iefb_trigger_disconnect_callback (
       &clm->config.hier.groups[group_data->group_index];
    clm_slave_device_setting_t * slave_device_setting =
       &group_setting->slave_devices[slave_device_data->device_index];
+   clm_callback_record_t record = {0};
 
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
    cl_util_ip_to_string (slave_device_setting->slave_id, ip_string);
@@ -791,7 +1556,15 @@ static void clm_iefb_trigger_disconnect_callback (
       ip_string);
 #endif
 
-   if (clm->config.disconnect_cb != NULL)
+   if (clm->config.disconnect_cb != NULL && clm_iefb_use_callback_queue (clm))
+   {
+      record.type               = CLM_CALLBACK_DISCONNECT;
+      record.group_index        = group_data->group_index;
+      record.slave_device_index = slave_device_data->device_index;
+      record.slave_id           = slave_device_setting->slave_id;
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.disconnect_cb != NULL)
    {
       clm->config.disconnect_cb (
          clm,
@@ -820,6 +1593,8 @@ static void clm_iefb_trigger_slaveinfo_callback (
    uint16_t slave_err_code,
    uint32_t local_management_info)
 {
+   clm_callback_record_t record = {0};
+
    LOG_DEBUG (
       CL_CCIEFB_LOG,
       "CCIEFB(%d): %s user callback for incoming change in slave"
@@ -830,7 +1605,19 @@ static void clm_iefb_trigger_slaveinfo_callback (
       end_code,
       slave_err_code,
       (unsigned int)local_management_info);
-   if (clm->config.changed_slave_info_cb != NULL)
+   if (
+      clm->config.changed_slave_info_cb != NULL &&
+      clm_iefb_use_callback_queue (clm))
+   {
+      record.type                  = CLM_CALLBACK_SLAVEINFO;
+      record.group_index           = group_index;
+      record.slave_device_index    = slave_device_index;
+      record.end_code              = end_code;
+      record.slave_err_code        = slave_err_code;
+      record.local_management_info = local_management_info;
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.changed_slave_info_cb != NULL)
    {
       clm->config.changed_slave_info_cb (
          clm,
@@ -843,6 +1630,45 @@ static void clm_iefb_trigger_slaveinfo_callback (
    }
 }
 
+/**
+ * Trigger the inputs changed callback, if implemented.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index
+ * @param slave_device_index     Slave device index
+ * @param changed                Changed signals
+ */
+static void clm_iefb_trigger_inputs_changed_callback (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   const cl_changed_signals_t * changed)
+{
+   clm_callback_record_t record = {0};
+
+   if (clm->config.inputs_changed_cb != NULL && clm_iefb_is_sharded (clm))
+   {
+      record.type               = CLM_CALLBACK_INPUTS_CHANGED;
+      record.group_index        = group_index;
+      record.slave_device_index = slave_device_index;
+      clal_memcpy (
+         &record.changed,
+         sizeof (record.changed),
+         changed,
+         sizeof (*changed));
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.inputs_changed_cb != NULL)
+   {
+      clm->config.inputs_changed_cb (
+         clm,
+         clm->config.cb_arg,
+         group_index,
+         slave_device_index,
+         changed);
+   }
+}
+
 /**
  * Trigger the alarm frame callback, if implemented.
  *
@@ -861,6 +1687,8 @@ static void clm_iefb_trigger_alarmframe_callback (
    uint16_t slave_err_code,
    uint32_t local_management_info)
 {
+   clm_callback_record_t record = {0};
+
    LOG_DEBUG (
       CL_CCIEFB_LOG,
       "CCIEFB(%d): %s user callback for alarm frame. Group index %u, "
@@ -873,7 +1701,17 @@ static void clm_iefb_trigger_alarmframe_callback (
       end_code,
       slave_err_code,
       (unsigned int)local_management_info);
-   if (clm->config.alarm_cb != NULL)
+   if (clm->config.alarm_cb != NULL && clm_iefb_use_callback_queue (clm))
+   {
+      record.type                  = CLM_CALLBACK_ALARMFRAME;
+      record.group_index           = group_index;
+      record.slave_device_index    = slave_device_index;
+      record.end_code              = end_code;
+      record.slave_err_code        = slave_err_code;
+      record.local_management_info = local_management_info;
+      clm_iefb_queue_callback (clm, &record);
+   }
+   else if (clm->config.alarm_cb != NULL)
    {
       clm->config.alarm_cb (
          clm,
@@ -886,6 +1724,141 @@ static void clm_iefb_trigger_alarmframe_callback (
    }
 }
 
+/**
+ * Call the application callback for a queued callback record.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param record           Queued callback
+ */
+static void clm_iefb_call_queued_callback (
+   clm_t * clm,
+   const clm_callback_record_t * record)
+{
+   switch (record->type)
+   {
+   case CLM_CALLBACK_CONNECT:
+      clm->config.connect_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->slave_device_index,
+         record->slave_id);
+      break;
+   case CLM_CALLBACK_DISCONNECT:
+      clm->config.disconnect_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->slave_device_index,
+         record->slave_id);
+      break;
+   case CLM_CALLBACK_LINKSCAN:
+      clm->config.linkscan_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->success);
+      break;
+   case CLM_CALLBACK_ALARMFRAME:
+      clm->config.alarm_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->slave_device_index,
+         record->end_code,
+         record->slave_err_code,
+         record->local_management_info);
+      break;
+   case CLM_CALLBACK_SLAVEINFO:
+      clm->config.changed_slave_info_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->slave_device_index,
+         record->end_code,
+         record->slave_err_code,
+         record->local_management_info);
+      break;
+   case CLM_CALLBACK_ERROR:
+      clm->config.error_cb (
+         clm,
+         clm->config.cb_arg,
+         (clm_error_message_t)record->error_message,
+         record->slave_id,
+         record->argument_2);
+      break;
+   case CLM_CALLBACK_INPUTS_CHANGED:
+      clm->config.inputs_changed_cb (
+         clm,
+         clm->config.cb_arg,
+         record->group_index,
+         record->slave_device_index,
+         &record->changed);
+      break;
+   case CLM_CALLBACK_COMMAND_CFM:
+      clm->config.command_cfm_cb (
+         clm,
+         clm->config.cb_arg,
+         &record->command,
+         record->success ? 0 : -1);
+      break;
+   default:
+      break;
+   }
+}
+
+/**
+ * Deliver all callbacks in a callback queue.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param queue            Callback queue
+ * @return Number of callbacks delivered
+ */
+static int clm_iefb_dispatch_queued_callbacks (
+   clm_t * clm,
+   clm_callback_queue_t * queue)
+{
+   int delivered = 0;
+
+   while (queue->read_count != queue->write_count)
+   {
+      /* Read the record after the updated count */
+      clal_memory_barrier();
+      clm_iefb_call_queued_callback (
+         clm,
+         &queue->records[queue->read_count & (CLM_CALLBACK_QUEUE_SIZE - 1)]);
+
+      /* Release the queue slot after the callback has returned */
+      clal_memory_barrier();
+      queue->read_count++;
+      delivered++;
+   }
+
+   return delivered;
+}
+
+int clm_iefb_dispatch_callbacks (clm_t * clm)
+{
+   uint16_t shard_index;
+   int delivered;
+
+   if (!clm_iefb_is_sharded (clm))
+   {
+      return clm_iefb_dispatch_queued_callbacks (clm, &clm->callback_queue);
+   }
+
+   delivered = 0;
+   for (shard_index = 0; shard_index < clm->config.number_of_shards;
+        shard_index++)
+   {
+      delivered += clm_iefb_dispatch_queued_callbacks (
+         clm,
+         &clm->shards[shard_index].callback_queue);
+   }
+
+   return delivered;
+}
+
 /**
  * Prepare group data, slave device data and outgoing frame buffer for a
  * group.
@@ -908,7 +1881,9 @@ void clm_iefb_reflect_group_parameters (clm_t * clm, clm_group_data_t * group_da
    uint16_t slave_device_index = 0;
    const clm_group_setting_t * group_setting =
       &clm->config.hier.groups[group_data->group_index];
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
+   uint8_t * active_buffer;
+   uint8_t * staging_buffer;
 
    /* Update group data
       Note: group_data->group_index and ->group_state are already set */
@@ -917,6 +1892,10 @@ void clm_iefb_reflect_group_parameters (clm_t * clm, clm_group_data_t * group_da
    group_data->cyclic_transmission_state =
       CL_CCIEFB_CYCLIC_REQ_DATA_HEADER_CYCLIC_TR_STATE_ALL_OFF;
 
+   /* The request frame is initialised below */
+   group_data->dirty_outputs =
+      clm_iefb_calc_station_mask (0, group_data->total_occupied);
+
    /* Update slave device data (for all devices in group) */
    for (slave_device_index = 0;
         slave_device_index < group_setting->num_slave_devices;
@@ -932,9 +1911,13 @@ void clm_iefb_reflect_group_parameters (clm_t * clm, clm_group_data_t * group_da
       CC_ASSERT (result == 0);
    }
 
-   /* Prepare the request frame for this group */
+   /* Prepare the request frame for this group. With double buffered
+      outputs, the active frame might use any of the two buffers. */
+   active_buffer = (group_data->req_frame.buffer != NULL)
+                      ? group_data->req_frame.buffer
+                      : group_data->sendbuf;
    cl_iefb_initialise_request_frame (
-      group_data->sendbuf,
+      active_buffer,
       sizeof (group_data->sendbuf),
       clm->config.protocol_ver,
       group_setting->timeout_value,
@@ -947,6 +1930,29 @@ void clm_iefb_reflect_group_parameters (clm_t * clm, clm_group_data_t * group_da
    clm_iefb_initialise_request_slave_ids (
       group_data->req_frame.first_slave_id,
       group_setting);
+
+   /* The inactive frame is initialised the same way, as the number of
+      occupied stations and the slave IDs might have changed. */
+   if (clm->config.use_double_buffered_outputs)
+   {
+      staging_buffer = (group_data->staging_req_frame.buffer != NULL)
+                          ? group_data->staging_req_frame.buffer
+                          : group_data->staging_sendbuf;
+      cl_iefb_initialise_request_frame (
+         staging_buffer,
+         sizeof (group_data->staging_sendbuf),
+         clm->config.protocol_ver,
+         group_setting->timeout_value,
+         group_setting->parallel_off_timeout_count,
+         clm->config.master_id,
+         group_data->group_index + 1,
+         group_data->total_occupied,
+         clm->parameter_no,
+         &group_data->staging_req_frame);
+      clm_iefb_initialise_request_slave_ids (
+         group_data->staging_req_frame.first_slave_id,
+         group_setting);
+   }
 }
 
 /*********************** Device state machine *****************************/
@@ -970,7 +1976,7 @@ static clm_device_event_t clm_iefb_device_init (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event,
    clm_device_state_t new_state)
 {
@@ -980,12 +1986,14 @@ static clm_device_event_t clm_iefb_device_init (
       &clm->config.hier.groups[group_data->group_index];
    const clm_slave_device_setting_t * slave_device_setting =
       &group_setting->slave_devices[slave_device_data->device_index];
+   clm_slave_device_data_t * device_details =
+      &group_data->device_details[slave_device_data->device_index];
 
    slave_device_data->enabled = !slave_device_setting->reserved_slave_device;
    slave_device_data->transmission_bit = false;
 
-   clm_iefb_statistics_clear (&slave_device_data->statistics);
-   clm_iefb_latest_received_clear (&slave_device_data->latest_frame);
+   clm_iefb_statistics_clear (&device_details->statistics);
+   clm_iefb_latest_received_clear (&device_details->latest_frame);
 
    slave_device_data->timeout_count = 0;
 
@@ -1020,7 +2028,7 @@ static clm_device_event_t clm_iefb_set_data_ip (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event,
    clm_device_state_t new_state)
 {
@@ -1029,12 +2037,14 @@ static clm_device_event_t clm_iefb_set_data_ip (
       &clm->config.hier.groups[group_data->group_index];
    clm_slave_device_setting_t * slave_device_setting =
       &group_setting->slave_devices[slave_device_data->device_index];
+   clm_slave_device_statistics_t * statistics =
+      &group_data->device_details[slave_device_data->device_index].statistics;
 
    if (new_state == CLM_DEVICE_STATE_CYCLIC_SENDING)
    {
       if (!slave_device_data->transmission_bit)
       {
-         slave_device_data->statistics.number_of_connects++;
+         statistics->number_of_connects++;
          clm_iefb_trigger_connect_callback (clm, group_data, slave_device_data);
       }
       slave_device_data->transmission_bit = true;
@@ -1043,7 +2053,7 @@ static clm_device_event_t clm_iefb_set_data_ip (
    {
       if (slave_device_data->transmission_bit)
       {
-         slave_device_data->statistics.number_of_disconnects++;
+         statistics->number_of_disconnects++;
          clm_iefb_trigger_disconnect_callback (clm, group_data, slave_device_data);
       }
       slave_device_data->transmission_bit = false;
@@ -1068,14 +2078,17 @@ static clm_device_event_t clm_iefb_set_data_ip (
    /* Set cyclic data */
    clm_iefb_update_request_frame_cyclic_data_one_device (
       &group_data->req_frame,
-      &group_data->memory_area,
+      clm->config.use_double_buffered_outputs ? NULL
+                                              : &group_data->memory_area,
+      clm_iefb_is_output_tracking_used (clm) ? &group_data->dirty_outputs
+                                             : NULL,
       slave_device_data->slave_station_no,
       slave_device_setting->num_occupied_stations,
       combined_transmission_bit);
 
    if (slave_device_data->enabled)
    {
-      slave_device_data->statistics.number_of_sent_frames++;
+      statistics->number_of_sent_frames++;
    }
 
    return CLM_DEVICE_EVENT_NONE;
@@ -1103,17 +2116,20 @@ static clm_device_event_t clm_iefb_evaluate_timeoutcounter (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event,
    clm_device_state_t new_state)
 {
    clm_group_setting_t * group_setting =
       &clm->config.hier.groups[group_data->group_index];
 
+   clm_slave_device_statistics_t * statistics =
+      &group_data->device_details[slave_device_data->device_index].statistics;
+
    slave_device_data->timeout_count++;
    if (slave_device_data->timeout_count >= group_setting->parallel_off_timeout_count)
    {
-      slave_device_data->statistics.number_of_timeouts++;
+      statistics->number_of_timeouts++;
       return CLM_DEVICE_EVENT_TIMEOUTCOUNTER_FULL;
    }
 
@@ -1137,7 +2153,7 @@ static clm_device_event_t clm_iefb_reset_timeout_count (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event,
    clm_device_state_t new_state)
 {
@@ -1206,7 +2222,7 @@ void clm_iefb_device_fsm_event (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event)
 {
    if (event == CLM_DEVICE_EVENT_LAST)
@@ -1279,6 +2295,8 @@ void clm_iefb_device_fsm_event (
             slave_device_data->device_state);
       }
    } while (event != CLM_DEVICE_EVENT_NONE);
+
+   clm_iefb_update_awaiting_responses (group_data, slave_device_data);
 }
 
 /**
@@ -1296,7 +2314,7 @@ static void clm_iefb_device_fsm_event_all_in_group (
    clm_device_event_t event)
 {
    uint16_t slave_device_index = 0;
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
    const clm_group_setting_t * group_setting =
       &clm->config.hier.groups[group_data->group_index];
 
@@ -1353,44 +2371,116 @@ void clm_iefb_device_fsm_tables_init (clm_t * clm)
 /*********************** Group state machine ****************************/
 
 /**
- * Initialise the group.
- *
- * Also known as InitMaster() [for the group] in the specification.
- *
- * This is a callback for the group state machine.
+ * Get the timer for a timer id in the master timer heap
  *
  * @param clm                    c-link master stack instance handle
- * @param now                    Current timestamp, in microseconds
- * @param group_data             Group data
- * @param event                  Triggering event
- * @param new_state              State we are about to enter
- * @return Next event to trigger
- *
- * @req REQ_CLM_STATUSBIT_05
+ * @param timer_id               Timer id, see CLM_TIMER_ID_ARBITRATION
+ * @return Timer instance
  */
-static clm_group_event_t clm_iefb_group_init (
-   clm_t * clm,
-   uint32_t now,
-   clm_group_data_t * group_data,
-   clm_group_event_t event,
-   clm_group_state_t new_state)
+static cl_timer_t * clm_iefb_get_timer (clm_t * clm, uint16_t timer_id)
 {
-   uint16_t slave_device_index = 0;
-   const clm_group_setting_t * group_setting =
+   uint16_t group_index;
+
+   if (timer_id == CLM_TIMER_ID_ARBITRATION)
+   {
+      return &clm->arbitration_timer;
+   }
+
+   group_index = (timer_id - 1) / 2;
+   if (timer_id == CLM_TIMER_ID_RESPONSE_WAIT (group_index))
+   {
+      return &clm->groups[group_index].response_wait_timer;
+   }
+
+   return &clm->groups[group_index].constant_linkscan_timer;
+}
+
+/**
+ * Get the timer heap holding a timer
+ *
+ * The arbitration timer is always in the master timer heap. If sharding is
+ * enabled, the group timers are in the timer heap of the shard running
+ * the group.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param timer_id               Timer id, see CLM_TIMER_ID_ARBITRATION
+ * @return Timer heap
+ */
+static cl_timer_heap_t * clm_iefb_get_timer_heap (
+   clm_t * clm,
+   uint16_t timer_id)
+{
+   if (timer_id == CLM_TIMER_ID_ARBITRATION || !clm_iefb_is_sharded (clm))
+   {
+      return &clm->timer_heap;
+   }
+
+   return &clm_iefb_get_shard (clm, (timer_id - 1) / 2)->timer_heap;
+}
+
+/**
+ * Update the timer heap after a timer has been started or stopped
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param timer_id               Timer id, see CLM_TIMER_ID_ARBITRATION
+ */
+static void clm_iefb_schedule_timer (clm_t * clm, uint16_t timer_id)
+{
+   (void)cl_timer_heap_schedule (
+      clm_iefb_get_timer_heap (clm, timer_id),
+      timer_id,
+      clm_iefb_get_timer (clm, timer_id));
+}
+
+/**
+ * Initialise the group.
+ *
+ * Also known as InitMaster() [for the group] in the specification.
+ *
+ * This is a callback for the group state machine.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param now                    Current timestamp, in microseconds
+ * @param group_data             Group data
+ * @param event                  Triggering event
+ * @param new_state              State we are about to enter
+ * @return Next event to trigger
+ *
+ * @req REQ_CLM_STATUSBIT_05
+ */
+static clm_group_event_t clm_iefb_group_init (
+   clm_t * clm,
+   uint32_t now,
+   clm_group_data_t * group_data,
+   clm_group_event_t event,
+   clm_group_state_t new_state)
+{
+   uint16_t slave_device_index = 0;
+   const clm_group_setting_t * group_setting =
       &clm->config.hier.groups[group_data->group_index];
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
 
    /* Initialise timers */
    cl_timer_stop (&group_data->response_wait_timer);
    cl_timer_stop (&group_data->constant_linkscan_timer);
+   clm_iefb_schedule_timer (
+      clm,
+      CLM_TIMER_ID_RESPONSE_WAIT (group_data->group_index));
+   clm_iefb_schedule_timer (
+      clm,
+      CLM_TIMER_ID_CONSTANT_LINKSCAN (group_data->group_index));
 
    /* These will be updated when we get a new config */
    group_data->total_occupied            = 0;
    group_data->frame_sequence_no         = 0;
    group_data->timestamp_link_scan_start = 0;
+   group_data->timestamp_request_sent    = 0;
 
    group_data->cyclic_transmission_state =
       CL_CCIEFB_CYCLIC_REQ_DATA_HEADER_CYCLIC_TR_STATE_ALL_OFF;
+   group_data->awaiting_responses = 0;
+   group_data->responding_devices = 0;
+   group_data->missing_responses  = 0;
 
    /* Initialise state for each slave device */
    for (slave_device_index = 0;
@@ -1443,6 +2533,7 @@ static clm_group_event_t clm_iefb_group_new_config (
       &clm->arbitration_timer,
       clm->config.arbitration_time * CL_TIMER_MICROSECONDS_PER_MILLISECOND,
       now);
+   clm_iefb_schedule_timer (clm, CLM_TIMER_ID_ARBITRATION);
 
    return CLM_GROUP_EVENT_NONE;
 }
@@ -1472,8 +2563,9 @@ static clm_group_event_t clm_iefb_on_arbitration_failed (
       "other master.\n",
       __LINE__);
 
-   clm_iefb_trigger_error_callback (
+   clm_iefb_trigger_group_error_callback (
       clm,
+      group_data->group_index,
       now,
       CLM_ERROR_ARBITRATION_FAILED,
       clm->latest_conflicting_master_ip,
@@ -1537,9 +2629,18 @@ static clm_group_event_t clm_iefb_on_linkscan_start (
    uint16_t slave_device_index     = 0;
    clm_device_event_t device_event = CLM_DEVICE_EVENT_NONE;
    uint64_t unix_timestamp_ms      = clal_get_unix_timestamp_ms();
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
    const clm_group_setting_t * group_setting =
       &clm->config.hier.groups[group_data->group_index];
+   clm_send_queue_t * queue =
+      clm_iefb_get_send_queue (clm, group_data->group_index);
+
+   /* The previous request frame for this group must be sent before the
+      frame buffer is updated */
+   if (clm_iefb_is_request_frame_queued (queue, group_data))
+   {
+      (void)clm_iefb_send_queued_request_frames (clm, queue);
+   }
 
    /* Tell slave device representations to update outgoing frame */
    for (slave_device_index = 0;
@@ -1559,19 +2660,21 @@ static clm_group_event_t clm_iefb_on_linkscan_start (
    }
 
    group_data->timestamp_link_scan_start = now;
+   group_data->timestamp_request_sent    = now;
 
-   clm_iefb_send_cyclic_request_frame (
-      clm->cciefb_socket,
-      clm->iefb_broadcast_ip,
+   (void)clm_iefb_send_cyclic_request_frame (
+      clm,
       group_data,
       now,
-      unix_timestamp_ms,
-      clm->master_local_unit_info);
+      unix_timestamp_ms);
 
    cl_timer_start (
       &group_data->response_wait_timer,
       group_setting->timeout_value * CL_TIMER_MICROSECONDS_PER_MILLISECOND,
       now);
+   clm_iefb_schedule_timer (
+      clm,
+      CLM_TIMER_ID_RESPONSE_WAIT (group_data->group_index));
 
    if (group_setting->use_constant_link_scan_time)
    {
@@ -1579,6 +2682,9 @@ static clm_group_event_t clm_iefb_on_linkscan_start (
          &group_data->constant_linkscan_timer,
          group_setting->timeout_value * CL_TIMER_MICROSECONDS_PER_MILLISECOND,
          now);
+      clm_iefb_schedule_timer (
+         clm,
+         CLM_TIMER_ID_CONSTANT_LINKSCAN (group_data->group_index));
    }
 
    return CLM_GROUP_EVENT_NONE;
@@ -1605,6 +2711,9 @@ static clm_group_event_t clm_iefb_on_linkscan_timeout (
    clm_group_event_t event,
    clm_group_state_t new_state)
 {
+   /* Keep track of the devices that did not respond, for the application */
+   group_data->missing_responses = group_data->awaiting_responses;
+
    clm_iefb_device_fsm_event_all_in_group (
       clm,
       now,
@@ -1642,6 +2751,10 @@ static clm_group_event_t clm_iefb_on_linkscan_complete (
       &clm->config.hier.groups[group_data->group_index];
 
    cl_timer_stop (&group_data->response_wait_timer);
+   clm_iefb_schedule_timer (
+      clm,
+      CLM_TIMER_ID_RESPONSE_WAIT (group_data->group_index));
+   group_data->missing_responses = 0;
 
    clm_iefb_device_fsm_event_all_in_group (
       clm,
@@ -1683,15 +2796,23 @@ static clm_group_event_t clm_iefb_group_on_entry_listen (
    clm_group_event_t event,
    clm_group_state_t new_state)
 {
-   /* Safe to be executed from more than one group */
-   cl_timer_stop (&clm->arbitration_timer);
+   /* Safe to be executed from more than one group. If sharding is enabled
+      the timer is stopped by clm_iefb_group_fsm_event_all_shards() */
+   if (!clm_iefb_is_sharded (clm))
+   {
+      cl_timer_stop (&clm->arbitration_timer);
+      clm_iefb_schedule_timer (clm, CLM_TIMER_ID_ARBITRATION);
+   }
 
    clm_iefb_device_fsm_event_all_in_group (
       clm,
       now,
       group_data,
       CLM_DEVICE_EVENT_GROUP_STANDBY);
-   clm_iefb_set_master_state (clm, CLM_MASTER_STATE_STANDBY);
+   clm_iefb_set_master_state_from_group (
+      clm,
+      group_data,
+      CLM_MASTER_STATE_STANDBY);
 
    return CLM_GROUP_EVENT_NONE;
 }
@@ -1715,7 +2836,10 @@ static clm_group_event_t clm_iefb_group_on_entry_arbitration (
    clm_group_event_t event,
    clm_group_state_t new_state)
 {
-   clm_iefb_set_master_state (clm, CLM_MASTER_STATE_ARBITRATION);
+   clm_iefb_set_master_state_from_group (
+      clm,
+      group_data,
+      CLM_MASTER_STATE_ARBITRATION);
 
    return CLM_GROUP_EVENT_NONE;
 }
@@ -1739,7 +2863,10 @@ static clm_group_event_t clm_iefb_group_on_entry_scan_complete (
    clm_group_event_t event,
    clm_group_state_t new_state)
 {
-   clm_iefb_set_master_state (clm, CLM_MASTER_STATE_RUNNING);
+   clm_iefb_set_master_state_from_group (
+      clm,
+      group_data,
+      CLM_MASTER_STATE_RUNNING);
 
    return CLM_GROUP_EVENT_NONE;
 }
@@ -1879,6 +3006,73 @@ static void clm_iefb_group_fsm_event_all (
    }
 }
 
+/**
+ * Queue a group event to a shard.
+ *
+ * Called by the thread running clm_iefb_periodic(). The event is dropped
+ * if the queue is full.
+ *
+ * @param shard                  Shard instance
+ * @param event                  Event to queue
+ */
+static void clm_iefb_post_shard_event (
+   clm_shard_t * shard,
+   clm_group_event_t event)
+{
+   if (
+      shard->event_write_count - shard->event_read_count >=
+      CLM_SHARD_EVENT_QUEUE_SIZE)
+   {
+      shard->queue_overflows++;
+      return;
+   }
+
+   shard->events[shard->event_write_count & (CLM_SHARD_EVENT_QUEUE_SIZE - 1)] =
+      event;
+
+   /* The event must be visible before the shard sees the updated count */
+   clal_memory_barrier();
+   shard->event_write_count++;
+}
+
+/**
+ * Trigger an event in the state machines of all groups, after
+ * initialisation.
+ *
+ * If sharding is enabled the event is queued to all shards, and the
+ * groups handle it in the threads running the shards. The arbitration
+ * timer is then stopped here, as the groups lose the arbitration.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param now                    Current timestamp, in microseconds
+ * @param event                  Triggering event
+ */
+static void clm_iefb_group_fsm_event_all_shards (
+   clm_t * clm,
+   uint32_t now,
+   clm_group_event_t event)
+{
+   uint16_t shard_index;
+
+   if (!clm_iefb_is_sharded (clm))
+   {
+      clm_iefb_group_fsm_event_all (clm, now, event);
+      return;
+   }
+
+   if (event == CLM_GROUP_EVENT_REQ_FROM_OTHER)
+   {
+      cl_timer_stop (&clm->arbitration_timer);
+      clm_iefb_schedule_timer (clm, CLM_TIMER_ID_ARBITRATION);
+   }
+
+   for (shard_index = 0; shard_index < clm->config.number_of_shards;
+        shard_index++)
+   {
+      clm_iefb_post_shard_event (&clm->shards[shard_index], event);
+   }
+}
+
 /**
  * Initialise the group state machine tables.
  *
@@ -1923,44 +3117,75 @@ void clm_iefb_group_fsm_tables_init (clm_t * clm)
 /**************************************************************************/
 
 /**
- * Run timer events for all timers located in groups
+ * Run timer events for the expired state machine timers in a timer heap
+ *
+ * Only the timers at the top of the timer heap are checked. Each timer
+ * triggers at most one event per call, also if the event restarts it.
  *
  * @param clm                    c-link master stack instance handle
  * @param now                    Current timestamp, in microseconds
+ * @param heap                   Timer heap
  */
-void clm_iefb_monitor_all_group_timers (clm_t * clm, uint32_t now)
+static void clm_iefb_monitor_timer_heap (
+   clm_t * clm,
+   uint32_t now,
+   cl_timer_heap_t * heap)
 {
-   uint16_t group_index = 0;
+   uint16_t expired[CLM_NUMBER_OF_TIMER_IDS];
+   uint16_t number_of_expired = 0;
+   uint16_t timer_id          = 0;
+   uint16_t i                 = 0;
+   cl_timer_t * timer;
    clm_group_data_t * group_data;
 
-   for (group_index = 0; group_index < clm->config.hier.number_of_groups;
-        group_index++)
+   /* Collect the expired timers before triggering any events, as the
+      events might restart the timers */
+   while (cl_timer_heap_peek (heap, &timer_id) &&
+          cl_timer_is_expired (clm_iefb_get_timer (clm, timer_id), now))
    {
-      group_data = &clm->groups[group_index];
+      cl_timer_heap_remove (heap, timer_id);
+      expired[number_of_expired] = timer_id;
+      number_of_expired++;
+   }
+
+   for (i = 0; i < number_of_expired; i++)
+   {
+      timer_id = expired[i];
+      timer    = clm_iefb_get_timer (clm, timer_id);
 
-      if (cl_timer_is_expired (&group_data->response_wait_timer, now))
+      /* Might have been stopped or restarted by an earlier event */
+      if (!cl_timer_is_expired (timer, now))
       {
-         cl_timer_stop (&group_data->response_wait_timer);
-         clm_iefb_group_fsm_event (
-            clm,
-            now,
-            group_data,
-            CLM_GROUP_EVENT_LINKSCAN_TIMEOUT);
+         continue;
       }
+      cl_timer_stop (timer);
+      clm_iefb_schedule_timer (clm, timer_id);
 
-      if (cl_timer_is_expired (&group_data->constant_linkscan_timer, now))
+      if (timer_id == CLM_TIMER_ID_ARBITRATION)
       {
-         cl_timer_stop (&group_data->constant_linkscan_timer);
-
-         clm_iefb_group_fsm_event (
+         clm_iefb_group_fsm_event_all_shards (
             clm,
             now,
-            group_data,
-            CLM_GROUP_EVENT_LINKSCAN_START);
+            CLM_GROUP_EVENT_ARBITRATION_DONE);
+         continue;
       }
+
+      group_data = &clm->groups[(timer_id - 1) / 2];
+      clm_iefb_group_fsm_event (
+         clm,
+         now,
+         group_data,
+         (timer_id == CLM_TIMER_ID_RESPONSE_WAIT (group_data->group_index))
+            ? CLM_GROUP_EVENT_LINKSCAN_TIMEOUT
+            : CLM_GROUP_EVENT_LINKSCAN_START);
    }
 }
 
+void clm_iefb_monitor_timers (clm_t * clm, uint32_t now)
+{
+   clm_iefb_monitor_timer_heap (clm, now, &clm->timer_heap);
+}
+
 /**
  * Handle that the configuration has been updated.
  *
@@ -1990,6 +3215,7 @@ static void clm_iefb_handle_new_config (clm_t * clm, uint32_t now)
       &temporary_buffer,
       sizeof (clm->parameter_no));
 
+   clm_iefb_build_slave_index (clm);
    clm_iefb_group_fsm_event_all (clm, now, CLM_GROUP_EVENT_NEW_CONFIG);
 }
 
@@ -2002,6 +3228,9 @@ static void clm_iefb_handle_new_config (clm_t * clm, uint32_t now)
  *
  * @param clm                    c-link master stack instance handle
  * @param now                    Current timestamp, in microseconds
+ * @param port_timestamp         Timestamp from the port when the frame was
+ *                               received, in microseconds
+ * @param port_timestamp_valid   True if \a port_timestamp is available
  * @param buffer                 Buffer to be parsed
  * @param recv_len               UDP payload length
  * @param remote_ip              Remote source IP address
@@ -2027,6 +3256,8 @@ static void clm_iefb_handle_new_config (clm_t * clm, uint32_t now)
 static int clm_iefb_handle_response_frame (
    clm_t * clm,
    uint32_t now,
+   uint32_t port_timestamp,
+   bool port_timestamp_valid,
    uint8_t * buffer,
    size_t recv_len,
    cl_ipaddr_t remote_ip,
@@ -2043,8 +3274,12 @@ static int clm_iefb_handle_response_frame (
    const clm_group_setting_t * group_setting;
    clm_group_data_t * group_data;
    const clm_slave_device_setting_t * slave_device_setting;
-   clm_slave_device_data_t * slave_device_data;
+   const clm_slave_index_entry_t * index_entry;
+   clm_slave_device_hot_t * slave_device_data;
+   clm_slave_device_data_t * device_details;
+   clm_slave_device_statistics_t * statistics;
    clm_device_framevalues_t * latest;
+   cl_changed_signals_t changed_inputs;
 
    if (clm->config.master_id == CL_IPADDR_INVALID)
    {
@@ -2059,6 +3294,7 @@ static int clm_iefb_handle_response_frame (
          remote_ip,
          remote_port,
          now,
+         clm_iefb_find_response_template (clm, buffer, recv_len),
          &cyclic_response) != 0)
    {
       return -1;
@@ -2080,25 +3316,29 @@ static int clm_iefb_handle_response_frame (
 
    /* Find slave_device_index from IP address, and validate group
     * REQ_CLM_GROUPS_02 */
-   if (clm_iefb_calc_slave_device_index (group_setting, remote_ip, &slave_device_index) != 0)
+   index_entry = clm_iefb_find_slave (clm, remote_ip);
+   if (index_entry == NULL || index_entry->group_index != group_index)
    {
       /* The given IP address does not exist in the given group. Drop frame */
       return -1;
    }
+   slave_device_index = index_entry->device_index;
 
    cyclic_response.device_index = slave_device_index;
    slave_device_data    = &group_data->slave_devices[slave_device_index];
-   latest               = &slave_device_data->latest_frame;
    slave_device_setting = &group_setting->slave_devices[slave_device_index];
+   device_details       = &group_data->device_details[slave_device_index];
+   statistics           = &device_details->statistics;
+   latest               = &device_details->latest_frame;
 
-   slave_device_data->statistics.number_of_incoming_frames++;
+   statistics->number_of_incoming_frames++;
 
    /* Validate that the response is from an enabled slave */
    if (slave_device_data->enabled == false)
    {
       /* We have disabled the slave, but it sends anyway. Drop frame.
          REQ_CLM_COMMUNIC_02 */
-      slave_device_data->statistics.number_of_incoming_invalid_frames++;
+      statistics->number_of_incoming_invalid_frames++;
       return -1;
    }
 
@@ -2112,9 +3352,10 @@ static int clm_iefb_handle_response_frame (
       frame_sequence_no == latest->frame_sequence_no &&
       slave_device_data->device_state != CLM_DEVICE_STATE_LISTEN)
    {
-      slave_device_data->statistics.number_of_incoming_invalid_frames++;
-      clm_iefb_trigger_error_callback (
+      statistics->number_of_incoming_invalid_frames++;
+      clm_iefb_trigger_group_error_callback (
          clm,
+         group_index,
          now,
          CLM_ERROR_SLAVE_DUPLICATION,
          remote_ip,
@@ -2134,7 +3375,7 @@ static int clm_iefb_handle_response_frame (
    if (slave_device_data->transmission_bit && frame_sequence_no != group_data->frame_sequence_no)
    {
       /* Wrong frame sequence number. Drop frame. */
-      slave_device_data->statistics.number_of_incoming_invalid_frames++;
+      statistics->number_of_incoming_invalid_frames++;
       return -1;
    }
 
@@ -2147,9 +3388,10 @@ static int clm_iefb_handle_response_frame (
 
    if (end_code == CL_SLMP_ENDCODE_CCIEFB_WRONG_NUMBER_OCCUPIED_STATIONS)
    {
-      slave_device_data->statistics.number_of_incoming_alarm_frames++;
-      clm_iefb_trigger_error_callback (
+      statistics->number_of_incoming_alarm_frames++;
+      clm_iefb_trigger_group_error_callback (
          clm,
+         group_index,
          now,
          CLM_ERROR_SLAVE_REPORTS_WRONG_NUMBER_OCCUPIED,
          remote_ip,
@@ -2158,9 +3400,10 @@ static int clm_iefb_handle_response_frame (
 
    if (end_code == CL_SLMP_ENDCODE_CCIEFB_MASTER_DUPLICATION)
    {
-      slave_device_data->statistics.number_of_incoming_alarm_frames++;
-      clm_iefb_trigger_error_callback (
+      statistics->number_of_incoming_alarm_frames++;
+      clm_iefb_trigger_group_error_callback (
          clm,
+         group_index,
          now,
          CLM_ERROR_SLAVE_REPORTS_MASTER_DUPLICATION,
          remote_ip,
@@ -2173,7 +3416,7 @@ static int clm_iefb_handle_response_frame (
    {
       /* Device sends response with wrong number of occupied stations, drop
        * frame. REQ_CLM_ERROR_02. Device will be disconnected due to timeout. */
-      slave_device_data->statistics.number_of_incoming_invalid_frames++;
+      statistics->number_of_incoming_invalid_frames++;
       return -1;
    }
 
@@ -2181,7 +3424,7 @@ static int clm_iefb_handle_response_frame (
       end_code == CL_SLMP_ENDCODE_CCIEFB_SLAVE_ERROR ||
       end_code == CL_SLMP_ENDCODE_CCIEFB_SLAVE_REQUESTS_DISCONNECT)
    {
-      slave_device_data->statistics.number_of_incoming_alarm_frames++;
+      statistics->number_of_incoming_alarm_frames++;
 
       /* Trigger 'alarm frame' callback to application, if it changed
          (even if there is no previously received frame) */
@@ -2215,24 +3458,43 @@ static int clm_iefb_handle_response_frame (
    /* Store incoming frame details, statistics and cyclic data */
    clm_iefb_store_incoming_slave_runtime_info (
       &cyclic_response,
-      group_data->timestamp_link_scan_start,
-      &slave_device_data->latest_frame);
+      clm_iefb_calc_response_time (
+         group_data,
+         now,
+         port_timestamp,
+         port_timestamp_valid),
+      latest);
 
    clm_iefb_statistics_update_response_time (
-      &slave_device_data->statistics,
+      statistics,
       clm->config.max_statistics_samples,
-      slave_device_data->latest_frame.response_time);
-
-   clm_iefb_store_incoming_cyclic_data (
-      &group_data->memory_area,
-      &cyclic_response,
-      slave_device_data->slave_station_no,
-      slave_device_setting->num_occupied_stations,
-      slave_device_data->transmission_bit);
+      latest->response_time);
+
+   if (clm_iefb_store_incoming_cyclic_data (
+          group_data,
+          &cyclic_response,
+          slave_device_data->slave_station_no,
+          slave_device_setting->num_occupied_stations,
+          slave_device_data->transmission_bit,
+          &changed_inputs))
+   {
+      clm_iefb_trigger_inputs_changed_callback (
+         clm,
+         group_index,
+         slave_device_index,
+         &changed_inputs);
+   }
 
    /* Trigger state machine event */
    if (end_code == CL_SLMP_ENDCODE_CCIEFB_MASTER_DUPLICATION)
    {
+      if (clm_iefb_is_sharded (clm))
+      {
+         /* Forwarded to all groups by clm_iefb_monitor_shards() */
+         clm_iefb_get_shard (clm, group_index)->masterdupl_alarm_count++;
+         return 0;
+      }
+
       clm_iefb_group_fsm_event_all (clm, now, CLM_GROUP_EVENT_MASTERDUPL_ALARM);
       return 0;
    }
@@ -2242,7 +3504,7 @@ static int clm_iefb_handle_response_frame (
               : CLM_DEVICE_EVENT_RECEIVE_ERROR;
    clm_iefb_device_fsm_event (clm, now, group_data, slave_device_data, event);
 
-   if (clm_iefb_group_have_received_from_all_devices (group_setting, group_data))
+   if (clm_iefb_group_have_received_from_all_devices (group_data))
    {
       clm_iefb_group_fsm_event (
          clm,
@@ -2293,7 +3555,88 @@ static int clm_iefb_handle_request_frame (
 #endif
 
    clm->latest_conflicting_master_ip = remote_ip;
-   clm_iefb_group_fsm_event_all (clm, now, CLM_GROUP_EVENT_REQ_FROM_OTHER);
+   clm_iefb_group_fsm_event_all_shards (
+      clm,
+      now,
+      CLM_GROUP_EVENT_REQ_FROM_OTHER);
+
+   return 0;
+}
+
+/**
+ * Queue an incoming CCIEFB response frame to the shard running the group.
+ *
+ * Only the group number is checked here. The frame is validated and
+ * handled by the thread running the shard, see clm_iefb_shard_periodic().
+ *
+ * @param clm                  c-link master stack instance handle
+ * @param port_timestamp       Timestamp from the port when the frame was
+ *                             received, in microseconds
+ * @param port_timestamp_valid True if \a port_timestamp is available
+ * @param buffer               Input buffer
+ * @param recv_len             UDP payload length
+ * @param remote_ip            Remote IP address
+ * @param remote_port          Remote UDP port number
+ * @return 0 on success, -1 on failure
+ */
+static int clm_iefb_steer_response_frame (
+   clm_t * clm,
+   uint32_t port_timestamp,
+   bool port_timestamp_valid,
+   const uint8_t * buffer,
+   size_t recv_len,
+   cl_ipaddr_t remote_ip,
+   uint16_t remote_port)
+{
+   const cl_cciefb_cyclic_resp_full_headers_t * full_headers;
+   clm_shard_frame_t * frame;
+   clm_shard_t * shard;
+   uint16_t group_no;
+
+   if (
+      recv_len < sizeof (cl_cciefb_cyclic_resp_full_headers_t) ||
+      recv_len > sizeof (frame->buffer))
+   {
+      return -1;
+   }
+
+   full_headers = (const cl_cciefb_cyclic_resp_full_headers_t *)buffer;
+   group_no     = full_headers->cyclic_data_header.group_no;
+   if (group_no == 0 || group_no > clm->config.hier.number_of_groups)
+   {
+      /* Invalid group number. Drop frame. */
+      return -1;
+   }
+
+   shard = clm_iefb_get_shard (clm, group_no - 1);
+   if (
+      shard->frame_write_count - shard->frame_read_count >=
+      CLM_SHARD_FRAME_QUEUE_SIZE)
+   {
+      /* The shard has fallen behind. Drop the frame, so that the frames
+         for the other shards still are received. */
+      LOG_DEBUG (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Frame queue full for group number %u. Dropping "
+         "frame.\n",
+         __LINE__,
+         group_no);
+      shard->queue_overflows++;
+      return -1;
+   }
+
+   frame = &shard->frames
+               [shard->frame_write_count & (CLM_SHARD_FRAME_QUEUE_SIZE - 1)];
+   frame->port_timestamp       = port_timestamp;
+   frame->port_timestamp_valid = port_timestamp_valid;
+   frame->remote_ip            = remote_ip;
+   frame->remote_port          = remote_port;
+   frame->len                  = (uint16_t)recv_len;
+   clal_memcpy (frame->buffer, sizeof (frame->buffer), buffer, recv_len);
+
+   /* The frame must be visible before the shard sees the updated count */
+   clal_memory_barrier();
+   shard->frame_write_count++;
 
    return 0;
 }
@@ -2301,12 +3644,15 @@ static int clm_iefb_handle_request_frame (
 /**
  * Handle incoming CCIEFB frame
  *
- * @param clm              c-link master stack instance handle
- * @param now              Timestamp in microseconds
- * @param buffer           Input buffer
- * @param recv_len         UDP payload length
- * @param remote_ip        Remote IP address
- * @param remote_port      Remote UDP port number
+ * @param clm                  c-link master stack instance handle
+ * @param now                  Timestamp in microseconds
+ * @param port_timestamp       Timestamp from the port when the frame was
+ *                             received, in microseconds
+ * @param port_timestamp_valid True if \a port_timestamp is available
+ * @param buffer               Input buffer
+ * @param recv_len             UDP payload length
+ * @param remote_ip            Remote IP address
+ * @param remote_port          Remote UDP port number
  *
  * @return 0 on success, -1 on failure
  */
@@ -2317,6 +3663,8 @@ static
    clm_iefb_handle_input_frame (
       clm_t * clm,
       uint32_t now,
+      uint32_t port_timestamp,
+      bool port_timestamp_valid,
       uint8_t * buffer,
       size_t recv_len,
       cl_ipaddr_t remote_ip,
@@ -2365,9 +3713,23 @@ static
          remote_port);
    }
 
+   if (clm_iefb_is_sharded (clm))
+   {
+      return clm_iefb_steer_response_frame (
+         clm,
+         port_timestamp,
+         port_timestamp_valid,
+         buffer,
+         recv_len,
+         remote_ip,
+         remote_port);
+   }
+
    return clm_iefb_handle_response_frame (
       clm,
       now,
+      port_timestamp,
+      port_timestamp_valid,
       buffer,
       recv_len,
       remote_ip,
@@ -2387,14 +3749,14 @@ static
  * @return Number of occupied stations, or 0 failure
  */
 static uint16_t clm_iefb_get_occupied_and_position (
-   clm_t * clm,
+   const clm_t * clm,
    uint16_t group_index,
    uint16_t slave_device_index,
    uint16_t * position)
 {
    const clm_group_setting_t * group_setting;
    const clm_slave_device_setting_t * slave_device_setting;
-   const clm_slave_device_data_t * slave_device_data;
+   const clm_slave_device_hot_t * slave_device_data;
 
    if (group_index >= clm->config.hier.number_of_groups)
    {
@@ -2415,6 +3777,64 @@ static uint16_t clm_iefb_get_occupied_and_position (
    return slave_device_setting->num_occupied_stations;
 }
 
+/**
+ * Copy incoming cyclic data (RX and RWr) for some slave stations in a group,
+ * without being disturbed by the stack updating the data.
+ *
+ * Uses the input sequence counter of the group (a seqlock). The copy is
+ * retried if the counter was odd (update in progress) or changed during
+ * the copy.
+ *
+ * @param group_data             Group data
+ * @param first_index            First slave station index, which is
+ *                               slave_station_no - 1
+ * @param num_occupied_stations  Number of slave stations to copy
+ * @param snapshot               Resulting snapshot
+ * @return 0 on success, -1 if no consistent copy could be made within
+ *         CLM_INPUT_SNAPSHOT_MAX_ATTEMPTS attempts.
+ */
+static int clm_iefb_copy_input_snapshot (
+   const clm_group_data_t * group_data,
+   uint16_t first_index,
+   uint16_t num_occupied_stations,
+   clm_input_snapshot_t * snapshot)
+{
+   const size_t num_rwr_bytes = num_occupied_stations * sizeof (cl_rwr_t);
+   const size_t num_rx_bytes  = num_occupied_stations * sizeof (cl_rx_t);
+   uint16_t attempt           = 0;
+   uint32_t sequence          = 0;
+
+   for (attempt = 0; attempt < CLM_INPUT_SNAPSHOT_MAX_ATTEMPTS; attempt++)
+   {
+      if (!clm_iefb_input_read_begin (group_data, &sequence))
+      {
+         continue;
+      }
+
+      clal_memcpy (
+         snapshot->rwr,
+         sizeof (snapshot->rwr),
+         &group_data->memory_area.rwr[first_index],
+         num_rwr_bytes);
+      clal_memcpy (
+         snapshot->rx,
+         sizeof (snapshot->rx),
+         &group_data->memory_area.rx[first_index],
+         num_rx_bytes);
+      snapshot->frame_sequence_no = group_data->input_frame_sequence_no;
+      snapshot->timestamp_link_scan_start =
+         group_data->input_timestamp_link_scan_start;
+
+      if (!clm_iefb_input_read_retry (group_data, sequence))
+      {
+         snapshot->num_occupied_stations = num_occupied_stations;
+         return 0;
+      }
+   }
+
+   return -1;
+}
+
 /******************** Public functions *******************************/
 
 const cl_rx_t * clm_iefb_get_first_rx_area (
@@ -2444,6 +3864,10 @@ cl_ry_t * clm_iefb_get_first_ry_area (
    }
 
    *total_occupied = clm->groups[group_index].total_occupied;
+   if (clm->config.use_double_buffered_outputs)
+   {
+      return clm->groups[group_index].staging_req_frame.first_ry;
+   }
    return (cl_ry_t *)&clm->groups[group_index].memory_area.ry;
 }
 
@@ -2474,6 +3898,10 @@ cl_rww_t * clm_iefb_get_first_rww_area (
    }
 
    *total_occupied = clm->groups[group_index].total_occupied;
+   if (clm->config.use_double_buffered_outputs)
+   {
+      return clm->groups[group_index].staging_req_frame.first_rww;
+   }
    return (cl_rww_t *)&clm->groups[group_index].memory_area.rww;
 }
 
@@ -2597,26 +4025,227 @@ cl_rww_t * clm_iefb_get_first_device_rww_area (
    return first_group_area + pos;
 }
 
-bool clm_iefb_get_rx_bit (
-   clm_t * clm,
-   uint16_t group_index,
-   uint16_t slave_device_index,
-   uint16_t number)
+int clm_iefb_publish_outputs (clm_t * clm, uint16_t group_index)
 {
-   uint16_t num_occupied_stations = 0;
-   uint8_t mask;
-   uint16_t byte_in_area;
-   uint16_t areanumber =
-      cl_iefb_bit_calculate_areanumber (number, &byte_in_area, &mask);
-   const cl_rx_t * first_area = clm_iefb_get_first_device_rx_area (
-      clm,
-      group_index,
-      slave_device_index,
-      &num_occupied_stations);
+   clm_group_data_t * group_data;
+   clm_cciefb_cyclic_request_info_t previous_frame;
+   size_t headers_size;
+   uint16_t ix;
 
-   /* Not possible to return error code to user */
-   CC_ASSERT (num_occupied_stations != 0);
-   CC_ASSERT (areanumber < num_occupied_stations);
+   if (
+      !clm->config.use_double_buffered_outputs ||
+      group_index >= clm->config.hier.number_of_groups)
+   {
+      return -1;
+   }
+
+   group_data = &clm->groups[group_index];
+   if (group_data->staging_req_frame.buffer == NULL)
+   {
+      return -1;
+   }
+
+   /* Swap the frames. No cyclic data is copied to the frame at link scan
+      start, only the headers are updated before sending. */
+   previous_frame                = group_data->req_frame;
+   group_data->req_frame         = group_data->staging_req_frame;
+   group_data->staging_req_frame = previous_frame;
+
+   /* Headers and slave IDs from the previously active frame */
+   headers_size = (size_t)((uint8_t *)previous_frame.first_rww -
+                           previous_frame.buffer);
+   clal_memcpy (
+      group_data->req_frame.buffer,
+      headers_size,
+      previous_frame.buffer,
+      headers_size);
+
+   /* Let the application continue from the published values. The frames
+      only differ for the stations written since the previous publish, and
+      for the stations zeroed by the stack in the previously active frame. */
+   for (ix = 0; ix < group_data->total_occupied; ix++)
+   {
+      if ((group_data->dirty_outputs & (1U << ix)) == 0)
+      {
+         continue;
+      }
+
+      clal_memcpy (
+         &previous_frame.first_rww[ix],
+         sizeof (cl_rww_t),
+         &group_data->req_frame.first_rww[ix],
+         sizeof (cl_rww_t));
+      clal_memcpy (
+         &previous_frame.first_ry[ix],
+         sizeof (cl_ry_t),
+         &group_data->req_frame.first_ry[ix],
+         sizeof (cl_ry_t));
+   }
+   group_data->dirty_outputs = 0;
+
+   return 0;
+}
+
+int clm_iefb_mark_outputs_dirty (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t first_area,
+   uint16_t num_areas)
+{
+   clm_group_data_t * group_data;
+
+   if (group_index >= clm->config.hier.number_of_groups)
+   {
+      return -1;
+   }
+
+   group_data = &clm->groups[group_index];
+   if (
+      num_areas > group_data->total_occupied ||
+      first_area > group_data->total_occupied - num_areas)
+   {
+      return -1;
+   }
+
+   if (clm_iefb_is_output_tracking_used (clm))
+   {
+      group_data->dirty_outputs |=
+         clm_iefb_calc_station_mask (first_area, num_areas);
+   }
+
+   return 0;
+}
+
+int clm_iefb_get_group_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   clm_input_snapshot_t * snapshot)
+{
+   const clm_group_data_t * group_data;
+
+   if (group_index >= clm->config.hier.number_of_groups)
+   {
+      return -1;
+   }
+
+   group_data = &clm->groups[group_index];
+
+   return clm_iefb_copy_input_snapshot (
+      group_data,
+      0,
+      group_data->total_occupied,
+      snapshot);
+}
+
+int clm_iefb_get_device_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_input_snapshot_t * snapshot)
+{
+   uint16_t pos      = 0;
+   uint16_t occupied = 0;
+
+   occupied = clm_iefb_get_occupied_and_position (
+      clm,
+      group_index,
+      slave_device_index,
+      &pos);
+   if (occupied == 0)
+   {
+      return -1;
+   }
+
+   return clm_iefb_copy_input_snapshot (
+      &clm->groups[group_index],
+      pos,
+      occupied,
+      snapshot);
+}
+
+int clm_iefb_get_changed_inputs (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   cl_changed_signals_t * changed)
+{
+   clm_group_data_t * group_data;
+   uint16_t pos      = 0;
+   uint16_t occupied = 0;
+   uint16_t i;
+
+   occupied = clm_iefb_get_occupied_and_position (
+      clm,
+      group_index,
+      slave_device_index,
+      &pos);
+   if (occupied == 0)
+   {
+      return -1;
+   }
+
+   group_data = &clm->groups[group_index];
+   clal_clear_memory (changed, sizeof (*changed));
+   changed->num_occupied_stations = occupied;
+   for (i = 0; i < occupied; i++)
+   {
+      changed->bits[i]                 = group_data->changed_rx[pos + i];
+      changed->words[i]                = group_data->changed_rwr[pos + i];
+      group_data->changed_rx[pos + i]  = 0;
+      group_data->changed_rwr[pos + i] = 0;
+   }
+
+   return 0;
+}
+
+/**
+ * Mark one RY and RWw memory area of a slave device as changed, if output
+ * dirty tracking or double buffered outputs are used.
+ *
+ * No validation is done on input parameters.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param areanumber             Memory area number for the device
+ */
+static void clm_iefb_mark_device_area_dirty (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t areanumber)
+{
+   clm_group_data_t * group_data = &clm->groups[group_index];
+   const uint16_t slave_station_no =
+      group_data->slave_devices[slave_device_index].slave_station_no;
+
+   if (clm_iefb_is_output_tracking_used (clm))
+   {
+      group_data->dirty_outputs |=
+         clm_iefb_calc_station_mask (slave_station_no - 1 + areanumber, 1);
+   }
+}
+
+bool clm_iefb_get_rx_bit (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t number)
+{
+   uint16_t num_occupied_stations = 0;
+   uint8_t mask;
+   uint16_t byte_in_area;
+   uint16_t areanumber =
+      cl_iefb_bit_calculate_areanumber (number, &byte_in_area, &mask);
+   const cl_rx_t * first_area = clm_iefb_get_first_device_rx_area (
+      clm,
+      group_index,
+      slave_device_index,
+      &num_occupied_stations);
+
+   /* Not possible to return error code to user */
+   CC_ASSERT (num_occupied_stations != 0);
+   CC_ASSERT (areanumber < num_occupied_stations);
 
    return ((first_area + areanumber)->bytes[byte_in_area] & mask) > 0;
 }
@@ -2651,6 +4280,12 @@ void clm_iefb_set_ry_bit (
    {
       (first_area + areanumber)->bytes[byte_in_area] &= ~mask;
    }
+
+   clm_iefb_mark_device_area_dirty (
+      clm,
+      group_index,
+      slave_device_index,
+      areanumber);
 }
 
 bool clm_iefb_get_ry_bit (
@@ -2722,6 +4357,12 @@ void clm_iefb_set_rww_value (
    CC_ASSERT (areanumber < num_occupied_stations);
 
    (first_area + areanumber)->words[register_in_area] = CC_TO_LE16 (value);
+
+   clm_iefb_mark_device_area_dirty (
+      clm,
+      group_index,
+      slave_device_index,
+      areanumber);
 }
 
 uint16_t clm_iefb_get_rww_value (
@@ -2747,6 +4388,158 @@ uint16_t clm_iefb_get_rww_value (
    return CC_FROM_LE16 ((first_area + areanumber)->words[register_in_area]);
 }
 
+int clm_iefb_get_rx_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values)
+{
+   uint16_t num_occupied_stations = 0;
+   const cl_rx_t * first_area     = clm_iefb_get_first_device_rx_area (
+      clm,
+      group_index,
+      slave_device_index,
+      &num_occupied_stations);
+
+   if (
+      first_area == NULL ||
+      !cl_iefb_is_signal_range_valid (
+         first_number,
+         num_bits,
+         (uint32_t)num_occupied_stations * CL_BITSIGNALS_PER_AREA))
+   {
+      return -1;
+   }
+
+   cl_iefb_unpack_bits (first_area->bytes, first_number, num_bits, values);
+
+   return 0;
+}
+
+int clm_iefb_set_ry_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values)
+{
+   uint16_t num_occupied_stations = 0;
+   uint16_t areanumber;
+   cl_ry_t * first_area = clm_iefb_get_first_device_ry_area (
+      clm,
+      group_index,
+      slave_device_index,
+      &num_occupied_stations);
+
+   if (
+      first_area == NULL ||
+      !cl_iefb_is_signal_range_valid (
+         first_number,
+         num_bits,
+         (uint32_t)num_occupied_stations * CL_BITSIGNALS_PER_AREA))
+   {
+      return -1;
+   }
+
+   cl_iefb_pack_bits (first_area->bytes, first_number, num_bits, values);
+
+   for (areanumber = first_number / CL_BITSIGNALS_PER_AREA;
+        areanumber * CL_BITSIGNALS_PER_AREA < first_number + num_bits;
+        areanumber++)
+   {
+      clm_iefb_mark_device_area_dirty (
+         clm,
+         group_index,
+         slave_device_index,
+         areanumber);
+   }
+
+   return 0;
+}
+
+int clm_iefb_get_rwr_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values)
+{
+   uint16_t num_occupied_stations = 0;
+   const cl_rwr_t * first_area    = clm_iefb_get_first_device_rwr_area (
+      clm,
+      group_index,
+      slave_device_index,
+      &num_occupied_stations);
+
+   if (
+      first_area == NULL ||
+      !cl_iefb_is_signal_range_valid (
+         first_number,
+         num_values,
+         (uint32_t)num_occupied_stations * CL_WORDSIGNALS_PER_AREA))
+   {
+      return -1;
+   }
+
+   cl_iefb_read_words (
+      (const uint8_t *)first_area->words,
+      first_number,
+      num_values,
+      values);
+
+   return 0;
+}
+
+int clm_iefb_set_rww_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values)
+{
+   uint16_t num_occupied_stations = 0;
+   uint16_t areanumber;
+   cl_rww_t * first_area = clm_iefb_get_first_device_rww_area (
+      clm,
+      group_index,
+      slave_device_index,
+      &num_occupied_stations);
+
+   if (
+      first_area == NULL ||
+      !cl_iefb_is_signal_range_valid (
+         first_number,
+         num_values,
+         (uint32_t)num_occupied_stations * CL_WORDSIGNALS_PER_AREA))
+   {
+      return -1;
+   }
+
+   cl_iefb_write_words (
+      (uint8_t *)first_area->words,
+      first_number,
+      num_values,
+      values);
+
+   for (areanumber = first_number / CL_WORDSIGNALS_PER_AREA;
+        areanumber * CL_WORDSIGNALS_PER_AREA < first_number + num_values;
+        areanumber++)
+   {
+      clm_iefb_mark_device_area_dirty (
+         clm,
+         group_index,
+         slave_device_index,
+         areanumber);
+   }
+
+   return 0;
+}
+
 void clm_iefb_set_master_application_status (
    clm_t * clm,
    bool running,
@@ -2779,7 +4572,7 @@ int clm_iefb_set_slave_communication_status (
 {
    const clm_group_setting_t * group_setting;
    clm_group_data_t * group_data;
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
 
    if (group_index >= clm->config.hier.number_of_groups)
    {
@@ -2817,7 +4610,7 @@ int clm_iefb_force_cyclic_transmission_bit (
 {
    const clm_group_setting_t * group_setting;
    clm_group_data_t * group_data;
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_hot_t * slave_device_data;
 
    if (group_index >= clm->config.hier.number_of_groups)
    {
@@ -2847,14 +4640,72 @@ int clm_iefb_force_cyclic_transmission_bit (
    return 0;
 }
 
+int clm_iefb_queue_shard_command (
+   clm_t * clm,
+   const clm_command_t * command,
+   bool confirm)
+{
+   clm_shard_t * shard;
+   clm_shard_command_t * entry;
+   uint32_t position;
+
+   if (
+      command->group_index >= clm->config.hier.number_of_groups ||
+      command->slave_device_index >=
+         clm->config.hier.groups[command->group_index].num_slave_devices)
+   {
+      return -1;
+   }
+
+   shard = clm_iefb_get_shard (clm, command->group_index);
+   if (cl_command_queue_reserve (&shard->command_queue, &position) != 0)
+   {
+      LOG_WARNING (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Command queue full for the shard running group index "
+         "%u.\n",
+         __LINE__,
+         command->group_index);
+      return -1;
+   }
+
+   entry          = &shard->commands[cl_command_queue_slot (position)];
+   entry->command = *command;
+   entry->confirm = confirm;
+   cl_command_queue_publish (&shard->command_queue, position);
+
+   return 0;
+}
+
 int clm_iefb_get_master_status (
    const clm_t * clm,
    clm_master_status_details_t * details)
 {
-   details->master_state          = clm->master_state;
-   details->node_search_serial    = clm->node_search_serial;
-   details->parameter_no          = clm->parameter_no;
-   details->set_ip_request_serial = clm->set_ip_request_serial;
+   uint16_t shard_index;
+
+   details->master_state                  = clm->master_state;
+   details->node_search_serial            = clm->node_search_serial;
+   details->parameter_no                  = clm->parameter_no;
+   details->set_ip_request_serial         = clm->set_ip_request_serial;
+   details->cciefb_socket_profile         = clm->cciefb_socket_profile;
+   details->arbitration_socket_profile    = clm->arbitration_socket_profile;
+   details->cciefb_socket_statistics      = clm->cciefb_socket_statistics;
+   details->arbitration_socket_statistics = clm->arbitration_socket_statistics;
+   details->shard_queue_overflows         = 0;
+   details->callback_queue_overflows      = clm->callback_queue.overflows;
+   details->coalesced_linkscan_callbacks =
+      clm->callback_queue.coalesced_linkscans;
+
+   for (shard_index = 0; shard_index < clm->config.number_of_shards;
+        shard_index++)
+   {
+      details->shard_queue_overflows +=
+         clm->shards[shard_index].queue_overflows;
+      details->callback_queue_overflows +=
+         clm->shards[shard_index].callback_queue.overflows;
+      details->coalesced_linkscan_callbacks +=
+         clm->shards[shard_index].callback_queue.coalesced_linkscans;
+   }
 
    return 0;
 }
@@ -2879,32 +4730,99 @@ int clm_iefb_get_group_status (
    details->group_state               = group_data->group_state;
    details->timestamp_link_scan_start = group_data->timestamp_link_scan_start;
    details->total_occupied            = group_data->total_occupied;
+   details->awaiting_responses        = group_data->awaiting_responses;
+   details->missing_responses         = group_data->missing_responses;
 
    return 0;
 }
 
-const clm_slave_device_data_t * clm_iefb_get_device_connection_details (
+/**
+ * Check that a slave device exists in the configuration.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @return true if the group and the slave device exist
+ */
+static bool clm_iefb_is_device_configured (
    const clm_t * clm,
    uint16_t group_index,
    uint16_t slave_device_index)
 {
-   const clm_group_setting_t * group_setting;
-   const clm_group_data_t * group_data;
+   return group_index < clm->config.hier.number_of_groups &&
+          slave_device_index <
+             clm->config.hier.groups[group_index].num_slave_devices;
+}
 
-   if (group_index >= clm->config.hier.number_of_groups)
+/**
+ * Copy the fields of the connection details that are kept in the
+ * frequently used runtime data.
+ *
+ * @param slave_device_data      Runtime data for the slave device
+ * @param details                Details to update. The statistics and the
+ *                               latest frame values are not touched.
+ */
+static void clm_iefb_assemble_device_details (
+   const clm_slave_device_hot_t * slave_device_data,
+   clm_slave_device_data_t * details)
+{
+   details->device_index           = slave_device_data->device_index;
+   details->enabled                = slave_device_data->enabled;
+   details->transmission_bit       = slave_device_data->transmission_bit;
+   details->timeout_count          = slave_device_data->timeout_count;
+   details->slave_station_no       = slave_device_data->slave_station_no;
+   details->device_state           = slave_device_data->device_state;
+   details->force_transmission_bit = slave_device_data->force_transmission_bit;
+}
+
+const clm_slave_device_data_t * clm_iefb_get_device_connection_details (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index)
+{
+   clm_group_data_t * group_data;
+   clm_slave_device_data_t * device_details;
+
+   if (!clm_iefb_is_device_configured (clm, group_index, slave_device_index))
    {
       return NULL;
    }
 
-   group_data    = &clm->groups[group_index];
-   group_setting = &clm->config.hier.groups[group_index];
+   /* Assemble the view. Statistics and frame values are already there, and
+      the stack never writes the assembled fields in the stored details. */
+   group_data     = &clm->groups[group_index];
+   device_details = &group_data->device_details[slave_device_index];
+   clm_iefb_assemble_device_details (
+      &group_data->slave_devices[slave_device_index],
+      device_details);
 
-   if (slave_device_index >= group_setting->num_slave_devices)
+   return device_details;
+}
+
+int clm_iefb_get_device_connection_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_slave_device_data_t * details)
+{
+   const clm_group_data_t * group_data;
+
+   if (!clm_iefb_is_device_configured (clm, group_index, slave_device_index))
    {
-      return NULL;
+      return -1;
    }
 
-   return &group_data->slave_devices[slave_device_index];
+   group_data = &clm->groups[group_index];
+   clal_memcpy (
+      details,
+      sizeof (*details),
+      &group_data->device_details[slave_device_index],
+      sizeof (*details));
+   clm_iefb_assemble_device_details (
+      &group_data->slave_devices[slave_device_index],
+      details);
+
+   return 0;
 }
 
 void clm_iefb_statistics_clear_all (clm_t * clm)
@@ -2913,7 +4831,7 @@ void clm_iefb_statistics_clear_all (clm_t * clm)
    uint16_t slave_device_index = 0;
    const clm_group_setting_t * group_setting;
    clm_group_data_t * group_data;
-   clm_slave_device_data_t * slave_device_data;
+   clm_slave_device_data_t * device_details;
 
    LOG_DEBUG (CL_CCIEFB_LOG, "CCIEFB(%d): Clear all statistics.\n", __LINE__);
 
@@ -2927,74 +4845,657 @@ void clm_iefb_statistics_clear_all (clm_t * clm)
            slave_device_index < group_setting->num_slave_devices;
            slave_device_index++)
       {
-         slave_device_data = &group_data->slave_devices[slave_device_index];
+         device_details = &group_data->device_details[slave_device_index];
 
-         clm_iefb_statistics_clear (&slave_device_data->statistics);
-         clm_iefb_latest_received_clear (&slave_device_data->latest_frame);
+         clm_iefb_statistics_clear (&device_details->statistics);
+         clm_iefb_latest_received_clear (&device_details->latest_frame);
       }
    }
+
+   /* Keep the latest counter from the operating system, to be able to
+      calculate the number of dropped frames in the next receive */
+   clm->cciefb_socket_statistics.number_of_dropped_frames      = 0;
+   clm->cciefb_socket_statistics.number_of_drop_events         = 0;
+   clm->cciefb_socket_statistics.number_of_icmp_errors         = 0;
+   clm->arbitration_socket_statistics.number_of_dropped_frames = 0;
+   clm->arbitration_socket_statistics.number_of_drop_events    = 0;
+   clm->arbitration_socket_statistics.number_of_icmp_errors    = 0;
 }
 
-void clm_iefb_periodic (clm_t * clm, uint32_t now)
+/**
+ * Check if the master uses a separate socket for frames from other masters.
+ *
+ * @param clm              c-link master stack instance handle
+ * @return true if the arbitration socket is used
+ */
+static bool clm_iefb_use_arbitration_socket (const clm_t * clm)
 {
-   ssize_t recv_len = 0;
-   cl_ipaddr_t remote_ip;
-   uint16_t remote_port;
-
-   cl_limiter_periodic (&clm->errorlimiter, now);
+   return clm->config.use_separate_arbitration_socket &&
+          !clm->config.use_wildcard_cciefb_socket;
+}
 
-   /* Monitor state machine timers */
-   if (cl_timer_is_expired (&clm->arbitration_timer, now))
+/**
+ * Check the destination IP address of an incoming CCIEFB frame.
+ *
+ * A socket bound to all interfaces also receives frames sent to other
+ * IP addresses on this host.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param local_ip         Destination IP address of the frame, or
+ *                         CL_IPADDR_INVALID if not known.
+ * @return true if the frame should be handled
+ */
+static bool clm_iefb_is_frame_for_us (const clm_t * clm, cl_ipaddr_t local_ip)
+{
+   if (!clm->config.use_wildcard_cciefb_socket || local_ip == CL_IPADDR_INVALID)
    {
-      cl_timer_stop (&clm->arbitration_timer);
-      clm_iefb_group_fsm_event_all (clm, now, CLM_GROUP_EVENT_ARBITRATION_DONE);
+      return true;
    }
-   clm_iefb_monitor_all_group_timers (clm, now);
 
-   /* Receive frames from other masters, on operating systems where those
-      broadcasts will not be received via the normal socket.*/
-   if (clm->config.use_separate_arbitration_socket)
+   return local_ip == clm->config.master_id ||
+          local_ip == clm->iefb_broadcast_ip ||
+          local_ip == CL_IPADDR_LOCAL_BROADCAST;
+}
+
+/**
+ * Update the socket statistics with the drop counter reported by the
+ * operating system for an incoming frame.
+ *
+ * @param statistics       Statistics for the socket
+ * @param message          Received message
+ * @return number of frames dropped since the previous report
+ */
+static uint32_t clm_iefb_update_drop_count (
+   clm_socket_statistics_t * statistics,
+   const clal_udp_message_t * message)
+{
+   uint32_t dropped;
+
+   if (!message->drop_count_valid)
    {
-      recv_len = clal_udp_recvfrom (
-         clm->cciefb_arbitration_socket,
-         &remote_ip,
-         &remote_port,
-         clm->cciefb_receivebuf,
-         sizeof (clm->cciefb_receivebuf));
+      return 0;
+   }
+
+   /* The counter from the operating system might wrap around */
+   dropped = message->drop_count - statistics->os_drop_counter;
+
+   statistics->drops_available = true;
+   statistics->os_drop_counter = message->drop_count;
+   statistics->number_of_dropped_frames += dropped;
+
+   return dropped;
+}
+
+/**
+ * Receive a batch of CCIEFB frames from a socket, and handle them.
+ *
+ * All frames that are available (up to CLM_CCIEFB_RECEIVE_BATCH_SIZE) are
+ * fetched from the socket in a single call, before any of them is handled.
+ * With master shards the frames are steered to the shard queues, and frames
+ * for a shard with a full queue are dropped, see
+ * clm_iefb_steer_response_frame().
+ *
+ * Frames dropped by the operating system (for example due to a full
+ * receive buffer) are counted, and reported via the error callback.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              Timestamp in microseconds
+ * @param socket           Socket handle
+ * @param statistics       Statistics for the socket
+ * @return Number of received frames, or -1 on failure
+ */
+static int clm_iefb_receive_and_handle_frames (
+   clm_t * clm,
+   uint32_t now,
+   int socket,
+   clm_socket_statistics_t * statistics)
+{
+   const clal_udp_message_t * message;
+   uint32_t dropped = 0;
+   int num_received;
+   int i;
 
-      if (recv_len > 0)
+   num_received = clal_udp_recvfrom_batch (
+      socket,
+      clm->cciefb_receive_messages,
+      NELEMENTS (clm->cciefb_receive_messages));
+
+   for (i = 0; i < num_received; i++)
+   {
+      message = &clm->cciefb_receive_messages[i];
+      dropped += clm_iefb_update_drop_count (statistics, message);
+      if (message->len > 0 && clm_iefb_is_frame_for_us (clm, message->local_ip))
       {
          (void)clm_iefb_handle_input_frame (
             clm,
             now,
-            clm->cciefb_receivebuf,
-            (size_t)recv_len,
-            remote_ip,
-            remote_port);
+            message->timestamp_us,
+            message->timestamp_valid,
+            message->data,
+            message->len,
+            message->remote_ip,
+            message->remote_port);
+      }
+   }
+
+   if (dropped > 0)
+   {
+      statistics->number_of_drop_events++;
+      LOG_DEBUG (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): The operating system dropped %" PRIu32
+         " incoming frames on socket %d.\n",
+         __LINE__,
+         dropped,
+         socket);
+      clm_iefb_trigger_error_callback (
+         clm,
+         &clm->errorlimiter,
+         now,
+         CLM_ERROR_CCIEFB_FRAMES_DROPPED,
+         clm->config.master_id,
+         (dropped > UINT16_MAX) ? UINT16_MAX : (uint16_t)dropped);
+   }
+
+   return num_received;
+}
+
+/**
+ * Store the transmission timestamp of a request frame, for the group that
+ * sent the datagram.
+ *
+ * Not used with master shards, as the datagrams then are sent by several
+ * threads.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param entry            Transmission timestamp from the error queue
+ */
+static void clm_iefb_store_transmission_timestamp (
+   clm_t * clm,
+   const clal_udp_error_queue_entry_t * entry)
+{
+   clm_group_data_t * group_data;
+   uint16_t group_index;
+
+   if (clm_iefb_is_sharded (clm))
+   {
+      return;
+   }
+
+   for (group_index = 0; group_index < clm->config.hier.number_of_groups;
+        group_index++)
+   {
+      group_data = &clm->groups[group_index];
+      if (group_data->request_datagram_id == entry->id + 1)
+      {
+         group_data->timestamp_request_transmitted       = entry->timestamp_us;
+         group_data->timestamp_request_transmitted_valid = true;
+      }
+   }
+}
+
+/**
+ * Drain the error queue of a CCIEFB socket.
+ *
+ * The transmission timestamps of the request frames are stored for the
+ * groups, and ICMP errors are logged and counted.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param handle           Socket handle
+ * @param statistics       Statistics for the socket
+ */
+static void clm_iefb_read_error_queue (
+   clm_t * clm,
+   int handle,
+   clm_socket_statistics_t * statistics)
+{
+   clal_udp_error_queue_entry_t entries[CLM_CCIEFB_RECEIVE_BATCH_SIZE];
+#if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
+   char ip_string[CL_INET_ADDRSTR_SIZE] = {0}; /** Terminated string */
+#endif
+   int num_read;
+   int i;
+
+   do
+   {
+      num_read =
+         clal_udp_read_error_queue (handle, entries, NELEMENTS (entries));
+      for (i = 0; i < num_read; i++)
+      {
+         if (entries[i].type == CLAL_UDP_ERROR_QUEUE_ICMP_ERROR)
+         {
+            statistics->number_of_icmp_errors++;
+#if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
+            cl_util_ip_to_string (entries[i].offender_ip, ip_string);
+            LOG_DEBUG (
+               CL_CCIEFB_LOG,
+               "CCIEFB(%d): ICMP error %d from %s on socket %d.\n",
+               __LINE__,
+               entries[i].error,
+               ip_string,
+               handle);
+#endif
+         }
+         else if (handle == clm->cciefb_socket)
+         {
+            clm_iefb_store_transmission_timestamp (clm, &entries[i]);
+         }
       }
+   } while (num_read == (int)NELEMENTS (entries));
+}
+
+/**
+ * Receive and handle all available frames on the CCIEFB sockets.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              Timestamp in microseconds
+ */
+static void clm_iefb_receive_all_frames (clm_t * clm, uint32_t now)
+{
+   int num_received = 0;
+
+   /* Receive frames from other masters, on operating systems where those
+      broadcasts will not be received via the normal socket.*/
+   if (clm_iefb_use_arbitration_socket (clm))
+   {
+      clm_iefb_read_error_queue (
+         clm,
+         clm->cciefb_arbitration_socket,
+         &clm->arbitration_socket_statistics);
+      (void)clm_iefb_receive_and_handle_frames (
+         clm,
+         now,
+         clm->cciefb_arbitration_socket,
+         &clm->arbitration_socket_statistics);
    }
 
-   /* Receive and handle incoming CCIEFB data frames */
+   /* Transmission timestamps must be known before the responses are
+      handled */
+   clm_iefb_read_error_queue (
+      clm,
+      clm->cciefb_socket,
+      &clm->cciefb_socket_statistics);
+
+   /* Receive and handle incoming CCIEFB data frames. The socket is
+      drained when a batch is not completely filled. */
    do
    {
-      recv_len = clal_udp_recvfrom (
+      num_received = clm_iefb_receive_and_handle_frames (
+         clm,
+         now,
          clm->cciefb_socket,
-         &remote_ip,
-         &remote_port,
-         clm->cciefb_receivebuf,
-         sizeof (clm->cciefb_receivebuf));
+         &clm->cciefb_socket_statistics);
+   } while (num_received == (int)NELEMENTS (clm->cciefb_receive_messages));
+}
 
-      if (recv_len > 0)
+/**
+ * Forward master duplication alarms from the shards to all groups, and
+ * update the master state from the states requested by the shards.
+ *
+ * The lowest state among the shards is used, so that the master is
+ * reported as running when all groups have completed the arbitration.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              Timestamp in microseconds
+ */
+static void clm_iefb_monitor_shards (clm_t * clm, uint32_t now)
+{
+   uint16_t shard_index;
+   uint32_t alarm_count;
+   clm_master_state_t lowest_state = CLM_MASTER_STATE_RUNNING;
+   clm_shard_t * shard;
+
+   for (shard_index = 0; shard_index < clm->config.number_of_shards &&
+                         shard_index < clm->config.hier.number_of_groups;
+        shard_index++)
+   {
+      shard       = &clm->shards[shard_index];
+      alarm_count = shard->masterdupl_alarm_count;
+      if (alarm_count != shard->masterdupl_alarm_handled)
       {
-         (void)clm_iefb_handle_input_frame (
+         shard->masterdupl_alarm_handled = alarm_count;
+         clm_iefb_group_fsm_event_all_shards (
             clm,
             now,
-            clm->cciefb_receivebuf,
-            (size_t)recv_len,
-            remote_ip,
-            remote_port);
+            CLM_GROUP_EVENT_MASTERDUPL_ALARM);
       }
-   } while (recv_len > 0);
+
+      if (shard->master_state < lowest_state)
+      {
+         lowest_state = shard->master_state;
+      }
+   }
+
+   clm_iefb_set_master_state (clm, lowest_state);
+}
+
+/**
+ * Execute the commands queued to a shard, and queue the command callbacks.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard            Shard instance
+ */
+static void clm_iefb_shard_handle_commands (clm_t * clm, clm_shard_t * shard)
+{
+   const clm_shard_command_t * entry;
+   clm_callback_record_t record = {0};
+   uint32_t position;
+   int result;
+
+   while (cl_command_queue_peek (&shard->command_queue, &position))
+   {
+      entry = &shard->commands[cl_command_queue_slot (position)];
+
+      switch (entry->command.type)
+      {
+      case CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS:
+         result = clm_iefb_set_slave_communication_status (
+            clm,
+            entry->command.group_index,
+            entry->command.slave_device_index,
+            entry->command.enabled);
+         break;
+      case CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT:
+         result = clm_iefb_force_cyclic_transmission_bit (
+            clm,
+            entry->command.group_index,
+            entry->command.slave_device_index,
+            entry->command.force);
+         break;
+      default:
+         result = -1;
+         break;
+      }
+
+      if (entry->confirm && clm->config.command_cfm_cb != NULL)
+      {
+         record.type        = CLM_CALLBACK_COMMAND_CFM;
+         record.group_index = entry->command.group_index;
+         record.success     = (result == 0);
+         record.command     = entry->command;
+         clm_iefb_queue_callback (clm, &record);
+      }
+
+      cl_command_queue_release (&shard->command_queue);
+   }
+}
+
+/**
+ * Handle the group events queued to a shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard_index      Shard index
+ * @param now              Timestamp in microseconds
+ */
+static void clm_iefb_shard_handle_events (
+   clm_t * clm,
+   uint16_t shard_index,
+   uint32_t now)
+{
+   clm_shard_t * shard = &clm->shards[shard_index];
+   clm_group_event_t event;
+   uint16_t group_index;
+
+   while (shard->event_read_count != shard->event_write_count)
+   {
+      /* Read the event after the updated count */
+      clal_memory_barrier();
+      event = shard->events
+                 [shard->event_read_count & (CLM_SHARD_EVENT_QUEUE_SIZE - 1)];
+      clal_memory_barrier();
+      shard->event_read_count++;
+
+      for (group_index = shard_index;
+           group_index < clm->config.hier.number_of_groups;
+           group_index += clm->config.number_of_shards)
+      {
+         clm_iefb_group_fsm_event (clm, now, &clm->groups[group_index], event);
+      }
+   }
+}
+
+/**
+ * Handle the incoming response frames queued to a shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard            Shard instance
+ * @param now              Timestamp in microseconds
+ */
+static void clm_iefb_shard_handle_frames (
+   clm_t * clm,
+   clm_shard_t * shard,
+   uint32_t now)
+{
+   clm_shard_frame_t * frame;
+
+   while (shard->frame_read_count != shard->frame_write_count)
+   {
+      /* Read the frame after the updated count */
+      clal_memory_barrier();
+      frame = &shard->frames
+                  [shard->frame_read_count & (CLM_SHARD_FRAME_QUEUE_SIZE - 1)];
+      (void)clm_iefb_handle_response_frame (
+         clm,
+         now,
+         frame->port_timestamp,
+         frame->port_timestamp_valid,
+         frame->buffer,
+         frame->len,
+         frame->remote_ip,
+         frame->remote_port);
+
+      /* Release the frame buffer after it has been handled */
+      clal_memory_barrier();
+      shard->frame_read_count++;
+   }
+}
+
+void clm_iefb_handle_readable (clm_t * clm, uint32_t now)
+{
+   /* Request frames for groups completing their link scans are sent
+      together after all incoming frames have been handled */
+   clm->cciefb_send_queue.deferred = true;
+   clm_iefb_receive_all_frames (clm, now);
+   clm->cciefb_send_queue.deferred = false;
+   (void)clm_iefb_send_queued_request_frames (clm, &clm->cciefb_send_queue);
+}
+
+void clm_iefb_periodic (clm_t * clm, uint32_t now)
+{
+   clm->cciefb_send_queue.deferred = true;
+
+   cl_limiter_periodic (&clm->errorlimiter, now);
+
+   /* Monitor state machine timers */
+   clm_iefb_monitor_timers (clm, now);
+
+   if (clm_iefb_is_sharded (clm))
+   {
+      clm_iefb_monitor_shards (clm, now);
+
+      /* Callbacks from the shards are called from this thread */
+      if (!clm->config.use_async_callbacks)
+      {
+         (void)clm_iefb_dispatch_callbacks (clm);
+      }
+   }
+
+   clm_iefb_receive_all_frames (clm, now);
+
+   /* Send request frames to all groups that started a link scan */
+   clm->cciefb_send_queue.deferred = false;
+   (void)clm_iefb_send_queued_request_frames (clm, &clm->cciefb_send_queue);
+}
+
+void clm_iefb_shard_periodic (clm_t * clm, uint16_t shard_index, uint32_t now)
+{
+   clm_shard_t * shard = &clm->shards[shard_index];
+
+   shard->send_queue.deferred = true;
+
+   cl_limiter_periodic (&shard->errorlimiter, now);
+
+   clm_iefb_shard_handle_commands (clm, shard);
+   clm_iefb_shard_handle_events (clm, shard_index, now);
+
+   /* Monitor the link scan timers of the groups in the shard */
+   clm_iefb_monitor_timer_heap (clm, now, &shard->timer_heap);
+
+   clm_iefb_shard_handle_frames (clm, shard, now);
+
+   /* Send request frames to all groups that started a link scan */
+   shard->send_queue.deferred = false;
+   (void)clm_iefb_send_queued_request_frames (clm, &shard->send_queue);
+}
+
+int clm_iefb_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   uint16_t needed = clm_iefb_use_arbitration_socket (clm) ? 2 : 1;
+
+   if (*number_of_sockets + needed > max_sockets)
+   {
+      return -1;
+   }
+
+   sockets[*number_of_sockets].handle = clm->cciefb_socket;
+   sockets[*number_of_sockets].role   = CL_SOCKET_ROLE_CCIEFB;
+   (*number_of_sockets)++;
+
+   if (clm_iefb_use_arbitration_socket (clm))
+   {
+      sockets[*number_of_sockets].handle = clm->cciefb_arbitration_socket;
+      sockets[*number_of_sockets].role   = CL_SOCKET_ROLE_CCIEFB_ARBITRATION;
+      (*number_of_sockets)++;
+   }
+
+   return 0;
+}
+
+void clm_iefb_update_next_deadline (
+   clm_t * clm,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   uint16_t timer_id = 0;
+
+   cl_timer_update_earliest_deadline (
+      &clm->errorlimiter.timer,
+      now,
+      found,
+      earliest);
+
+   /* The state machine timers are sorted by deadline */
+   if (cl_timer_heap_peek (&clm->timer_heap, &timer_id))
+   {
+      cl_timer_update_earliest_deadline (
+         clm_iefb_get_timer (clm, timer_id),
+         now,
+         found,
+         earliest);
+   }
+}
+
+void clm_iefb_update_shard_next_deadline (
+   clm_t * clm,
+   uint16_t shard_index,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   clm_shard_t * shard = &clm->shards[shard_index];
+   uint16_t timer_id   = 0;
+
+   cl_timer_update_earliest_deadline (
+      &shard->errorlimiter.timer,
+      now,
+      found,
+      earliest);
+
+   if (cl_timer_heap_peek (&shard->timer_heap, &timer_id))
+   {
+      cl_timer_update_earliest_deadline (
+         clm_iefb_get_timer (clm, timer_id),
+         now,
+         found,
+         earliest);
+   }
+}
+
+uint32_t clm_iefb_calc_receive_buffer_size (const clm_cfg_t * config)
+{
+   uint32_t size = 0;
+   uint16_t group_index;
+   uint16_t slave_device_index;
+   const clm_group_setting_t * group_setting;
+
+   for (group_index = 0; group_index < config->hier.number_of_groups;
+        group_index++)
+   {
+      group_setting = &config->hier.groups[group_index];
+      for (slave_device_index = 0;
+           slave_device_index < group_setting->num_slave_devices;
+           slave_device_index++)
+      {
+         size += (uint32_t)cl_calculate_cyclic_response_size (
+                    group_setting->slave_devices[slave_device_index]
+                       .num_occupied_stations) +
+                 CL_SOCKET_RECEIVE_OVERHEAD_PER_FRAME;
+      }
+   }
+
+   return size;
+}
+
+/**
+ * Apply the configured socket profile to a CCIEFB socket.
+ *
+ * A failure is not fatal, as the cyclic communication works also with the
+ * operating system default settings.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param handle           Socket handle
+ * @param applied          Resulting settings in effect
+ */
+static void clm_iefb_apply_socket_profile (
+   clm_t * clm,
+   int handle,
+   cl_socket_profile_t * applied)
+{
+   const cl_socket_profile_t * setting = &clm->config.cciefb_socket_profile;
+   clal_socket_profile_t profile;
+   clal_socket_profile_t result;
+
+   profile.busy_poll_us        = setting->busy_poll_us;
+   profile.receive_buffer_size = setting->receive_buffer_size;
+   profile.priority            = setting->priority;
+   profile.dscp                = setting->dscp;
+   profile.enable_error_queue  = setting->enable_error_queue;
+
+   if (setting->receive_buffer_for_burst)
+   {
+      profile.receive_buffer_size =
+         clm_iefb_calc_receive_buffer_size (&clm->config);
+   }
+
+   if (clal_udp_set_profile (handle, &profile, &result) != 0)
+   {
+      LOG_WARNING (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Could not apply all socket profile settings for socket "
+         "%d.\n",
+         __LINE__,
+         handle);
+   }
+
+   cl_util_socket_profile_from_clal (
+      &result,
+      setting->receive_buffer_for_burst,
+      applied);
 }
 
 int clm_iefb_init (clm_t * clm, uint32_t now)
@@ -3004,11 +5505,17 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
 #endif
    uint16_t group_index = 0;
    clm_group_data_t * group_data;
+   clm_shard_t * shard;
+   size_t shard_index;
+   size_t i;
+   cl_ipaddr_t listen_ip = clm->config.use_wildcard_cciefb_socket
+                              ? CL_IPADDR_ANY
+                              : clm->config.master_id;
 
    cl_limiter_init (&clm->errorlimiter, CLM_CCIEFB_ERRORCALLBACK_RETRIGGER_PERIOD);
 
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
-   cl_util_ip_to_string (clm->config.master_id, ip_string);
+   cl_util_ip_to_string (listen_ip, ip_string);
    LOG_DEBUG (
       CL_CCIEFB_LOG,
       "CCIEFB(%d): Initialising master CCIEFB. Listening on IP address %s "
@@ -3019,7 +5526,8 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
 #endif
 
 #ifndef FUZZ_TEST
-   clm->cciefb_socket = clal_udp_open (clm->config.master_id, CL_CCIEFB_PORT);
+   clm->cciefb_socket         = clal_udp_open (listen_ip, CL_CCIEFB_PORT);
+   clm->cciefb_datagrams_sent = 0;
    if (clm->cciefb_socket == -1)
    {
       LOG_ERROR (
@@ -3028,11 +5536,15 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
          __LINE__);
       return -1;
    }
+   clm_iefb_apply_socket_profile (
+      clm,
+      clm->cciefb_socket,
+      &clm->cciefb_socket_profile);
 #else
    clm->cciefb_socket = -1;
 #endif
 
-   if (clm->config.use_separate_arbitration_socket)
+   if (clm_iefb_use_arbitration_socket (clm))
    {
 #if LOG_DEBUG_ENABLED(CL_CCIEFB_LOG)
       cl_util_ip_to_string (clm->iefb_broadcast_ip, ip_string);
@@ -3056,6 +5568,10 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
             __LINE__);
          return -1;
       }
+      clm_iefb_apply_socket_profile (
+         clm,
+         clm->cciefb_arbitration_socket,
+         &clm->arbitration_socket_profile);
 #else
       clm->cciefb_arbitration_socket = -1;
 #endif
@@ -3069,6 +5585,7 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
    }
    else
    {
+      clm->cciefb_arbitration_socket = -1;
       LOG_DEBUG (
          CL_CCIEFB_LOG,
          "CCIEFB(%d): Socket number for CCIEFB: %d (No arbitration socket)\n",
@@ -3076,10 +5593,59 @@ int clm_iefb_init (clm_t * clm, uint32_t now)
          clm->cciefb_socket);
    }
 
+   /* The drop counters from the operating system start over for new
+      sockets */
+   clal_clear_memory (
+      &clm->cciefb_socket_statistics,
+      sizeof (clm->cciefb_socket_statistics));
+   clal_clear_memory (
+      &clm->arbitration_socket_statistics,
+      sizeof (clm->arbitration_socket_statistics));
+
+   /* Prepare receive buffers for batch reception */
+   for (i = 0; i < NELEMENTS (clm->cciefb_receive_messages); i++)
+   {
+      clm->cciefb_receive_messages[i].data = clm->cciefb_receivebufs[i];
+      clm->cciefb_receive_messages[i].size =
+         sizeof (clm->cciefb_receivebufs[i]);
+   }
+
+   clm->cciefb_send_queue.count    = 0;
+   clm->cciefb_send_queue.deferred = false;
+   clal_clear_memory (&clm->callback_queue, sizeof (clm->callback_queue));
+
    clm->latest_conflicting_master_ip = CL_IPADDR_INVALID;
    clm->master_state                 = CLM_MASTER_STATE_DOWN;
    clm->master_local_unit_info       = CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_RUNNING;
    cl_timer_stop (&clm->arbitration_timer); /* Initialise timer */
+   cl_timer_heap_init (&clm->timer_heap);
+
+   /* Initialise shards. The group state machines below use the shards if
+      sharding is enabled. */
+   for (shard_index = 0; shard_index < NELEMENTS (clm->shards); shard_index++)
+   {
+      shard = &clm->shards[shard_index];
+
+      shard->frame_write_count        = 0;
+      shard->frame_read_count         = 0;
+      shard->event_write_count        = 0;
+      shard->event_read_count         = 0;
+      shard->queue_overflows          = 0;
+      shard->send_queue.count         = 0;
+      shard->send_queue.deferred      = false;
+      shard->master_state             = CLM_MASTER_STATE_DOWN;
+      shard->masterdupl_alarm_count   = 0;
+      shard->masterdupl_alarm_handled = 0;
+      clal_clear_memory (
+         &shard->callback_queue,
+         sizeof (shard->callback_queue));
+      cl_command_queue_init (&shard->command_queue);
+      cl_timer_heap_init (&shard->timer_heap);
+      cl_limiter_init (
+         &shard->errorlimiter,
+         CLM_CCIEFB_ERRORCALLBACK_RETRIGGER_PERIOD);
+   }
+
    clm_iefb_device_fsm_tables_init (clm);
    clm_iefb_group_fsm_tables_init (clm);
 
@@ -3106,7 +5672,7 @@ void clm_iefb_exit (clm_t * clm)
    clal_udp_close (clm->cciefb_socket);
    clm->cciefb_socket = -1;
 
-   if (clm->config.use_separate_arbitration_socket)
+   if (clm_iefb_use_arbitration_socket (clm))
    {
       clal_udp_close (clm->cciefb_arbitration_socket);
       clm->cciefb_arbitration_socket = -1;
@@ -22,6 +22,19 @@ extern "C" {
 #include "clm_api.h"
 #include "common/cl_types.h"
 
+/**
+ * Calculate the socket receive buffer size needed for the worst case burst
+ * of incoming CCIEFB response frames.
+ *
+ * All slave devices in all groups are assumed to respond at the same time.
+ *
+ * No validation is done on the configuration.
+ *
+ * @param config           Master configuration
+ * @return the receive buffer size in bytes
+ */
+uint32_t clm_iefb_calc_receive_buffer_size (const clm_cfg_t * config);
+
 /**
  * Initialise master CCIEFB
  *
@@ -51,6 +64,89 @@ void clm_iefb_exit (clm_t * clm);
  */
 void clm_iefb_periodic (clm_t * clm, uint32_t now);
 
+/**
+ * Receive and handle all available frames on the CCIEFB sockets.
+ *
+ * Does not handle any timers. This is done by \a clm_iefb_periodic().
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ */
+void clm_iefb_handle_readable (clm_t * clm, uint32_t now);
+
+/**
+ * Execute the groups of one master shard.
+ *
+ * Only used if sharding is enabled. Call it from the thread running the
+ * shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard_index      Shard index, 0..number_of_shards-1
+ * @param now              timestamp in microseconds
+ */
+void clm_iefb_shard_periodic (clm_t * clm, uint16_t shard_index, uint32_t now);
+
+/**
+ * Deliver the queued application callbacks.
+ *
+ * Only used if asynchronous callbacks are enabled. Call it from the
+ * application thread that should run the callbacks.
+ *
+ * @param clm              c-link master stack instance handle
+ * @return Number of callbacks delivered
+ */
+int clm_iefb_dispatch_callbacks (clm_t * clm);
+
+/**
+ * Add the CCIEFB socket handles to a list of sockets.
+ *
+ * @param clm                 c-link master stack instance handle
+ * @param sockets             List of sockets
+ * @param max_sockets         Number of elements in \a sockets
+ * @param number_of_sockets   Number of used elements in \a sockets. Will
+ *                            be increased by the number of added sockets.
+ * @return 0 on success, -1 if the list is too small
+ */
+int clm_iefb_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Find the earliest deadline among the master CCIEFB timers.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ * @param found            Set to true if any timer is running
+ * @param earliest         Time until the earliest deadline found so far, in
+ *                         microseconds. Updated if an earlier deadline is
+ *                         found.
+ */
+void clm_iefb_update_next_deadline (
+   clm_t * clm,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
+/**
+ * Find the earliest deadline among the timers of a master shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param shard_index      Shard index, 0..number_of_shards-1
+ * @param now              timestamp in microseconds
+ * @param found            Set to true if any timer is running
+ * @param earliest         Time until the earliest deadline found so far, in
+ *                         microseconds. Updated if an earlier deadline is
+ *                         found.
+ */
+void clm_iefb_update_shard_next_deadline (
+   clm_t * clm,
+   uint16_t shard_index,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
 /**
  * Set the master application status.
  *
@@ -112,6 +208,28 @@ int clm_iefb_force_cyclic_transmission_bit (
    uint16_t slave_device_index,
    bool force);
 
+/**
+ * Queue a command for a group to the shard running the group. Only valid
+ * if sharding is enabled.
+ *
+ * The command is executed by clm_iefb_shard_periodic(). Can be called from
+ * several threads at the same time.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param command                Command of type
+ *                               CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS
+ *                               or CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT
+ * @param confirm                True to report the result via the command
+ *                               callback, queued like the other callbacks
+ *                               from the shard
+ * @return 0 if the command was queued, or -1 on illegal argument values or
+ *         if the queue is full.
+ */
+int clm_iefb_queue_shard_command (
+   clm_t * clm,
+   const clm_command_t * command,
+   bool confirm);
+
 /**
  * Calculate the total number of occupied slave stations in a group.
  *
@@ -249,6 +367,91 @@ cl_rww_t * clm_iefb_get_first_device_rww_area (
    uint16_t slave_device_index,
    uint16_t * num_occupied_stations);
 
+/**
+ * Publish the RY and RWw values for a group, when double buffered outputs
+ * are used.
+ *
+ * Swaps the active and the inactive request frames, and copies the
+ * published values to the new inactive frame.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_publish_outputs (clm_t * clm, uint16_t group_index);
+
+/**
+ * Mark RY and RWw values as changed for a range of slave stations in a
+ * group, so they are copied to the request frame at next link scan start.
+ *
+ * Does nothing if output dirty tracking is disabled.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param first_area             Index of first memory area in group
+ * @param num_areas              Number of memory areas
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_mark_outputs_dirty (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t first_area,
+   uint16_t num_areas);
+
+/**
+ * Copy a consistent snapshot of the incoming RX and RWr data for a group.
+ *
+ * Can be called from another thread than the stack.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param snapshot               Resulting snapshot
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_get_group_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   clm_input_snapshot_t * snapshot);
+
+/**
+ * Copy a consistent snapshot of the incoming RX and RWr data for a slave
+ * device.
+ *
+ * Can be called from another thread than the stack.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param snapshot               Resulting snapshot
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_get_device_input_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_input_snapshot_t * snapshot);
+
+/**
+ * Get the changed RX bits and RWr registers for a slave device, since the
+ * previous call. Clears the accumulated changes.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param changed                Resulting changed signals
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_get_changed_inputs (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   cl_changed_signals_t * changed);
+
 /**
  * Read an individual bit (RX) from a slave.
  *
@@ -353,6 +556,90 @@ uint16_t clm_iefb_get_rww_value (
    uint16_t slave_device_index,
    uint16_t number);
 
+/**
+ * Read a range of bits (RX) from a slave.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First bit number. Use 0 for RX0.
+ * @param num_bits               Number of bits
+ * @param values                 Resulting bit values
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_get_rx_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values);
+
+/**
+ * Set a range of bits (RY) for sending to a slave.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First bit number. Use 0 for RY0.
+ * @param num_bits               Number of bits
+ * @param values                 Bit values
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_set_ry_bits (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values);
+
+/**
+ * Read a range of 16-bit register values (RWr) from a slave.
+ *
+ * The endianness is handled automatically.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First register number. Use 0 for RWr0.
+ * @param num_values             Number of registers
+ * @param values                 Resulting register values
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_get_rwr_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values);
+
+/**
+ * Set a range of 16-bit register values (RWw) for sending to a slave.
+ *
+ * The endianness is handled automatically.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param first_number           First register number. Use 0 for RWw0.
+ * @param num_values             Number of registers
+ * @param values                 Register values
+ * @return 0 on success, -1 on failure
+ */
+int clm_iefb_set_rww_values (
+   clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values);
+
 /**
  * Clear statistics for communication with slave devices
  *
@@ -400,21 +687,45 @@ int clm_iefb_get_group_status (
  *
  * This function is intended for debugging and for automated tests.
  *
+ * The details are assembled from the frequently used runtime data and the
+ * separately stored statistics and frame values.
+ *
  * @param clm                    c-link master stack instance handle
  * @param group_index            Group index (starts from 0).
  *                               Note that group number 1 has group_index 0.
  * @param slave_device_index     Device index in group (starts from 0).
  * @return Pointer to slave device connection details, or NULL on error.
- *         No copying is done.
  *
  * @req REQ_CLM_DIAGNOSIS_02
  *
  */
 const clm_slave_device_data_t * clm_iefb_get_device_connection_details (
-   const clm_t * clm,
+   clm_t * clm,
    uint16_t group_index,
    uint16_t slave_device_index);
 
+/**
+ * Copy the connection details for a slave device.
+ *
+ * Same view as \a clm_iefb_get_device_connection_details(), but copied to
+ * the caller. Nothing in \a clm is modified.
+ *
+ * @param clm                    c-link master stack instance handle
+ * @param group_index            Group index (starts from 0).
+ *                               Note that group number 1 has group_index 0.
+ * @param slave_device_index     Device index in group (starts from 0).
+ * @param details                Resulting details
+ * @return 0 on success, -1 on failure
+ *
+ * @req REQ_CLM_DIAGNOSIS_02
+ *
+ */
+int clm_iefb_get_device_connection_snapshot (
+   const clm_t * clm,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   clm_slave_device_data_t * details);
+
 /************ Internal functions made available for tests *****************/
 
 void clm_iefb_update_frame_sequence_no (uint16_t * frame_sequence_no);
@@ -438,6 +749,12 @@ int clm_iefb_calc_slave_device_index (
    cl_ipaddr_t ip_addr,
    uint16_t * slave_device_index);
 
+void clm_iefb_build_slave_index (clm_t * clm);
+
+const clm_slave_index_entry_t * clm_iefb_find_slave (
+   const clm_t * clm,
+   cl_ipaddr_t ip_addr);
+
 void clm_iefb_update_request_slave_id (
    uint32_t * first_slave_id,
    uint16_t slave_station_no,
@@ -445,9 +762,12 @@ void clm_iefb_update_request_slave_id (
    cl_ipaddr_t slave_id);
 
 bool clm_iefb_group_have_received_from_all_devices (
-   const clm_group_setting_t * group_setting,
    const clm_group_data_t * group_data);
 
+void clm_iefb_update_awaiting_responses (
+   clm_group_data_t * group_data,
+   const clm_slave_device_hot_t * slave_device_data);
+
 void clm_iefb_reflect_group_parameters (clm_t * clm, clm_group_data_t * group_data);
 
 void clm_iefb_group_fsm_tables_init (clm_t * clm);
@@ -464,7 +784,7 @@ void clm_iefb_device_fsm_event (
    clm_t * clm,
    uint32_t now,
    clm_group_data_t * group_data,
-   clm_slave_device_data_t * slave_device_data,
+   clm_slave_device_hot_t * slave_device_data,
    clm_device_event_t event);
 
 void clm_iefb_statistics_update_response_time (
@@ -474,7 +794,7 @@ void clm_iefb_statistics_update_response_time (
 
 void clm_iefb_statistics_clear (clm_slave_device_statistics_t * statistics);
 
-void clm_iefb_monitor_all_group_timers (clm_t * clm, uint32_t now);
+void clm_iefb_monitor_timers (clm_t * clm, uint32_t now);
 
 #ifdef __cplusplus
 }
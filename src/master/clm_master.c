@@ -61,6 +61,14 @@
 #error "CLM_MAX_OCCUPIED_STATIONS_PER_GROUP is too large"
 #endif
 
+#if CLM_MAX_SHARDS < 1
+#error "CLM_MAX_SHARDS is too small"
+#endif
+
+#if CLM_MAX_SHARDS > 8
+#error "CLM_MAX_SHARDS is too large"
+#endif
+
 #define CLM_MASTER_BITS_PER_LINE  32U
 #define CLM_MASTER_WORDS_PER_LINE 8U
 
@@ -141,6 +149,19 @@ int clm_validate_config (const clm_cfg_t * cfg)
       return -1;
    }
 
+   /* Number of shards */
+   if (cfg->number_of_shards > CLM_MAX_SHARDS)
+   {
+      LOG_ERROR (
+         CL_CCIEFB_LOG,
+         "CLM_MASTER(%d): Wrong number of shards in the configuration. Given "
+         "%u but max is %u. Possibly increase CLM_MAX_SHARDS.\n",
+         __LINE__,
+         cfg->number_of_shards,
+         CLM_MAX_SHARDS);
+      return -1;
+   }
+
    /* Check groups and slave IDs */
    for (group_index = 0; group_index < cfg->hier.number_of_groups; group_index++)
    {
@@ -295,6 +316,21 @@ int clm_validate_config (const clm_cfg_t * cfg)
       return -1;
    }
 
+   /* Socket profile */
+   if (!cl_utils_is_socket_profile_valid (&cfg->cciefb_socket_profile))
+   {
+      LOG_ERROR (
+         CL_CCIEFB_LOG,
+         "CLM_MASTER(%d): Invalid CCIEFB socket profile. Given priority %u "
+         "(max %u) and DSCP %u (max %u).\n",
+         __LINE__,
+         cfg->cciefb_socket_profile.priority,
+         CL_SOCKET_PRIORITY_MAX,
+         cfg->cciefb_socket_profile.dscp,
+         CL_SOCKET_DSCP_MAX);
+      return -1;
+   }
+
    return 0;
 }
 
@@ -545,7 +581,10 @@ void clm_master_internals_show (clm_t * clm)
            slave_device_index++)
       {
          slave_device_setting = &group_setting->slave_devices[slave_device_index];
-         slave_device_data = &group_data->slave_devices[slave_device_index];
+         slave_device_data = clm_iefb_get_device_connection_details (
+            clm,
+            group_index,
+            slave_device_index);
          cl_util_ip_to_string (slave_device_setting->slave_id, ip_string);
          printf (
             "        Slave device index: %u  Slave station number: %u\n",
@@ -661,6 +700,34 @@ void clm_master_config_show (const clm_cfg_t * cfg)
       CL_CCIEFB_LOG,
       "  Max statistics samples: %u\n",
       cfg->max_statistics_samples);
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  Double buffered outputs: %s\n",
+      cfg->use_double_buffered_outputs ? "Yes" : "No");
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  Output dirty tracking: %s\n",
+      cfg->use_output_dirty_tracking ? "Yes" : "No");
+   LOG_DEBUG (CL_CCIEFB_LOG, "  Number of shards: %u\n", cfg->number_of_shards);
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  Separate SLMP thread: %s\n",
+      cfg->use_separate_slmp_thread ? "Yes" : "No");
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  Asynchronous callbacks: %s  Coalesce link scan callbacks: %s\n",
+      cfg->use_async_callbacks ? "Yes" : "No",
+      cfg->coalesce_linkscan_callbacks ? "Yes" : "No");
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  CCIEFB socket profile: busy poll %" PRIu32 " us, receive buffer %" PRIu32
+      " bytes%s, priority %u, DSCP %u, error queue %s\n",
+      cfg->cciefb_socket_profile.busy_poll_us,
+      cfg->cciefb_socket_profile.receive_buffer_size,
+      cfg->cciefb_socket_profile.receive_buffer_for_burst ? " (for burst)" : "",
+      cfg->cciefb_socket_profile.priority,
+      cfg->cciefb_socket_profile.dscp,
+      cfg->cciefb_socket_profile.enable_error_queue ? "Yes" : "No");
    LOG_DEBUG (CL_CCIEFB_LOG, "  Number of groups: %u\n", cfg->hier.number_of_groups);
 
    for (group_index = 0; group_index < cfg->hier.number_of_groups; group_index++)
@@ -779,6 +846,7 @@ int clm_master_init (clm_t * clm, const clm_cfg_t * cfg, uint32_t now)
    LOG_DEBUG (CL_CCIEFB_LOG, "CLM_MASTER(%d): Initialising\n", __LINE__);
 
    clal_clear_memory (clm, sizeof (*clm));
+   cl_command_queue_init (&clm->command_queue);
 
    if (clal_init() != 0)
    {
@@ -866,3 +934,138 @@ int clm_master_exit (clm_t * clm)
 
    return ret;
 }
+
+int clm_master_submit_command (clm_t * clm, const clm_command_t * command)
+{
+   uint32_t position;
+
+   if (cl_command_queue_reserve (&clm->command_queue, &position) != 0)
+   {
+      return -1;
+   }
+
+   clm->commands[cl_command_queue_slot (position)] = *command;
+   cl_command_queue_publish (&clm->command_queue, position);
+
+   return 0;
+}
+
+/**
+ * Execute a command from an application thread
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ * @param command          Command to be executed
+ * @return 0 on success, or -1 on failure.
+ */
+static int clm_master_execute_command (
+   clm_t * clm,
+   uint32_t now,
+   const clm_command_t * command)
+{
+   switch (command->type)
+   {
+   case CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS:
+      return clm_iefb_set_slave_communication_status (
+         clm,
+         command->group_index,
+         command->slave_device_index,
+         command->enabled);
+   case CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT:
+      return clm_iefb_force_cyclic_transmission_bit (
+         clm,
+         command->group_index,
+         command->slave_device_index,
+         command->force);
+   case CLM_COMMAND_SET_MASTER_APPLICATION_STATUS:
+      clm_iefb_set_master_application_status (
+         clm,
+         command->running,
+         command->stopped_by_user);
+      return 0;
+   case CLM_COMMAND_PERFORM_NODE_SEARCH:
+      if (clm->config.use_separate_slmp_thread)
+      {
+         return clm_slmp_queue_node_search (clm);
+      }
+      return clm_slmp_perform_node_search (clm, now);
+   case CLM_COMMAND_SET_SLAVE_IPADDR:
+      if (clm->config.use_separate_slmp_thread)
+      {
+         return clm_slmp_queue_set_ipaddr_request (
+            clm,
+            &command->slave_mac_addr,
+            command->slave_new_ip_addr,
+            command->slave_new_netmask);
+      }
+      return clm_slmp_perform_set_ipaddr_request (
+         clm,
+         now,
+         &command->slave_mac_addr,
+         command->slave_new_ip_addr,
+         command->slave_new_netmask);
+   default:
+      break;
+   }
+
+   LOG_WARNING (
+      CL_CCIEFB_LOG,
+      "CLM_MASTER(%d): Unknown command type %u\n",
+      __LINE__,
+      (unsigned int)command->type);
+   return -1;
+}
+
+/**
+ * Check if a command modifies a group run by a shard, and thus must be
+ * executed by the thread running the shard.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param command          Command from an application thread
+ * @return true if the command is handed over to a shard
+ */
+static bool clm_master_is_shard_command (
+   const clm_t * clm,
+   const clm_command_t * command)
+{
+   if (clm->config.number_of_shards <= 1)
+   {
+      return false;
+   }
+
+   return command->type == CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS ||
+          command->type == CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT;
+}
+
+void clm_master_handle_commands (clm_t * clm, uint32_t now)
+{
+   const clm_command_t * command;
+   uint32_t position;
+   bool confirm;
+   int result;
+
+   while (cl_command_queue_peek (&clm->command_queue, &position))
+   {
+      command = &clm->commands[cl_command_queue_slot (position)];
+
+      if (clm_master_is_shard_command (clm, command))
+      {
+         /* The group data is owned by the thread running the shard, which
+            executes the command and queues the command callback */
+         result  = clm_iefb_queue_shard_command (clm, command, true);
+         confirm = (result != 0);
+      }
+      else
+      {
+         result  = clm_master_execute_command (clm, now, command);
+         confirm = true;
+      }
+
+      if (confirm && clm->config.command_cfm_cb != NULL)
+      {
+         clm->config.command_cfm_cb (clm, clm->config.cb_arg, command, result);
+      }
+
+      cl_command_queue_release (&clm->command_queue);
+   }
+}
@@ -45,6 +45,24 @@ int clm_master_init (clm_t * clm, const clm_cfg_t * cfg, uint32_t now);
  */
 int clm_master_exit (clm_t * clm);
 
+/**
+ * Queue a command from an application thread
+ *
+ * @param clm              c-link master stack instance handle
+ * @param command          Command to be queued. Contents will be copied.
+ * @return 0 on success, or -1 if the queue is full.
+ */
+int clm_master_submit_command (clm_t * clm, const clm_command_t * command);
+
+/**
+ * Execute the queued commands, and report the results via the command
+ * callback.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ */
+void clm_master_handle_commands (clm_t * clm, uint32_t now);
+
 /************ Internal functions made available for tests *****************/
 
 int clm_validate_config (const clm_cfg_t * cfg);
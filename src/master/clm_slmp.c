@@ -106,7 +106,8 @@ const clm_node_search_db_t * clm_slmp_get_node_search_result (clm_t * clm)
 /**
  * Send a SLMP request
  *
- * Opens a socket, sends the request and closes the socket.
+ * Uses the receive socket if \a use_single_slmp_socket is set. Otherwise
+ * a separate send socket is opened on first use, and is kept open.
  *
  * The request message should be available in clm->slmp_sendbuf
  *
@@ -116,10 +117,21 @@ const clm_node_search_db_t * clm_slmp_get_node_search_result (clm_t * clm)
  */
 static int clm_slmp_send_request (clm_t * clm, size_t request_len)
 {
-   return cl_slmp_udp_send (
-      clm->config.use_single_slmp_socket ? &clm->slmp_receive_socket
-                                         : &clm->slmp_send_socket,
-      !clm->config.use_single_slmp_socket,
+   if (clm->config.use_single_slmp_socket)
+   {
+      return cl_slmp_udp_send (
+         &clm->slmp_receive_socket,
+         false,
+         clm->slmp_sendbuf,
+         sizeof (clm->slmp_sendbuf),
+         clm->config.master_id,
+         clm->slmp_broadcast_ip,
+         CL_SLMP_PORT,
+         request_len);
+   }
+
+   return cl_slmp_udp_send_persistent (
+      &clm->slmp_send_socket,
       clm->slmp_sendbuf,
       sizeof (clm->slmp_sendbuf),
       clm->config.master_id,
@@ -632,6 +644,115 @@ int clm_slmp_perform_set_ipaddr_request (
    return 0;
 }
 
+/********************* Requests from the application ************************/
+
+/**
+ * Queue a SLMP request from the application, to be sent by the SLMP thread.
+ *
+ * Can be called from several threads at the same time.
+ *
+ * @param clm               c-link stack instance handle
+ * @param request           Request to queue
+ * @return 0 on success, -1 if the queue is full
+ */
+static int clm_slmp_queue_request (
+   clm_t * clm,
+   const clm_slmp_request_t * request)
+{
+   uint32_t position;
+
+   if (cl_command_queue_reserve (&clm->slmp_request_queue, &position) != 0)
+   {
+      LOG_INFO (
+         CL_SLMP_LOG,
+         "SLMP(%d): Too many SLMP requests waiting to be sent.\n",
+         __LINE__);
+      return -1;
+   }
+
+   clm->slmp_requests[cl_command_queue_slot (position)] = *request;
+   cl_command_queue_publish (&clm->slmp_request_queue, position);
+
+   return 0;
+}
+
+int clm_slmp_queue_node_search (clm_t * clm)
+{
+   clm_slmp_request_t request;
+
+   clal_clear_memory (&request, sizeof (request));
+   request.type = CLM_SLMP_REQUEST_NODE_SEARCH;
+
+   return clm_slmp_queue_request (clm, &request);
+}
+
+int clm_slmp_queue_set_ipaddr_request (
+   clm_t * clm,
+   const cl_macaddr_t * slave_mac_addr,
+   cl_ipaddr_t slave_new_ip_addr,
+   cl_ipaddr_t slave_new_netmask)
+{
+   clm_slmp_request_t request;
+
+   /* Invalid arguments are reported directly to the application */
+   if (
+      slave_new_ip_addr == CL_IPADDR_INVALID ||
+      cl_utils_is_netmask_valid (slave_new_netmask) == false)
+   {
+      LOG_INFO (
+         CL_SLMP_LOG,
+         "SLMP(%d): The new IP address or netmask is invalid\n",
+         __LINE__);
+      return -1;
+   }
+
+   clal_clear_memory (&request, sizeof (request));
+   request.type = CLM_SLMP_REQUEST_SET_IP;
+   clal_memcpy (
+      &request.slave_mac_addr,
+      sizeof (request.slave_mac_addr),
+      slave_mac_addr,
+      sizeof (cl_macaddr_t));
+   request.slave_new_ip_addr = slave_new_ip_addr;
+   request.slave_new_netmask = slave_new_netmask;
+
+   return clm_slmp_queue_request (clm, &request);
+}
+
+void clm_slmp_handle_queued_requests (clm_t * clm, uint32_t now)
+{
+   const clm_slmp_request_t * request;
+   uint32_t position;
+
+   while (cl_command_queue_peek (&clm->slmp_request_queue, &position))
+   {
+      request = &clm->slmp_requests[cl_command_queue_slot (position)];
+
+      if (request->type == CLM_SLMP_REQUEST_NODE_SEARCH)
+      {
+         (void)clm_slmp_perform_node_search (clm, now);
+      }
+      else if (
+         clm_slmp_perform_set_ipaddr_request (
+            clm,
+            now,
+            &request->slave_mac_addr,
+            request->slave_new_ip_addr,
+            request->slave_new_netmask) != 0 &&
+         clm->config.set_ip_cfm_cb != NULL)
+      {
+         /* The application already got a successful return value, and is
+            waiting for the callback */
+         clm->config.set_ip_cfm_cb (
+            clm,
+            clm->config.cb_arg,
+            CLM_MASTER_SET_IP_STATUS_ERROR);
+      }
+
+      cl_command_queue_release (&clm->slmp_request_queue);
+   }
+}
+
 /********************* Initialize and periodic update ***********************/
 
 /**
@@ -659,7 +780,32 @@ void clm_slmp_check_timeouts (clm_t * clm, uint32_t now)
    }
 }
 
-void clm_slmp_periodic (clm_t * clm, uint32_t now)
+void clm_slmp_update_next_deadline (
+   clm_t * clm,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   cl_timer_update_earliest_deadline (
+      &clm->node_search_timer,
+      now,
+      found,
+      earliest);
+   cl_timer_update_earliest_deadline (
+      &clm->set_ip_request_timer,
+      now,
+      found,
+      earliest);
+}
+
+/**
+ * Receive and handle all available SLMP frames on a socket.
+ *
+ * @param clm              c-link stack instance handle
+ * @param now              Timestamp in microseconds
+ * @param socket           Socket handle
+ */
+static void clm_slmp_receive_from_socket (clm_t * clm, uint32_t now, int socket)
 {
    cl_ipaddr_t remote_ip = 0;
    uint16_t remote_port  = 0;
@@ -667,12 +813,10 @@ void clm_slmp_periodic (clm_t * clm, uint32_t now)
    cl_ipaddr_t local_ip;
    int ifindex;
 
-   clm_slmp_check_timeouts (clm, now);
-
    do
    {
       recv_len = clal_udp_recvfrom_with_ifindex (
-         clm->slmp_receive_socket,
+         socket,
          &remote_ip,
          &remote_port,
          &local_ip,
@@ -694,6 +838,43 @@ void clm_slmp_periodic (clm_t * clm, uint32_t now)
    } while (recv_len > 0);
 }
 
+void clm_slmp_handle_readable (clm_t * clm, uint32_t now)
+{
+   clm_slmp_receive_from_socket (clm, now, clm->slmp_receive_socket);
+
+   /* The send socket is bound to our IP address and the SLMP port. This is
+      more specific than the binding of the receive socket, so the
+      operating system might deliver incoming unicast SLMP frames to it. */
+   if (clm->slmp_send_socket.handle != -1)
+   {
+      clm_slmp_receive_from_socket (clm, now, clm->slmp_send_socket.handle);
+   }
+}
+
+void clm_slmp_periodic (clm_t * clm, uint32_t now)
+{
+   clm_slmp_check_timeouts (clm, now);
+   clm_slmp_handle_readable (clm, now);
+}
+
+int clm_slmp_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   if (*number_of_sockets >= max_sockets)
+   {
+      return -1;
+   }
+
+   sockets[*number_of_sockets].handle = clm->slmp_receive_socket;
+   sockets[*number_of_sockets].role   = CL_SOCKET_ROLE_SLMP;
+   (*number_of_sockets)++;
+
+   return 0;
+}
+
 int clm_slmp_init (clm_t * clm)
 {
    LOG_DEBUG (
@@ -706,6 +887,7 @@ int clm_slmp_init (clm_t * clm)
    clm->slmp_request_serial   = 0;
    clm->node_search_serial    = CLM_SLMP_SERIAL_NONE;
    clm->set_ip_request_serial = CLM_SLMP_SERIAL_NONE;
+   cl_command_queue_init (&clm->slmp_request_queue);
    cl_timer_stop (&clm->node_search_timer);    /* Initialise timer */
    cl_timer_stop (&clm->set_ip_request_timer); /* Initialise timer */
    clm_slmp_node_search_clear_db (&clm->node_search_db);
@@ -720,8 +902,9 @@ int clm_slmp_init (clm_t * clm)
    clm->slmp_receive_socket = -1;
 #endif
 
-   /* The clm->slmp_send_socket (if used) is opened just before use */
-   clm->slmp_send_socket = -1;
+   /* The clm->slmp_send_socket (if used) is opened on first use */
+   clm->slmp_send_socket.handle   = -1;
+   clm->slmp_send_socket.local_ip = CL_IPADDR_INVALID;
 
    LOG_DEBUG (
       CL_SLMP_LOG,
@@ -739,4 +922,6 @@ void clm_slmp_exit (clm_t * clm)
 
    clal_udp_close (clm->slmp_receive_socket);
    clm->slmp_receive_socket = -1;
+
+   cl_slmp_udp_close_persistent (&clm->slmp_send_socket);
 }
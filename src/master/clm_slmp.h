@@ -51,6 +51,48 @@ void clm_slmp_exit (clm_t * clm);
  */
 void clm_slmp_periodic (clm_t * clm, uint32_t now);
 
+/**
+ * Receive and handle all available frames on the SLMP socket.
+ *
+ * Does not handle any timers. This is done by \a clm_slmp_periodic().
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ */
+void clm_slmp_handle_readable (clm_t * clm, uint32_t now);
+
+/**
+ * Add the SLMP socket handle to a list of sockets.
+ *
+ * @param clm                 c-link master stack instance handle
+ * @param sockets             List of sockets
+ * @param max_sockets         Number of elements in \a sockets
+ * @param number_of_sockets   Number of used elements in \a sockets. Will
+ *                            be increased by the number of added sockets.
+ * @return 0 on success, -1 if the list is too small
+ */
+int clm_slmp_get_sockets (
+   clm_t * clm,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Find the earliest deadline among the master SLMP timers.
+ *
+ * @param clm              c-link master stack instance handle
+ * @param now              timestamp in microseconds
+ * @param found            Set to true if any timer is running
+ * @param earliest         Time until the earliest deadline found so far, in
+ *                         microseconds. Updated if an earlier deadline is
+ *                         found.
+ */
+void clm_slmp_update_next_deadline (
+   clm_t * clm,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
 /**
  * Perform a node search
  *
@@ -89,6 +131,44 @@ int clm_slmp_perform_set_ipaddr_request (
    cl_ipaddr_t slave_new_ip_addr,
    cl_ipaddr_t slave_new_netmask);
 
+/**
+ * Queue a node search request, to be sent by the SLMP thread.
+ *
+ * Only used if \a use_separate_slmp_thread is enabled.
+ *
+ * @param clm               c-link stack instance handle
+ * @return 0 on success, -1 if the queue is full
+ */
+int clm_slmp_queue_node_search (clm_t * clm);
+
+/**
+ * Queue a set IP address request, to be sent by the SLMP thread.
+ *
+ * Only used if \a use_separate_slmp_thread is enabled.
+ *
+ * @param clm                c-link stack instance handle
+ * @param slave_mac_addr     Slave MAC address
+ * @param slave_new_ip_addr  New IP address
+ * @param slave_new_netmask  New netmask
+ * @return 0 on success, -1 on invalid arguments or if the queue is full
+ */
+int clm_slmp_queue_set_ipaddr_request (
+   clm_t * clm,
+   const cl_macaddr_t * slave_mac_addr,
+   cl_ipaddr_t slave_new_ip_addr,
+   cl_ipaddr_t slave_new_netmask);
+
+/**
+ * Send the queued SLMP requests from the application.
+ *
+ * Call it from the SLMP thread. A set IP request that fails is reported
+ * via the set IP callback.
+ *
+ * @param clm               c-link stack instance handle
+ * @param now               Current timestamp, in microseconds
+ */
+void clm_slmp_handle_queued_requests (clm_t * clm, uint32_t now);
+
 /************ Internal functions made available for tests *******************/
 
 int clm_slmp_node_search_add_db (
@@ -87,11 +87,97 @@ void cls_handle_periodic (cls_t * cls)
 
    CC_ASSERT (cls != NULL);
 
+   cls_slave_handle_commands (cls);
+
    /* We might have received SLMP command to change IP, so run SLMP first */
-   cls_slmp_periodic (cls, now);
+   if (!cls->config.use_separate_slmp_thread)
+   {
+      cls_slmp_periodic (cls, now);
+   }
    cls_iefb_periodic (cls, now);
 }
 
+int cls_handle_slmp_periodic (cls_t * cls)
+{
+   uint32_t now = os_get_current_time_us();
+
+   if (cls == NULL || !cls->config.use_separate_slmp_thread)
+   {
+      return -1;
+   }
+
+   cls_slmp_periodic (cls, now);
+
+   return 0;
+}
+
+int cls_get_next_deadline_us (cls_t * cls, uint32_t * time_to_deadline)
+{
+   uint32_t now      = os_get_current_time_us();
+   bool found        = false;
+   uint32_t earliest = 0;
+
+   if (cls == NULL || time_to_deadline == NULL)
+   {
+      return -1;
+   }
+
+   if (!cls->config.use_separate_slmp_thread)
+   {
+      cls_slmp_update_next_deadline (cls, now, &found, &earliest);
+   }
+   cls_iefb_update_next_deadline (cls, now, &found, &earliest);
+   if (!found)
+   {
+      return -1;
+   }
+
+   *time_to_deadline = earliest;
+   return 0;
+}
+
+int cls_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   uint16_t count = 0;
+
+   if (cls == NULL || sockets == NULL || number_of_sockets == NULL)
+   {
+      return -1;
+   }
+
+   if (
+      cls_iefb_get_sockets (cls, sockets, max_sockets, &count) != 0 ||
+      cls_slmp_get_sockets (cls, sockets, max_sockets, &count) != 0)
+   {
+      return -1;
+   }
+
+   *number_of_sockets = count;
+   return 0;
+}
+
+void cls_handle_cciefb_readable (cls_t * cls)
+{
+   uint32_t now = os_get_current_time_us();
+
+   CC_ASSERT (cls != NULL);
+
+   cls_iefb_handle_readable (cls, now);
+}
+
+void cls_handle_slmp_readable (cls_t * cls)
+{
+   uint32_t now = os_get_current_time_us();
+
+   CC_ASSERT (cls != NULL);
+
+   cls_slmp_handle_readable (cls, now);
+}
+
 void cls_stop_cyclic_data (cls_t * cls, bool is_error)
 {
    uint32_t now = os_get_current_time_us();
@@ -164,6 +250,16 @@ uint16_t cls_get_slave_error_code (cls_t * cls)
    return cls_iefb_get_slave_error_code (cls);
 }
 
+int cls_submit_command (cls_t * cls, const cls_command_t * command)
+{
+   if (cls == NULL || command == NULL)
+   {
+      return -1;
+   }
+
+   return cls_slave_submit_command (cls, command);
+}
+
 const cls_master_connection_t * cls_get_master_connection_details (cls_t * cls)
 {
    if (cls == NULL)
@@ -174,6 +270,24 @@ const cls_master_connection_t * cls_get_master_connection_details (cls_t * cls)
    return cls_iefb_get_master_connection_details (cls);
 }
 
+const cls_cciefb_receive_statistics_t * cls_get_cciefb_receive_statistics (
+   cls_t * cls)
+{
+   if (cls == NULL)
+   {
+      return NULL;
+   }
+
+   return &cls->cciefb_receive_statistics;
+}
+
+void cls_clear_cciefb_receive_statistics (cls_t * cls)
+{
+   CC_ASSERT (cls != NULL);
+
+   cls_iefb_clear_receive_statistics (cls);
+}
+
 cl_rx_t * cls_get_first_rx_area (cls_t * cls)
 {
    if (cls == NULL)
@@ -214,6 +328,17 @@ const cl_rww_t * cls_get_first_rww_area (cls_t * cls)
    return cls_iefb_get_first_rww_area (cls);
 }
 
+int cls_get_changed_inputs (cls_t * cls, cl_changed_signals_t * changed)
+{
+   if (cls == NULL || changed == NULL)
+   {
+      return -1;
+   }
+
+   cls_iefb_get_changed_inputs (cls, changed);
+   return 0;
+}
+
 void cls_set_rx_bit (cls_t * cls, uint16_t number, bool value)
 {
    CC_ASSERT (cls != NULL);
@@ -255,3 +380,59 @@ uint16_t cls_get_rww_value (cls_t * cls, uint16_t number)
 
    return cls_iefb_get_rww_value (cls, number);
 }
+
+int cls_set_rx_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values)
+{
+   if (cls == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return cls_iefb_set_rx_bits (cls, first_number, num_bits, values);
+}
+
+int cls_get_ry_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values)
+{
+   if (cls == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return cls_iefb_get_ry_bits (cls, first_number, num_bits, values);
+}
+
+int cls_set_rwr_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values)
+{
+   if (cls == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return cls_iefb_set_rwr_values (cls, first_number, num_values, values);
+}
+
+int cls_get_rww_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values)
+{
+   if (cls == NULL || values == NULL)
+   {
+      return -1;
+   }
+
+   return cls_iefb_get_rww_values (cls, first_number, num_values, values);
+}
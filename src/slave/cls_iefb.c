@@ -23,6 +23,8 @@
 #define clal_udp_open                  mock_clal_udp_open
 #define clal_udp_recvfrom_with_ifindex mock_clal_udp_recvfrom_with_ifindex
 #define clal_udp_sendto                mock_clal_udp_sendto
+#define clal_udp_set_profile           mock_clal_udp_set_profile
+#define clal_udp_read_error_queue      mock_clal_udp_read_error_queue
 #define clal_udp_close                 mock_clal_udp_close
 #endif
 
@@ -121,6 +123,10 @@ void cls_iefb_log_warning_once (
 /**
  * Copy incoming cyclic data from CCIEFB request
  *
+ * Signals that differ from the previously stored data are accumulated for
+ * \a cls_iefb_get_changed_inputs(), and reported via the inputs changed
+ * callback (if implemented).
+ *
  * @param cls                    c-link slave stack instance handle
  * @param request                Incoming CCIEFB request
  * @param start_number           Our slave station start number
@@ -144,6 +150,11 @@ int cls_iefb_copy_cyclic_data_from_request (
    const cl_ry_t * our_first_request_ry   = NULL;
    const cl_rww_t * our_first_request_rww = NULL;
    uint16_t num_occupied_stations         = cls->config.num_occupied_stations;
+   bool any_changed                       = false;
+   const uint8_t * incoming_rww;
+   const uint8_t * incoming_ry;
+   cl_changed_signals_t changed;
+   uint16_t i;
    uint16_t end_number     = start_number + num_occupied_stations - 1;
    uint16_t total_occupied = CC_FROM_LE16 (
       request->full_headers->cyclic_data_header.slave_total_occupied_station_count);
@@ -177,6 +188,30 @@ int cls_iefb_copy_cyclic_data_from_request (
       return -1;
    }
 
+   /* Compare before storing. The incoming areas might be unaligned. */
+   changed.num_occupied_stations = num_occupied_stations;
+   for (i = 0; i < num_occupied_stations; i++)
+   {
+      incoming_rww = transmission_bit
+                        ? (const uint8_t *)&our_first_request_rww[i]
+                        : NULL;
+      incoming_ry  = transmission_bit
+                        ? (const uint8_t *)&our_first_request_ry[i]
+                        : NULL;
+
+      changed.words[i] = cl_util_calc_changed_words (
+         (const uint8_t *)&cls->cyclic_data_area.rww[i],
+         incoming_rww);
+      changed.bits[i] = cl_util_calc_changed_bits (
+         cls->cyclic_data_area.ry[i].bytes,
+         incoming_ry);
+
+      cls->changed_rww[i] |= changed.words[i];
+      cls->changed_ry[i] |= changed.bits[i];
+      any_changed = any_changed || changed.words[i] != 0 ||
+                    changed.bits[i] != 0;
+   }
+
    if (transmission_bit)
    {
       clal_memcpy (
@@ -200,6 +235,11 @@ int cls_iefb_copy_cyclic_data_from_request (
          num_occupied_stations * sizeof (cl_rww_t));
    }
 
+   if (any_changed && cls->config.inputs_changed_cb != NULL)
+   {
+      cls->config.inputs_changed_cb (cls, cls->config.cb_arg, &changed);
+   }
+
    return 0;
 }
 
@@ -564,6 +604,21 @@ const cl_rww_t * cls_iefb_get_first_rww_area (cls_t * cls)
    return (cl_rww_t *)&cls->cyclic_data_area.rww;
 }
 
+void cls_iefb_get_changed_inputs (cls_t * cls, cl_changed_signals_t * changed)
+{
+   uint16_t i;
+
+   clal_clear_memory (changed, sizeof (*changed));
+   changed->num_occupied_stations = cls->config.num_occupied_stations;
+   for (i = 0; i < cls->config.num_occupied_stations; i++)
+   {
+      changed->bits[i]     = cls->changed_ry[i];
+      changed->words[i]    = cls->changed_rww[i];
+      cls->changed_ry[i]  = 0;
+      cls->changed_rww[i] = 0;
+   }
+}
+
 void cls_iefb_set_rx_bit (cls_t * cls, uint16_t number, bool value)
 {
    uint8_t mask;
@@ -659,6 +714,98 @@ uint16_t cls_iefb_get_rww_value (cls_t * cls, uint16_t number)
       cls->cyclic_data_area.rww[areanumber].words[register_in_area]);
 }
 
+int cls_iefb_set_rx_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values)
+{
+   const uint32_t max_signals =
+      (uint32_t)cls->config.num_occupied_stations * CL_BITSIGNALS_PER_AREA;
+   cl_rx_t * first_area;
+
+   if (!cl_iefb_is_signal_range_valid (first_number, num_bits, max_signals))
+   {
+      return -1;
+   }
+
+   first_area = cl_iefb_get_rx_area (&cls->cciefb_resp_frame_normal, 0);
+   cl_iefb_pack_bits (first_area->bytes, first_number, num_bits, values);
+
+   return 0;
+}
+
+int cls_iefb_get_ry_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values)
+{
+   const uint32_t max_signals =
+      (uint32_t)cls->config.num_occupied_stations * CL_BITSIGNALS_PER_AREA;
+
+   if (!cl_iefb_is_signal_range_valid (first_number, num_bits, max_signals))
+   {
+      return -1;
+   }
+
+   cl_iefb_unpack_bits (
+      cls->cyclic_data_area.ry[0].bytes,
+      first_number,
+      num_bits,
+      values);
+
+   return 0;
+}
+
+int cls_iefb_set_rwr_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values)
+{
+   const uint32_t max_signals =
+      (uint32_t)cls->config.num_occupied_stations * CL_WORDSIGNALS_PER_AREA;
+   cl_rwr_t * first_area;
+
+   if (!cl_iefb_is_signal_range_valid (first_number, num_values, max_signals))
+   {
+      return -1;
+   }
+
+   first_area = cl_iefb_get_rwr_area (&cls->cciefb_resp_frame_normal, 0);
+   cl_iefb_write_words (
+      (uint8_t *)first_area->words,
+      first_number,
+      num_values,
+      values);
+
+   return 0;
+}
+
+int cls_iefb_get_rww_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values)
+{
+   const uint32_t max_signals =
+      (uint32_t)cls->config.num_occupied_stations * CL_WORDSIGNALS_PER_AREA;
+
+   if (!cl_iefb_is_signal_range_valid (first_number, num_values, max_signals))
+   {
+      return -1;
+   }
+
+   cl_iefb_read_words (
+      (const uint8_t *)cls->cyclic_data_area.rww[0].words,
+      first_number,
+      num_values,
+      values);
+
+   return 0;
+}
+
 /***************************************************************************/
 
 /**
@@ -1129,6 +1276,8 @@ cls_slave_event_t cls_iefb_handle_new_or_updated_master (
    cls->master.clock_info_valid = cls->master.clock_info != 0;
    cls->master.protocol_ver =
       CC_FROM_LE16 (request->full_headers->cyclic_header.protocol_ver);
+   cls->expected_request_size = cl_calculate_cyclic_request_size (
+      cls->master.total_occupied_station_count);
 
 #if LOG_INFO_ENABLED(CL_CCIEFB_LOG)
    cl_util_ip_to_string (cls->master.master_id, master_ip_string);
@@ -1722,7 +1871,6 @@ static int cls_iefb_handle_cyclic_input_frame (
    cl_ipaddr_t master_id                           = 0;
    uint16_t parameter_no                           = 0;
    uint16_t frame_sequence_no                      = 0;
-   uint16_t total_occupied                         = 0;
    cl_ipaddr_t extracted_slave_id                  = CL_IPADDR_INVALID;
    cl_cciefb_cyclic_req_data_header_t * cyclic_data_header;
 
@@ -1739,6 +1887,7 @@ static int cls_iefb_handle_cyclic_input_frame (
          remote_ip,
          remote_port,
          slave_ip_addr,
+         &cls->request_template,
          &cyclic_request) != 0)
    {
       return -1;
@@ -1774,8 +1923,6 @@ static int cls_iefb_handle_cyclic_input_frame (
    parameter_no       = CC_FROM_LE16 (cyclic_data_header->parameter_no);
    group_no           = cyclic_data_header->group_no; /* uint8_t in frame */
    frame_sequence_no  = CC_FROM_LE16 (cyclic_data_header->frame_sequence_no);
-   total_occupied = CC_FROM_LE16 (cyclic_request.full_headers->cyclic_data_header
-                                     .slave_total_occupied_station_count);
 
    if (cls_iefb_is_master_id_correct (cls, master_id) == false)
    {
@@ -1811,12 +1958,25 @@ static int cls_iefb_handle_cyclic_input_frame (
       return 0;
    }
 
+   /* The station assignment is cached for this master, parameter number
+      and group. The frame size follows the total number of occupied
+      stations, so a changed size means a changed slave ID list. */
+   if (recv_len != cls->expected_request_size)
+   {
+      LOG_DEBUG (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Changed number of occupied stations, search "
+         "parameters\n",
+         __LINE__);
+      return cls_iefb_search_slave_parameters (cls, now, &cyclic_request);
+   }
+
    /* Verify that our SlaveId in the frame still is valid */
    if (
       cl_iefb_request_get_slave_id (
          cyclic_request.first_slave_id,
          cls->master.slave_station_no,
-         total_occupied,
+         cls->master.total_occupied_station_count,
          &extracted_slave_id) != 0)
    {
       return -1;
@@ -1947,26 +2107,89 @@ int cls_iefb_get_master_timestamp (cls_t * cls, uint64_t * master_timestamp)
    return -1;
 }
 
-void cls_iefb_periodic (cls_t * cls, uint32_t now)
+/**
+ * Update the statistics for incoming CCIEFB frames.
+ *
+ * @param statistics       Statistics to be updated
+ * @param processed        Number of frames handled in this tick
+ */
+static void cls_iefb_update_receive_statistics (
+   cls_cciefb_receive_statistics_t * statistics,
+   uint16_t processed)
+{
+   statistics->processed_latest = processed;
+   statistics->processed_max    = MAX (statistics->processed_max, processed);
+   statistics->processed_total += processed;
+   if (processed >= CLS_CCIEFB_MAX_FRAMES_PER_TICK)
+   {
+      statistics->deferred_ticks++;
+   }
+}
+
+/**
+ * Drain the error queue of the CCIEFB socket, and count the ICMP errors.
+ *
+ * @param cls              c-link slave stack instance handle
+ */
+static void cls_iefb_read_error_queue (cls_t * cls)
+{
+   clal_udp_error_queue_entry_t entries[CLS_CCIEFB_MAX_FRAMES_PER_TICK];
+   int num_read;
+   int i;
+
+   do
+   {
+      num_read = clal_udp_read_error_queue (
+         cls->cciefb_socket,
+         entries,
+         NELEMENTS (entries));
+      for (i = 0; i < num_read; i++)
+      {
+         if (entries[i].type == CLAL_UDP_ERROR_QUEUE_ICMP_ERROR)
+         {
+            cls->cciefb_receive_statistics.icmp_errors++;
+            LOG_DEBUG (
+               CL_CCIEFB_LOG,
+               "CCIEFB(%d): ICMP error %d from IP 0x%08" PRIX32 ".\n",
+               __LINE__,
+               entries[i].error,
+               entries[i].offender_ip);
+         }
+      }
+   } while (num_read == (int)NELEMENTS (entries));
+}
+
+void cls_iefb_handle_readable (cls_t * cls, uint32_t now)
 {
    cl_ipaddr_t remote_ip;
    uint16_t remote_port;
    cl_ipaddr_t slave_ip_addr;
    ssize_t recv_len;
    int ifindex;
+   uint16_t processed = 0;
+
+   cls_iefb_read_error_queue (cls);
+
+   /* Drain the socket, but limit the number of frames handled per tick.
+      Remaining frames are handled next tick. */
+   while (processed < CLS_CCIEFB_MAX_FRAMES_PER_TICK)
+   {
+      /* We need both the remote and local IP addresses, but not the
+         ifindex */
+      recv_len = clal_udp_recvfrom_with_ifindex (
+         cls->cciefb_socket,
+         &remote_ip,
+         &remote_port,
+         &slave_ip_addr,
+         &ifindex,
+         cls->cciefb_receivebuf,
+         sizeof (cls->cciefb_receivebuf));
 
-   /* We need both the remote and local IP addresses, but not the ifindex */
-   recv_len = clal_udp_recvfrom_with_ifindex (
-      cls->cciefb_socket,
-      &remote_ip,
-      &remote_port,
-      &slave_ip_addr,
-      &ifindex,
-      cls->cciefb_receivebuf,
-      sizeof (cls->cciefb_receivebuf));
+      if (recv_len <= 0)
+      {
+         break;
+      }
 
-   if (recv_len > 0)
-   {
       (void)cls_iefb_handle_input_frame (
          cls,
          now,
@@ -1975,8 +2198,18 @@ void cls_iefb_periodic (cls_t * cls, uint32_t now)
          remote_ip,
          remote_port,
          slave_ip_addr);
+      processed++;
    }
 
+   cls_iefb_update_receive_statistics (
+      &cls->cciefb_receive_statistics,
+      processed);
+}
+
+void cls_iefb_periodic (cls_t * cls, uint32_t now)
+{
+   cls_iefb_handle_readable (cls, now);
+
    /* Timer for monitoring incoming cyclic data */
    if (cl_timer_is_expired (&cls->receive_timer, now))
    {
@@ -1995,6 +2228,34 @@ void cls_iefb_periodic (cls_t * cls, uint32_t now)
    cl_limiter_periodic (&cls->loglimiter, now);
 }
 
+void cls_iefb_update_next_deadline (
+   cls_t * cls,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   cl_timer_update_earliest_deadline (
+      &cls->receive_timer,
+      now,
+      found,
+      earliest);
+   cl_timer_update_earliest_deadline (
+      &cls->timer_for_disabling_slave,
+      now,
+      found,
+      earliest);
+   cl_timer_update_earliest_deadline (
+      &cls->errorlimiter.timer,
+      now,
+      found,
+      earliest);
+   cl_timer_update_earliest_deadline (
+      &cls->loglimiter.timer,
+      now,
+      found,
+      earliest);
+}
+
 void cls_iefb_set_local_management_info (cls_t * cls, uint32_t local_management_info)
 {
    cls->local_management_info = local_management_info;
@@ -2032,6 +2293,82 @@ const cls_master_connection_t * cls_iefb_get_master_connection_details (cls_t *
    return &cls->master;
 }
 
+void cls_iefb_clear_receive_statistics (cls_t * cls)
+{
+   clal_clear_memory (
+      &cls->cciefb_receive_statistics,
+      sizeof (cls->cciefb_receive_statistics));
+}
+
+int cls_iefb_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   if (*number_of_sockets >= max_sockets)
+   {
+      return -1;
+   }
+
+   sockets[*number_of_sockets].handle = cls->cciefb_socket;
+   sockets[*number_of_sockets].role   = CL_SOCKET_ROLE_CCIEFB;
+   (*number_of_sockets)++;
+
+   return 0;
+}
+
+uint32_t cls_iefb_calc_receive_buffer_size (void)
+{
+   /* Requests are sized for the largest possible group, as the number of
+      occupied stations in the master group is unknown here. */
+   return (uint32_t)CLS_CCIEFB_MAX_FRAMES_PER_TICK *
+          ((uint32_t)cl_calculate_cyclic_request_size (
+              CL_CCIEFB_MAX_OCCUPIED_STATIONS_PER_GROUP) +
+           CL_SOCKET_RECEIVE_OVERHEAD_PER_FRAME);
+}
+
+/**
+ * Apply the configured socket profile to the CCIEFB socket.
+ *
+ * A failure is not fatal, as the cyclic communication works also with the
+ * operating system default settings.
+ *
+ * @param cls              c-link slave stack instance handle
+ */
+static void cls_iefb_apply_socket_profile (cls_t * cls)
+{
+   const cl_socket_profile_t * setting = &cls->config.cciefb_socket_profile;
+   clal_socket_profile_t profile;
+   clal_socket_profile_t result;
+
+   profile.busy_poll_us        = setting->busy_poll_us;
+   profile.receive_buffer_size = setting->receive_buffer_size;
+   profile.priority            = setting->priority;
+   profile.dscp                = setting->dscp;
+   profile.enable_error_queue  = setting->enable_error_queue;
+
+   if (setting->receive_buffer_for_burst)
+   {
+      profile.receive_buffer_size = cls_iefb_calc_receive_buffer_size ();
+   }
+
+   if (clal_udp_set_profile (cls->cciefb_socket, &profile, &result) != 0)
+   {
+      LOG_WARNING (
+         CL_CCIEFB_LOG,
+         "CCIEFB(%d): Could not apply all socket profile settings for socket "
+         "%d.\n",
+         __LINE__,
+         cls->cciefb_socket);
+   }
+
+   cl_util_socket_profile_from_clal (
+      &result,
+      setting->receive_buffer_for_burst,
+      &cls->cciefb_socket_profile);
+}
+
 int cls_iefb_init (cls_t * cls, uint32_t now)
 {
    cl_limiter_init (&cls->loglimiter, CLS_CCIEFB_LOGWARNING_RETRIGGER_PERIOD);
@@ -2060,10 +2397,12 @@ int cls_iefb_init (cls_t * cls, uint32_t now)
          __LINE__);
       return -1;
    }
+   cls_iefb_apply_socket_profile (cls);
 #else
    cls->cciefb_socket = -1;
 #endif
 
+   cls_iefb_clear_receive_statistics (cls);
    cls_fsm_init (cls, now);
 
    return 0;
@@ -22,6 +22,17 @@ extern "C" {
 #include "cls_api.h"
 #include "common/cl_types.h"
 
+/**
+ * Calculate the socket receive buffer size needed for the worst case burst
+ * of incoming CCIEFB request frames.
+ *
+ * This is the largest possible request frame, for the number of frames
+ * handled per tick (\a CLS_CCIEFB_MAX_FRAMES_PER_TICK).
+ *
+ * @return the receive buffer size in bytes
+ */
+uint32_t cls_iefb_calc_receive_buffer_size (void);
+
 /**
  * Initialise CCIEFB
  *
@@ -54,6 +65,48 @@ void cls_iefb_exit (cls_t * cls);
  */
 void cls_iefb_periodic (cls_t * cls, uint32_t now);
 
+/**
+ * Receive and handle an incoming frame on the CCIEFB socket, if available.
+ *
+ * Does not handle any timers. This is done by \a cls_iefb_periodic().
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param now              timestamp in microseconds
+ */
+void cls_iefb_handle_readable (cls_t * cls, uint32_t now);
+
+/**
+ * Add the CCIEFB socket handle to a list of sockets.
+ *
+ * @param cls                 c-link slave stack instance handle
+ * @param sockets             List of sockets
+ * @param max_sockets         Number of elements in \a sockets
+ * @param number_of_sockets   Number of used elements in \a sockets. Will
+ *                            be increased by the number of added sockets.
+ * @return 0 on success, -1 if the list is too small
+ */
+int cls_iefb_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Find the earliest deadline among the CCIEFB timers.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param now              timestamp in microseconds
+ * @param found            Set to true if any timer is running
+ * @param earliest         Time until the earliest deadline found so far, in
+ *                         microseconds. Updated if an earlier deadline is
+ *                         found.
+ */
+void cls_iefb_update_next_deadline (
+   cls_t * cls,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
 /**
  * Tell the PLC to stop the cyclic communication.
  *
@@ -134,6 +187,15 @@ cl_rwr_t * cls_iefb_get_first_rwr_area (cls_t * cls);
  */
 const cl_rww_t * cls_iefb_get_first_rww_area (cls_t * cls);
 
+/**
+ * Get the changed RY bits and RWw registers since the previous call.
+ * Clears the accumulated changes.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param changed          Resulting changed signals
+ */
+void cls_iefb_get_changed_inputs (cls_t * cls, cl_changed_signals_t * changed);
+
 /**
  * Set an individual bit for sending to the PLC.
  *
@@ -206,6 +268,66 @@ uint16_t cls_iefb_get_rwr_value (cls_t * cls, uint16_t number);
  */
 uint16_t cls_iefb_get_rww_value (cls_t * cls, uint16_t number);
 
+/**
+ * Set a range of bits (RX) for sending to the PLC.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First bit number. Use 0 for RX0.
+ * @param num_bits         Number of bits
+ * @param values           Bit values
+ * @return 0 on success, -1 on failure
+ */
+int cls_iefb_set_rx_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   const bool * values);
+
+/**
+ * Read a range of bits (RY) from the PLC.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First bit number. Use 0 for RY0.
+ * @param num_bits         Number of bits
+ * @param values           Resulting bit values
+ * @return 0 on success, -1 on failure
+ */
+int cls_iefb_get_ry_bits (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_bits,
+   bool * values);
+
+/**
+ * Set a range of 16-bit register values (RWr) for sending to the PLC.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First register number. Use 0 for RWr0.
+ * @param num_values       Number of registers
+ * @param values           Register values
+ * @return 0 on success, -1 on failure
+ */
+int cls_iefb_set_rwr_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   const uint16_t * values);
+
+/**
+ * Read a range of 16-bit register values (RWw) from the PLC.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param first_number     First register number. Use 0 for RWw0.
+ * @param num_values       Number of registers
+ * @param values           Resulting register values
+ * @return 0 on success, -1 on failure
+ */
+int cls_iefb_get_rww_values (
+   cls_t * cls,
+   uint16_t first_number,
+   uint16_t num_values,
+   uint16_t * values);
+
 /**
  * Get the master timestamp
  *
@@ -283,6 +405,13 @@ uint16_t cls_iefb_get_slave_error_code (cls_t * cls);
 const cls_master_connection_t * cls_iefb_get_master_connection_details (
    cls_t * cls);
 
+/**
+ * Clear the statistics for incoming CCIEFB frames.
+ *
+ * @param cls        c-link slave stack instance handle
+ */
+void cls_iefb_clear_receive_statistics (cls_t * cls);
+
 /************ Internal functions made available for tests *******************/
 
 void cls_iefb_log_warning_once (
@@ -48,6 +48,10 @@
 #error "CLS_MAX_OCCUPIED_STATIONS is too large"
 #endif
 
+#if CLS_CCIEFB_MAX_FRAMES_PER_TICK < 1
+#error "CLS_CCIEFB_MAX_FRAMES_PER_TICK is too small"
+#endif
+
 #define CLS_SLAVE_BITS_PER_LINE  32U
 #define CLS_SLAVE_WORDS_PER_LINE 8U
 
@@ -87,6 +91,21 @@ int cls_validate_config (const cls_cfg_t * cfg)
       return -1;
    }
 
+   /* Socket profile */
+   if (!cl_utils_is_socket_profile_valid (&cfg->cciefb_socket_profile))
+   {
+      LOG_ERROR (
+         CL_CCIEFB_LOG,
+         "CLS_SLAVE(%d): Invalid CCIEFB socket profile. Given priority %u "
+         "(max %u) and DSCP %u (max %u).\n",
+         __LINE__,
+         cfg->cciefb_socket_profile.priority,
+         CL_SOCKET_PRIORITY_MAX,
+         cfg->cciefb_socket_profile.dscp,
+         CL_SOCKET_DSCP_MAX);
+      return -1;
+   }
+
    return 0;
 }
 
@@ -127,6 +146,16 @@ void cls_slave_config_show (const cls_cfg_t * cfg)
       CL_CCIEFB_LOG,
       "  Bind IP address for cyclic data socket: %s\n",
       ip_string);
+   LOG_DEBUG (
+      CL_CCIEFB_LOG,
+      "  CCIEFB socket profile: busy poll %" PRIu32 " us, receive buffer %" PRIu32
+      " bytes%s, priority %u, DSCP %u, error queue %s\n",
+      cfg->cciefb_socket_profile.busy_poll_us,
+      cfg->cciefb_socket_profile.receive_buffer_size,
+      cfg->cciefb_socket_profile.receive_buffer_for_burst ? " (for burst)" : "",
+      cfg->cciefb_socket_profile.priority,
+      cfg->cciefb_socket_profile.dscp,
+      cfg->cciefb_socket_profile.enable_error_queue ? "Yes" : "No");
    LOG_DEBUG (CL_CCIEFB_LOG, "  Vendor code: 0x%04" PRIx16 "\n", cfg->vendor_code);
    LOG_DEBUG (CL_CCIEFB_LOG, "  Model code: 0x%08" PRIx32 "\n", cfg->model_code);
    LOG_DEBUG (
@@ -303,6 +332,7 @@ int cls_slave_init (cls_t * cls, const cls_cfg_t * cfg, uint32_t now)
    LOG_DEBUG (CL_CCIEFB_LOG, "CLS_SLAVE(%d): Initialising\n", __LINE__);
 
    clal_clear_memory (cls, sizeof (*cls));
+   cl_command_queue_init (&cls->command_queue);
 
    if (clal_init() != 0)
    {
@@ -352,3 +382,74 @@ int cls_slave_exit (cls_t * cls)
 
    return ret;
 }
+
+int cls_slave_submit_command (cls_t * cls, const cls_command_t * command)
+{
+   uint32_t position;
+
+   if (cl_command_queue_reserve (&cls->command_queue, &position) != 0)
+   {
+      return -1;
+   }
+
+   cls->commands[cl_command_queue_slot (position)] = *command;
+   cl_command_queue_publish (&cls->command_queue, position);
+
+   return 0;
+}
+
+/**
+ * Execute a command from an application thread
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param command          Command to be executed
+ * @return 0 on success, or -1 on failure.
+ */
+static int cls_slave_execute_command (
+   cls_t * cls,
+   const cls_command_t * command)
+{
+   switch (command->type)
+   {
+   case CLS_COMMAND_SET_SLAVE_APPLICATION_STATUS:
+      cls_iefb_set_slave_application_status (
+         cls,
+         command->slave_application_status);
+      return 0;
+   case CLS_COMMAND_SET_LOCAL_MANAGEMENT_INFO:
+      cls_iefb_set_local_management_info (cls, command->local_management_info);
+      return 0;
+   case CLS_COMMAND_SET_SLAVE_ERROR_CODE:
+      cls_iefb_set_slave_error_code (cls, command->slave_err_code);
+      return 0;
+   default:
+      break;
+   }
+
+   LOG_WARNING (
+      CL_CCIEFB_LOG,
+      "CLS_SLAVE(%d): Unknown command type %u\n",
+      __LINE__,
+      (unsigned int)command->type);
+   return -1;
+}
+
+void cls_slave_handle_commands (cls_t * cls)
+{
+   const cls_command_t * command;
+   uint32_t position;
+   int result;
+
+   while (cl_command_queue_peek (&cls->command_queue, &position))
+   {
+      command = &cls->commands[cl_command_queue_slot (position)];
+      result  = cls_slave_execute_command (cls, command);
+
+      if (cls->config.command_cfm_cb != NULL)
+      {
+         cls->config.command_cfm_cb (cls, cls->config.cb_arg, command, result);
+      }
+
+      cl_command_queue_release (&cls->command_queue);
+   }
+}
@@ -57,6 +57,23 @@ int cls_slave_init (cls_t * cls, const cls_cfg_t * cfg, uint32_t now);
  */
 int cls_slave_exit (cls_t * cls);
 
+/**
+ * Queue a command from an application thread
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param command          Command to be queued. Contents will be copied.
+ * @return 0 on success, or -1 if the queue is full.
+ */
+int cls_slave_submit_command (cls_t * cls, const cls_command_t * command);
+
+/**
+ * Execute the queued commands, and report the results via the command
+ * callback.
+ *
+ * @param cls              c-link slave stack instance handle
+ */
+void cls_slave_handle_commands (cls_t * cls);
+
 /************ Internal functions made available for tests *****************/
 
 void cls_slave_config_show (const cls_cfg_t * cfg);
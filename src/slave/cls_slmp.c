@@ -81,7 +81,7 @@ static int cls_slmp_schedule_node_search_response (
 /**
  * Send a SLMP response
  *
- * Opens a socket, sends the response and closes the socket.
+ * The send socket is opened on first use, and is kept open.
  *
  * The response message should be available in cls->slmp_sendbuf
  *
@@ -99,9 +99,8 @@ static int cls_slmp_send_response (
    uint16_t remote_port,
    size_t response_len)
 {
-   return cl_slmp_udp_send (
+   return cl_slmp_udp_send_persistent (
       &cls->slmp_send_socket,
-      true,
       cls->slmp_sendbuf,
       sizeof (cls->slmp_sendbuf),
       local_ip,
@@ -647,20 +646,34 @@ static
    return -1;
 }
 
-void cls_slmp_periodic (cls_t * cls, uint32_t now)
+void cls_slmp_update_next_deadline (
+   cls_t * cls,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest)
+{
+   cl_timer_update_earliest_deadline (
+      &cls->node_search.response_timer,
+      now,
+      found,
+      earliest);
+}
+
+/**
+ * Receive and handle one SLMP frame from a socket, if available.
+ *
+ * @param cls              c-link stack instance handle
+ * @param now              Timestamp in microseconds
+ * @param socket           Socket handle
+ */
+static void cls_slmp_receive_from_socket (cls_t * cls, uint32_t now, int socket)
 {
    cls_addr_info_t addr_info = {0};
    ssize_t recv_len          = 0;
 
-   if (cl_timer_is_expired (&cls->node_search.response_timer, now))
-   {
-      cl_timer_stop (&cls->node_search.response_timer);
-      (void)cls_slmp_send_node_search_response (cls);
-   }
-
    /* We need ifindex also for setting IP address */
    recv_len = clal_udp_recvfrom_with_ifindex (
-      cls->slmp_receive_socket,
+      socket,
       &addr_info.remote_ip,
       &addr_info.remote_port,
       &addr_info.local_ip,
@@ -689,6 +702,48 @@ void cls_slmp_periodic (cls_t * cls, uint32_t now)
    }
 }
 
+void cls_slmp_handle_readable (cls_t * cls, uint32_t now)
+{
+   cls_slmp_receive_from_socket (cls, now, cls->slmp_receive_socket);
+
+   /* The send socket is bound to our IP address and the SLMP port. This is
+      more specific than the binding of the receive socket, so the
+      operating system might deliver incoming unicast SLMP frames to it. */
+   if (cls->slmp_send_socket.handle != -1)
+   {
+      cls_slmp_receive_from_socket (cls, now, cls->slmp_send_socket.handle);
+   }
+}
+
+void cls_slmp_periodic (cls_t * cls, uint32_t now)
+{
+   if (cl_timer_is_expired (&cls->node_search.response_timer, now))
+   {
+      cl_timer_stop (&cls->node_search.response_timer);
+      (void)cls_slmp_send_node_search_response (cls);
+   }
+
+   cls_slmp_handle_readable (cls, now);
+}
+
+int cls_slmp_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets)
+{
+   if (*number_of_sockets >= max_sockets)
+   {
+      return -1;
+   }
+
+   sockets[*number_of_sockets].handle = cls->slmp_receive_socket;
+   sockets[*number_of_sockets].role   = CL_SOCKET_ROLE_SLMP;
+   (*number_of_sockets)++;
+
+   return 0;
+}
+
 int cls_slmp_init (cls_t * cls)
 {
    LOG_DEBUG (
@@ -715,8 +770,9 @@ int cls_slmp_init (cls_t * cls)
    cls->slmp_receive_socket = -1;
 #endif
 
-   /* The cls->slmp_send_socket is opened just before use */
-   cls->slmp_send_socket = -1;
+   /* The cls->slmp_send_socket is opened on first use */
+   cls->slmp_send_socket.handle   = -1;
+   cls->slmp_send_socket.local_ip = CL_IPADDR_INVALID;
 
    return 0;
 }
@@ -727,4 +783,6 @@ void cls_slmp_exit (cls_t * cls)
 
    clal_udp_close (cls->slmp_receive_socket);
    cls->slmp_receive_socket = -1;
+
+   cl_slmp_udp_close_persistent (&cls->slmp_send_socket);
 }
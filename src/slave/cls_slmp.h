@@ -51,6 +51,48 @@ void cls_slmp_exit (cls_t * cls);
  */
 void cls_slmp_periodic (cls_t * cls, uint32_t now);
 
+/**
+ * Receive and handle an incoming frame on the SLMP socket, if available.
+ *
+ * Does not handle any timers. This is done by \a cls_slmp_periodic().
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param now              timestamp in microseconds
+ */
+void cls_slmp_handle_readable (cls_t * cls, uint32_t now);
+
+/**
+ * Add the SLMP socket handle to a list of sockets.
+ *
+ * @param cls                 c-link slave stack instance handle
+ * @param sockets             List of sockets
+ * @param max_sockets         Number of elements in \a sockets
+ * @param number_of_sockets   Number of used elements in \a sockets. Will
+ *                            be increased by the number of added sockets.
+ * @return 0 on success, -1 if the list is too small
+ */
+int cls_slmp_get_sockets (
+   cls_t * cls,
+   cl_socket_info_t * sockets,
+   uint16_t max_sockets,
+   uint16_t * number_of_sockets);
+
+/**
+ * Find the earliest deadline among the SLMP timers.
+ *
+ * @param cls              c-link slave stack instance handle
+ * @param now              timestamp in microseconds
+ * @param found            Set to true if any timer is running
+ * @param earliest         Time until the earliest deadline found so far, in
+ *                         microseconds. Updated if an earlier deadline is
+ *                         found.
+ */
+void cls_slmp_update_next_deadline (
+   cls_t * cls,
+   uint32_t now,
+   bool * found,
+   uint32_t * earliest);
+
 /************ Internal functions made available for tests *******************/
 
 int cls_slmp_send_node_search_response (cls_t * cls);
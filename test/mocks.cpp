@@ -477,6 +477,32 @@ cl_rww_t * mock_analyze_cyclic_request_rww (
    return (cl_rww_t *)&udp_port->udp_output_buffer[startpos];
 }
 
+cl_ry_t * mock_analyze_cyclic_request_ry (
+   cl_mock_udp_port_t * udp_port,
+   uint16_t total_number_of_slavestations,
+   uint16_t slave_station_no)
+{
+
+   if (slave_station_no == 0 || slave_station_no > total_number_of_slavestations)
+   {
+      return nullptr;
+   }
+
+   const uint16_t startpos =
+      (uint16_t)sizeof (cl_cciefb_cyclic_req_full_headers_t) +
+      (total_number_of_slavestations * 4U) +
+      (total_number_of_slavestations * (uint16_t)sizeof (cl_rww_t)) +
+      ((slave_station_no - 1U) * (uint16_t)sizeof (cl_ry_t));
+   const uint16_t minsize = startpos + sizeof (cl_ry_t);
+
+   if (udp_port->output_data_size < minsize)
+   {
+      return nullptr;
+   }
+
+   return (cl_ry_t *)&udp_port->udp_output_buffer[startpos];
+}
+
 int mock_analyze_fake_cyclic_response (
    cl_mock_udp_port_t * udp_port,
    cl_mock_cyclic_response_result_t * result)
@@ -1405,6 +1431,11 @@ ssize_t mock_clal_udp_recvfrom_with_ifindex (
          *remote_port = udp_port->remote_source_port;
          *remote_ip   = udp_port->remote_source_ip;
       }
+      if (udp_port->input_repeat_count > 0)
+      {
+         udp_port->input_repeat_count--;
+         return receive_size;
+      }
       udp_port->input_data_size = 0; /* Support only one read */
 
       return receive_size;
@@ -1413,6 +1444,161 @@ ssize_t mock_clal_udp_recvfrom_with_ifindex (
    return -1;
 }
 
+int mock_clal_udp_recvfrom_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages)
+{
+   ssize_t receive_size;
+   cl_mock_udp_port_t * udp_port;
+
+   if (num_messages == 0)
+   {
+      return 0;
+   }
+
+   /* The simulated port holds at most one frame */
+   receive_size = mock_clal_udp_recvfrom (
+      handle,
+      &messages[0].remote_ip,
+      &messages[0].remote_port,
+      messages[0].data,
+      messages[0].size);
+   if (receive_size < 0)
+   {
+      return -1;
+   }
+   if (receive_size == 0)
+   {
+      return 0;
+   }
+
+   messages[0].len              = (size_t)receive_size;
+   messages[0].local_ip         = CL_IPADDR_INVALID;
+   messages[0].timestamp_valid  = false;
+   messages[0].drop_count_valid = false;
+
+   udp_port = mock_find_simulated_udp_port (handle);
+   if (udp_port != nullptr)
+   {
+      messages[0].local_ip = (udp_port->ip_addr == CL_IPADDR_ANY)
+                                ? udp_port->local_ip_addr
+                                : udp_port->ip_addr;
+      if (udp_port->use_timestamps)
+      {
+         messages[0].timestamp_us    = udp_port->rx_timestamp_us;
+         messages[0].timestamp_valid = true;
+      }
+      if (udp_port->use_drop_count)
+      {
+         messages[0].drop_count       = udp_port->drop_count;
+         messages[0].drop_count_valid = true;
+      }
+   }
+
+   return 1;
+}
+
+int mock_clal_udp_sendto_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages)
+{
+   size_t i;
+   ssize_t send_size;
+   clal_udp_error_queue_entry_t * entry;
+
+   cl_mock_udp_port_t * udp_port = mock_find_simulated_udp_port (handle);
+   if (udp_port == nullptr)
+   {
+      return -1;
+   }
+
+   udp_port->number_of_calls_send_batch++;
+   for (i = 0; i < num_messages; i++)
+   {
+      send_size = mock_clal_udp_sendto (
+         handle,
+         messages[i].remote_ip,
+         messages[i].remote_port,
+         messages[i].data,
+         messages[i].len);
+      if (send_size < 0 || (size_t)send_size != messages[i].len)
+      {
+         return (i == 0) ? -1 : (int)i;
+      }
+
+      if (
+         udp_port->use_timestamps &&
+         udp_port->error_queue_count < NELEMENTS (udp_port->error_queue))
+      {
+         entry       = &udp_port->error_queue[udp_port->error_queue_count];
+         entry->type = CLAL_UDP_ERROR_QUEUE_TX_TIMESTAMP;
+         entry->id   = udp_port->number_of_datagrams_sent;
+         entry->timestamp_us = udp_port->tx_timestamp_us;
+         udp_port->error_queue_count++;
+      }
+      udp_port->number_of_datagrams_sent++;
+   }
+
+   return (int)num_messages;
+}
+
+int mock_clal_udp_read_error_queue (
+   int handle,
+   clal_udp_error_queue_entry_t * entries,
+   size_t num_entries)
+{
+   size_t num_read = 0;
+   size_t i;
+   cl_mock_udp_port_t * udp_port = mock_find_simulated_udp_port (handle);
+
+   if (udp_port == nullptr)
+   {
+      return -1;
+   }
+
+   while (num_read < num_entries && num_read < udp_port->error_queue_count)
+   {
+      entries[num_read] = udp_port->error_queue[num_read];
+      num_read++;
+   }
+
+   /* Keep the entries that were not read */
+   for (i = num_read; i < udp_port->error_queue_count; i++)
+   {
+      udp_port->error_queue[i - num_read] = udp_port->error_queue[i];
+   }
+   udp_port->error_queue_count -= num_read;
+
+   return (int)num_read;
+}
+
+int mock_clal_udp_set_profile (
+   int handle,
+   const clal_socket_profile_t * profile,
+   clal_socket_profile_t * applied)
+{
+   cl_mock_udp_port_t * udp_port = mock_find_simulated_udp_port (handle);
+
+   clal_clear_memory (applied, sizeof (*applied));
+   if (udp_port == nullptr)
+   {
+      return -1;
+   }
+
+   udp_port->number_of_calls_set_profile++;
+   if (mock_data.will_fail_set_socket_profile)
+   {
+      return -1;
+   }
+
+   udp_port->profile = *profile;
+   *applied          = *profile;
+
+   return 0;
+}
+
 void mock_clal_udp_close (int handle)
 {
 
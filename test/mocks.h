@@ -77,12 +77,40 @@ typedef struct cl_mock_udp_port
    size_t buf_size;
 
    size_t input_data_size;
+
+   /** Number of additional times the input data is delivered, to simulate
+       several frames waiting in the socket. Only used by
+       mock_clal_udp_recvfrom_with_ifindex() */
+   uint16_t input_repeat_count;
+
+   /** Simulated reception and transmission timestamps, if enabled. The
+       reception timestamp is reported by the batch receive function. The
+       transmission timestamps are put in the error queue by the batch
+       send function. */
+   bool use_timestamps;
+   uint32_t rx_timestamp_us;
+   uint32_t tx_timestamp_us;
+
+   /** Simulated socket error queue */
+   clal_udp_error_queue_entry_t error_queue[4];
+   size_t error_queue_count;
+   uint32_t number_of_datagrams_sent;
+
+   /** Simulated cumulative drop counter, reported by the batch receive
+       function if enabled */
+   bool use_drop_count;
+   uint32_t drop_count;
    size_t output_data_size;
+
+   /** Latest socket profile given to mock_clal_udp_set_profile() */
+   clal_socket_profile_t profile;
    size_t total_sent_bytes;
    size_t total_recv_bytes;
    uint16_t number_of_calls_open;
    uint16_t number_of_calls_recv;
    uint16_t number_of_calls_send;
+   uint16_t number_of_calls_send_batch;
+   uint16_t number_of_calls_set_profile;
    uint16_t number_of_calls_close;
 } cl_mock_udp_port_t;
 
@@ -153,6 +181,15 @@ typedef struct cl_mock_master_callback_counters
       uint32_t local_management_info;
    } master_cb_changed_slave_info;
 
+   /** Master callback for changed incoming cyclic data */
+   struct
+   {
+      uint16_t calls;
+      uint16_t group_index;
+      uint16_t slave_device_index;
+      cl_changed_signals_t changed;
+   } master_cb_inputs_changed;
+
    /** Master callback for node search result */
    struct
    {
@@ -167,6 +204,15 @@ typedef struct cl_mock_master_callback_counters
       clm_master_setip_status_t status;
    } master_cb_set_ip;
 
+   /** Master callback for executed command */
+   struct
+   {
+      uint16_t calls;
+      clm_command_type_t type;
+      uint32_t tag;
+      int result;
+   } master_cb_command;
+
 } cl_mock_master_callback_counters_t;
 
 /** A file in a simulated file system */
@@ -201,6 +247,7 @@ typedef struct cl_mock_data
    bool will_fail_read_mac_addr;
    bool will_fail_read_ifname;
    bool will_fail_read_ifindex;
+   bool will_fail_set_socket_profile;
    uint16_t number_of_calls_set_ip_address_netmask;
 
    /* Operating system values */
@@ -273,6 +320,22 @@ typedef struct cl_mock_data
       bool did_set_ip;
    } slave_cb_set_ip;
 
+   /** Slave callback for changed incoming cyclic data */
+   struct
+   {
+      uint16_t calls;
+      cl_changed_signals_t changed;
+   } slave_cb_inputs_changed;
+
+   /** Slave callback for executed command */
+   struct
+   {
+      uint16_t calls;
+      cls_command_type_t type;
+      uint32_t tag;
+      int result;
+   } slave_cb_command;
+
    cl_mock_master_callback_counters_t master_cb_counters[2];
 
    /** Filesystem for storing data */
@@ -406,6 +469,22 @@ ssize_t mock_clal_udp_recvfrom_with_ifindex (
    int * ifindex,
    void * data,
    size_t size);
+int mock_clal_udp_recvfrom_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages);
+int mock_clal_udp_sendto_batch (
+   int handle,
+   clal_udp_message_t * messages,
+   size_t num_messages);
+int mock_clal_udp_read_error_queue (
+   int handle,
+   clal_udp_error_queue_entry_t * entries,
+   size_t num_entries);
+int mock_clal_udp_set_profile (
+   int handle,
+   const clal_socket_profile_t * profile,
+   clal_socket_profile_t * applied);
 void mock_clal_udp_close (int handle);
 
 int mock_clal_save_file (
@@ -542,6 +621,19 @@ cl_rww_t * mock_analyze_cyclic_request_rww (
    uint16_t total_number_of_slavestations,
    uint16_t slave_station_no);
 
+/**
+ * Find cyclic RY data in a CCIEFB cyclic request
+ *
+ * @param udp_port                        Mocked UDP port (including a buffer)
+ * @param total_number_of_slavestations   Total number of occupied stations
+ * @param slave_station_no                Slave station number. Starts at 1.
+ * @return pointer to area on success, NULL on error
+ */
+cl_ry_t * mock_analyze_cyclic_request_ry (
+   cl_mock_udp_port_t * udp_port,
+   uint16_t total_number_of_slavestations,
+   uint16_t slave_station_no);
+
 /**
  * Analyze a CCIEFB cyclic response
  *
@@ -292,8 +292,9 @@ TEST_F (MasterUnitTest, SlmpCommunicationBetweenMasterAndSlave)
    clm_slmp_periodic (&clm, now);
    clm_iefb_periodic (&clm, now);
 
+   /* The send socket is kept open */
    EXPECT_TRUE (master_slmp_send_port->in_use);
-   EXPECT_FALSE (master_slmp_send_port->is_open);
+   EXPECT_TRUE (master_slmp_send_port->is_open);
    EXPECT_EQ (master_slmp_send_port->output_data_size, SIZE_REQUEST_NODE_SEARCH);
    mock_transfer_udp_fakedata (slave_slmp_receive_port, master_slmp_send_port);
    EXPECT_EQ (slave_slmp_receive_port->input_data_size, SIZE_REQUEST_NODE_SEARCH);
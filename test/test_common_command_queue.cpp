@@ -0,0 +1,77 @@
+/*********************************************************************
+ *        _       _         _
+ *  _ __ | |_  _ | |  __ _ | |__   ___
+ * | '__|| __|(_)| | / _` || '_ \ / __|
+ * | |   | |_  _ | || (_| || |_) |\__ \
+ * |_|    \__|(_)|_| \__,_||_.__/ |___/
+ *
+ * www.rt-labs.com
+ * Copyright 2022 rt-labs AB, Sweden. All rights reserved.
+ *
+ * See the file LICENSE.md distributed with this software for full
+ * license information.
+ ********************************************************************/
+
+#include "common/cl_command_queue.h"
+
+#include "utils_for_testing.h"
+
+#include <gtest/gtest.h>
+
+// Test fixture
+
+class CommandQueueUnitTest : public UnitTest
+{
+};
+
+// Tests
+
+TEST_F (CommandQueueUnitTest, ReserveAndRelease)
+{
+   cl_command_queue_t queue;
+   uint32_t position      = 0;
+   uint32_t read_position = 0;
+   uint32_t first         = 0;
+   uint32_t second        = 0;
+   uint32_t i;
+
+   cl_command_queue_init (&queue);
+   EXPECT_FALSE (cl_command_queue_peek (&queue, &read_position));
+
+   /* Commands are read in the order the positions were reserved, also when
+      published in another order */
+   ASSERT_EQ (cl_command_queue_reserve (&queue, &first), 0);
+   ASSERT_EQ (cl_command_queue_reserve (&queue, &second), 0);
+   EXPECT_EQ (first, 0U);
+   EXPECT_EQ (second, 1U);
+   cl_command_queue_publish (&queue, second);
+   EXPECT_FALSE (cl_command_queue_peek (&queue, &read_position));
+   cl_command_queue_publish (&queue, first);
+
+   EXPECT_TRUE (cl_command_queue_peek (&queue, &read_position));
+   EXPECT_EQ (read_position, first);
+   cl_command_queue_release (&queue);
+   EXPECT_TRUE (cl_command_queue_peek (&queue, &read_position));
+   EXPECT_EQ (read_position, second);
+   cl_command_queue_release (&queue);
+   EXPECT_FALSE (cl_command_queue_peek (&queue, &read_position));
+
+   /* Fill the queue */
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      ASSERT_EQ (cl_command_queue_reserve (&queue, &position), 0);
+      EXPECT_EQ (position, i + 2);
+      cl_command_queue_publish (&queue, position);
+   }
+   EXPECT_EQ (cl_command_queue_reserve (&queue, &position), -1);
+
+   /* A released slot can be reused */
+   EXPECT_TRUE (cl_command_queue_peek (&queue, &read_position));
+   EXPECT_EQ (read_position, 2U);
+   EXPECT_EQ (cl_command_queue_slot (read_position), 2);
+   cl_command_queue_release (&queue);
+   ASSERT_EQ (cl_command_queue_reserve (&queue, &position), 0);
+   EXPECT_EQ (position, CL_COMMAND_QUEUE_SIZE + 2);
+   EXPECT_EQ (cl_command_queue_slot (position), 2);
+   EXPECT_EQ (cl_command_queue_reserve (&queue, &position), -1);
+}
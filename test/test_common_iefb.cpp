@@ -468,6 +468,88 @@ TEST_F (IefbUnitTest, CciefbRegisterCalculateAreaNumber)
    EXPECT_EQ (register_in_area, 1);
 }
 
+/**
+ * Test validation of signal ranges
+ *
+ */
+TEST_F (IefbUnitTest, CciefbIsSignalRangeValid)
+{
+   EXPECT_TRUE (cl_iefb_is_signal_range_valid (0, 0, 0));
+   EXPECT_TRUE (cl_iefb_is_signal_range_valid (0, 64, 64));
+   EXPECT_TRUE (cl_iefb_is_signal_range_valid (63, 1, 64));
+   EXPECT_TRUE (cl_iefb_is_signal_range_valid (64, 0, 64));
+   EXPECT_FALSE (cl_iefb_is_signal_range_valid (0, 65, 64));
+   EXPECT_FALSE (cl_iefb_is_signal_range_valid (64, 1, 64));
+   EXPECT_FALSE (cl_iefb_is_signal_range_valid (UINT16_MAX, UINT16_MAX, 64));
+}
+
+/**
+ * Test packing and unpacking bit signals
+ *
+ */
+TEST_F (IefbUnitTest, CciefbPackUnpackBits)
+{
+   uint8_t area[2 * CL_BYTES_PER_BITAREA] = {};
+   bool values[2 * CL_BITSIGNALS_PER_AREA] = {};
+   bool result[2 * CL_BITSIGNALS_PER_AREA] = {};
+   uint16_t i;
+
+   /* Unaligned start and end, spanning two areas */
+   for (i = 0; i < 80; i++)
+   {
+      values[i] = (i % 3) == 0;
+   }
+   cl_iefb_pack_bits (area, 3, 80, values);
+   EXPECT_EQ (area[0], 0x48); /* RY3 and RY6 */
+   EXPECT_EQ (area[1], 0x92); /* RY9, RY12 and RY15 */
+   EXPECT_EQ (area[10], 0x02); /* RY81 */
+   EXPECT_EQ (area[11], 0x00);
+
+   cl_iefb_unpack_bits (area, 3, 80, result);
+   for (i = 0; i < 80; i++)
+   {
+      EXPECT_EQ (result[i], values[i]) << "Bit index " << i;
+   }
+
+   /* Surrounding bits are kept */
+   area[0] = 0xFF;
+   area[1] = 0xFF;
+   clal_clear_memory (values, sizeof (values));
+   cl_iefb_pack_bits (area, 2, 11, values);
+   EXPECT_EQ (area[0], 0x03);
+   EXPECT_EQ (area[1], 0xE0);
+
+   /* Nothing to do */
+   cl_iefb_pack_bits (area, 0, 0, values);
+   cl_iefb_unpack_bits (area, 0, 0, result);
+   EXPECT_EQ (area[0], 0x03);
+}
+
+/**
+ * Test reading and writing word signals
+ *
+ */
+TEST_F (IefbUnitTest, CciefbReadWriteWords)
+{
+   uint8_t area[2 * CL_WORDSIGNALS_PER_AREA * 2 + 1] = {};
+   const uint16_t values[] = {0x1234, 0xABCD, 0x00FF};
+   uint16_t result[3]      = {};
+
+   /* Unaligned buffer, spanning two areas */
+   cl_iefb_write_words (&area[1], 31, 3, values);
+   EXPECT_EQ (area[1 + 62], 0x34);
+   EXPECT_EQ (area[1 + 63], 0x12);
+   EXPECT_EQ (area[1 + 64], 0xCD);
+   EXPECT_EQ (area[1 + 65], 0xAB);
+   EXPECT_EQ (area[1 + 66], 0xFF);
+   EXPECT_EQ (area[1 + 67], 0x00);
+
+   cl_iefb_read_words (&area[1], 31, 3, result);
+   EXPECT_EQ (result[0], 0x1234);
+   EXPECT_EQ (result[1], 0xABCD);
+   EXPECT_EQ (result[2], 0x00FF);
+}
+
 /**
  * Test validation of cyclic request header
  *
@@ -1610,6 +1692,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicRequestFrame)
          master_ip,
          remote_port,
          slave_id,
+         nullptr,
          &request),
       0);
 
@@ -1778,6 +1861,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicRequestFrame)
          master_ip,
          remote_port,
          slave_id,
+         nullptr,
          &request),
       -1);
 
@@ -1789,6 +1873,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicRequestFrame)
          master_ip,
          remote_port,
          slave_id,
+         nullptr,
          &request),
       -1);
 }
@@ -2330,6 +2415,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicResponseFrame)
          remote_ip,
          remote_port,
          timestamp,
+         nullptr,
          &response),
       0);
 
@@ -2422,6 +2508,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicResponseFrame)
          remote_ip,
          remote_port,
          timestamp,
+         nullptr,
          &response),
       -1);
 
@@ -2433,6 +2520,7 @@ TEST_F (IefbUnitTest, CciefbParseCyclicResponseFrame)
          remote_ip,
          remote_port,
          timestamp,
+         nullptr,
          &response),
       -1);
 
@@ -2444,6 +2532,199 @@ TEST_F (IefbUnitTest, CciefbParseCyclicResponseFrame)
          remote_ip,
          remote_port,
          timestamp,
+         nullptr,
+         &response),
+      -1);
+}
+
+TEST_F (IefbUnitTest, CciefbRequestHeaderTemplate)
+{
+   cls_cciefb_cyclic_request_info_t request    = {};
+   cl_cciefb_header_template_t header_template = {};
+   uint8_t payload[SIZE_REQUEST_3_SLAVES]      = {};
+   const size_t payload_len                    = SIZE_REQUEST_3_SLAVES;
+   const uint16_t remote_port                  = 123;
+   const cl_ipaddr_t master_ip                 = 0x01020304; /* IP 1.2.3.4 */
+   const cl_ipaddr_t slave_id                  = 0x01020305; /* IP 1.2.3.5 */
+
+   clal_memcpy (
+      payload,
+      sizeof (payload),
+      request_payload_running,
+      SIZE_REQUEST_3_SLAVES);
+
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+
+   /* Learn from a valid frame */
+   ASSERT_EQ (
+      cl_iefb_parse_cyclic_request (
+         payload,
+         SIZE_REQUEST_3_SLAVES,
+         master_ip,
+         remote_port,
+         slave_id,
+         &header_template,
+         &request),
+      0);
+   EXPECT_TRUE (header_template.is_valid);
+   EXPECT_EQ (header_template.frame_len, SIZE_REQUEST_3_SLAVES);
+   EXPECT_TRUE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+
+   /* Frame sequence number, clock info and cyclic data might differ */
+   payload[53] = 0x44;
+   payload[40] = 0x12;
+   payload[80] = 0xFF;
+   EXPECT_TRUE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_request (
+         payload,
+         SIZE_REQUEST_3_SLAVES,
+         master_ip,
+         remote_port,
+         slave_id,
+         &header_template,
+         &request),
+      0);
+   EXPECT_EQ (
+      request.full_headers->cyclic_data_header.frame_sequence_no,
+      0x2244);
+
+   /* Other length */
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (
+         &header_template,
+         payload,
+         payload_len - 1));
+
+   /* From other IP address than the master ID in the frame */
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_request (
+         payload,
+         SIZE_REQUEST_3_SLAVES,
+         slave_id,
+         remote_port,
+         slave_id,
+         &header_template,
+         &request),
+      -1);
+
+   /* Invalid protocol version. Detected by the full validation. */
+   payload[15] = 7;
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_request (
+         payload,
+         SIZE_REQUEST_3_SLAVES,
+         master_ip,
+         remote_port,
+         slave_id,
+         &header_template,
+         &request),
+      -1);
+   payload[15] = 2;
+
+   /* Reserved value */
+   payload[21] = 0x01;
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+}
+
+TEST_F (IefbUnitTest, CciefbResponseHeaderTemplate)
+{
+   clm_cciefb_cyclic_response_info_t response  = {};
+   cl_cciefb_header_template_t header_template = {};
+   uint8_t payload[SIZE_RESPONSE_2_SLAVES]     = {};
+   const size_t payload_len                    = SIZE_RESPONSE_2_SLAVES;
+   const uint32_t timestamp                    = 0x62636465;
+   const uint16_t remote_port                  = 123;
+   const cl_ipaddr_t remote_ip                 = 0x01020306; /* IP 1.2.3.6 */
+
+   clal_memcpy (
+      payload,
+      sizeof (payload),
+      response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+
+   /* Learn from a valid frame */
+   ASSERT_EQ (
+      cl_iefb_parse_cyclic_response (
+         payload,
+         SIZE_RESPONSE_2_SLAVES,
+         remote_ip,
+         remote_port,
+         timestamp,
+         &header_template,
+         &response),
+      0);
+   EXPECT_TRUE (header_template.is_valid);
+   EXPECT_EQ (header_template.frame_len, 0U);
+   EXPECT_TRUE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+
+   /* End code, slave info and frame sequence number might differ */
+   payload[13] = 0x01;
+   payload[31] = 0x99;
+   payload[57] = 0x03;
+   EXPECT_TRUE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_response (
+         payload,
+         SIZE_RESPONSE_2_SLAVES,
+         remote_ip,
+         remote_port,
+         timestamp,
+         &header_template,
+         &response),
+      0);
+   EXPECT_EQ (response.number_of_occupied, 2);
+
+   /* Length not consistent with the dl field */
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_response (
+         payload,
+         SIZE_RESPONSE_2_SLAVES - 1,
+         remote_ip,
+         remote_port,
+         timestamp,
+         &header_template,
+         &response),
+      -1);
+
+   /* Slave ID not equal to the remote IP address */
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_response (
+         payload,
+         SIZE_RESPONSE_2_SLAVES,
+         remote_ip + 1,
+         remote_port,
+         timestamp,
+         &header_template,
+         &response),
+      -1);
+
+   /* Other group */
+   payload[55] = 0x02;
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+   payload[55] = 0x01;
+
+   /* Reserved bit in slave local unit info */
+   payload[43] = 0x02;
+   EXPECT_FALSE (
+      cl_iefb_matches_header_template (&header_template, payload, payload_len));
+   EXPECT_EQ (
+      cl_iefb_parse_cyclic_response (
+         payload,
+         SIZE_RESPONSE_2_SLAVES,
+         remote_ip,
+         remote_port,
+         timestamp,
+         &header_template,
          &response),
       -1);
 }
@@ -2513,6 +2794,7 @@ TEST_F (IefbUnitTest, CciefbSanityCyclicRequest)
          master_ip_addr,
          remote_port,
          slave_ip_addr,
+         nullptr,
          &result),
       0);
 
@@ -2627,6 +2909,7 @@ TEST_F (IefbUnitTest, CciefbSanityCyclicResponse)
          slave_ip_addr,
          remote_port,
          timestamp,
+         nullptr,
          &result),
       0);
 
@@ -111,6 +111,7 @@ TEST_F (LiteralsUnitTest, LiteralsGetMasterErrorMessage)
    EXPECT_STREQ (cl_literals_get_master_error_message (CLM_ERROR_SLAVE_DUPLICATION),                   "SLAVE_DUPLICATION");
    EXPECT_STREQ (cl_literals_get_master_error_message (CLM_ERROR_SLAVE_REPORTS_WRONG_NUMBER_OCCUPIED), "SLAVE_REPORTS_WRONG_NUMBER_OCCUPIED");
    EXPECT_STREQ (cl_literals_get_master_error_message (CLM_ERROR_SLAVE_REPORTS_MASTER_DUPLICATION),    "SLAVE_REPORTS_MASTER_DUPLICATION");
+   EXPECT_STREQ (cl_literals_get_master_error_message (CLM_ERROR_CCIEFB_FRAMES_DROPPED),               "CCIEFB_FRAMES_DROPPED");
    EXPECT_STREQ (cl_literals_get_master_error_message ((clm_error_message_t)123),                      "unknown error");
    // clang-format on
 }
@@ -224,3 +224,117 @@ TEST_F (SlmpUdpIntegrationTest, SlmpUdpSendWrongNumberOfBytes)
          message_size),
       -1);
 }
+
+TEST_F (SlmpUdpIntegrationTest, SlmpUdpSendPersistent)
+{
+   cl_slmp_send_socket_t send_socket       = {-1, CL_IPADDR_INVALID};
+   const cl_ipaddr_t my_new_ip             = 0x01020307; /* IP 1.2.3.7 */
+   cl_mock_udp_port_t * mock_new_send_port = &mock_data.udp_ports[1];
+   uint8_t buffer[100]                     = {0};
+   buffer[0]                               = 'A';
+
+   /* Socket is opened on first use, and kept open */
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_ip,
+         remote_ip,
+         remote_port,
+         message_size),
+      0);
+   EXPECT_NE (send_socket.handle, -1);
+   EXPECT_EQ (send_socket.local_ip, my_ip);
+   EXPECT_TRUE (mock_slmp_send_port->is_open);
+   EXPECT_EQ (mock_slmp_send_port->ip_addr, my_ip);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_open, 1U);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 1U);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_close, 0U);
+
+   /* Socket is reused */
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_ip,
+         remote_ip,
+         remote_port,
+         message_size),
+      0);
+   EXPECT_TRUE (mock_slmp_send_port->is_open);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_open, 1U);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 2U);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_close, 0U);
+   EXPECT_FALSE (mock_new_send_port->in_use);
+
+   /* Our IP address has changed. Open a new socket. */
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_new_ip,
+         remote_ip,
+         remote_port,
+         message_size),
+      0);
+   EXPECT_EQ (send_socket.local_ip, my_new_ip);
+   EXPECT_FALSE (mock_slmp_send_port->is_open);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_close, 1U);
+   EXPECT_TRUE (mock_new_send_port->is_open);
+   EXPECT_EQ (mock_new_send_port->ip_addr, my_new_ip);
+   EXPECT_EQ (mock_new_send_port->number_of_calls_send, 1U);
+
+   /* Failing to send closes the socket */
+   mock_new_send_port->will_fail_send = true;
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_new_ip,
+         remote_ip,
+         remote_port,
+         message_size),
+      -1);
+   EXPECT_EQ (send_socket.handle, -1);
+   EXPECT_FALSE (mock_new_send_port->is_open);
+
+   /* Too large message */
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_new_ip,
+         remote_ip,
+         remote_port,
+         sizeof (buffer) + 1),
+      -1);
+   EXPECT_EQ (send_socket.handle, -1);
+
+   /* Closing a closed socket has no effect */
+   cl_slmp_udp_close_persistent (&send_socket);
+   EXPECT_EQ (send_socket.handle, -1);
+}
+
+TEST_F (SlmpUdpIntegrationTest, SlmpUdpSendPersistentFailToOpen)
+{
+   cl_slmp_send_socket_t send_socket   = {-1, CL_IPADDR_INVALID};
+   uint8_t buffer[100]                 = {0};
+   mock_slmp_send_port->will_fail_open = true;
+
+   EXPECT_EQ (
+      cl_slmp_udp_send_persistent (
+         &send_socket,
+         buffer,
+         sizeof (buffer),
+         my_ip,
+         remote_ip,
+         remote_port,
+         message_size),
+      -1);
+   EXPECT_EQ (send_socket.handle, -1);
+}
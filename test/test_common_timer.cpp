@@ -342,3 +342,155 @@ TEST_F (TimerUnitTest, TimerShow)
    now += 2 * period;
    cl_timer_show (&timer, now);
 }
+
+TEST_F (TimerUnitTest, TimerGetRemaining)
+{
+   cl_timer_t timer;
+   uint32_t remaining    = 1234;
+   uint32_t now          = 100;
+   const uint32_t period = 2000; /* 2 milliseconds */
+   cl_timer_stop (&timer);
+
+   /* Stopped timer */
+   EXPECT_FALSE (cl_timer_get_remaining (&timer, now, &remaining));
+   EXPECT_EQ (remaining, 1234U);
+
+   /* Running timer */
+   cl_timer_start (&timer, period, now);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now, &remaining));
+   EXPECT_EQ (remaining, period);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now + 500, &remaining));
+   EXPECT_EQ (remaining, period - 500);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now + period, &remaining));
+   EXPECT_EQ (remaining, 0U);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now + 3 * period, &remaining));
+   EXPECT_EQ (remaining, 0U);
+
+   /* Negative time difference */
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now - 10, &remaining));
+   EXPECT_EQ (remaining, period + 10);
+
+   /* Wrapping */
+   now = UINT32_MAX - 99;
+   cl_timer_start (&timer, period, now);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now + 500, &remaining));
+   EXPECT_EQ (remaining, period - 500);
+   EXPECT_TRUE (cl_timer_get_remaining (&timer, now + period, &remaining));
+   EXPECT_EQ (remaining, 0U);
+}
+
+TEST_F (TimerUnitTest, TimerUpdateEarliestDeadline)
+{
+   cl_timer_t timer_a;
+   cl_timer_t timer_b;
+   cl_timer_t timer_c;
+   bool found        = false;
+   uint32_t earliest = 0;
+   uint32_t now      = 1000;
+
+   cl_timer_stop (&timer_a);
+   cl_timer_stop (&timer_b);
+   cl_timer_stop (&timer_c);
+
+   /* No running timers */
+   cl_timer_update_earliest_deadline (&timer_a, now, &found, &earliest);
+   cl_timer_update_earliest_deadline (&timer_b, now, &found, &earliest);
+   EXPECT_FALSE (found);
+
+   /* Find earliest among running timers */
+   cl_timer_start (&timer_a, 3000, now);
+   cl_timer_start (&timer_b, 500, now);
+   cl_timer_start (&timer_c, 2000, now);
+   cl_timer_update_earliest_deadline (&timer_a, now, &found, &earliest);
+   EXPECT_TRUE (found);
+   EXPECT_EQ (earliest, 3000U);
+   cl_timer_update_earliest_deadline (&timer_b, now, &found, &earliest);
+   EXPECT_EQ (earliest, 500U);
+   cl_timer_update_earliest_deadline (&timer_c, now, &found, &earliest);
+   EXPECT_EQ (earliest, 500U);
+
+   /* Expired timer */
+   found = false;
+   cl_timer_update_earliest_deadline (&timer_a, now + 4000, &found, &earliest);
+   EXPECT_TRUE (found);
+   EXPECT_EQ (earliest, 0U);
+}
+
+TEST_F (TimerUnitTest, TimerHeap)
+{
+   cl_timer_heap_t heap;
+   cl_timer_t timers[5];
+   uint16_t id;
+   uint16_t i;
+   uint32_t now = UINT32_MAX - 1000; /* Deadlines wrap around */
+
+   cl_timer_heap_init (&heap);
+   EXPECT_FALSE (cl_timer_heap_peek (&heap, &id));
+
+   /* Invalid id */
+   cl_timer_start (&timers[0], 100, now);
+   EXPECT_EQ (
+      cl_timer_heap_schedule (&heap, CL_TIMER_HEAP_MAX_TIMERS, &timers[0]),
+      -1);
+   EXPECT_FALSE (cl_timer_heap_peek (&heap, &id));
+
+   /* Schedule timers in random order */
+   cl_timer_start (&timers[0], 3000, now);
+   cl_timer_start (&timers[1], 500, now);
+   cl_timer_start (&timers[2], 2000, now);
+   cl_timer_start (&timers[3], 4000, now);
+   cl_timer_start (&timers[4], 1000, now);
+   for (i = 0; i < NELEMENTS (timers); i++)
+   {
+      EXPECT_EQ (cl_timer_heap_schedule (&heap, i, &timers[i]), 0);
+   }
+   EXPECT_EQ (heap.size, 5U);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 1U);
+
+   /* Restart the earliest timer, so it expires last */
+   cl_timer_start (&timers[1], 5000, now);
+   EXPECT_EQ (cl_timer_heap_schedule (&heap, 1, &timers[1]), 0);
+   EXPECT_EQ (heap.size, 5U);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 4U);
+
+   /* Restart a late timer, so it expires first */
+   cl_timer_start (&timers[3], 200, now);
+   EXPECT_EQ (cl_timer_heap_schedule (&heap, 3, &timers[3]), 0);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 3U);
+
+   /* Same deadline, lowest id first */
+   cl_timer_start (&timers[2], 200, now);
+   EXPECT_EQ (cl_timer_heap_schedule (&heap, 2, &timers[2]), 0);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 2U);
+
+   /* Stopped timer is removed */
+   cl_timer_stop (&timers[2]);
+   EXPECT_EQ (cl_timer_heap_schedule (&heap, 2, &timers[2]), 0);
+   EXPECT_EQ (heap.size, 4U);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 3U);
+
+   /* Remove timers in deadline order */
+   cl_timer_heap_remove (&heap, 3);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 4U);
+   cl_timer_heap_remove (&heap, 4);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 0U);
+   cl_timer_heap_remove (&heap, 0);
+   EXPECT_TRUE (cl_timer_heap_peek (&heap, &id));
+   EXPECT_EQ (id, 1U);
+
+   /* Removing an unscheduled timer does nothing */
+   cl_timer_heap_remove (&heap, 0);
+   cl_timer_heap_remove (&heap, CL_TIMER_HEAP_MAX_TIMERS);
+   EXPECT_EQ (heap.size, 1U);
+
+   cl_timer_heap_remove (&heap, 1);
+   EXPECT_EQ (heap.size, 0U);
+   EXPECT_FALSE (cl_timer_heap_peek (&heap, &id));
+}
@@ -113,6 +113,38 @@ TEST_F (UtilUnitTest, UtilIsIpaddrValid)
    EXPECT_FALSE (cl_utils_is_ipaddr_range_valid (0xFFFFFFFF));
 }
 
+TEST_F (UtilUnitTest, UtilIsSocketProfileValid)
+{
+   cl_socket_profile_t profile = {};
+
+   EXPECT_TRUE (cl_utils_is_socket_profile_valid (&profile));
+   profile.priority = CL_SOCKET_PRIORITY_MAX;
+   profile.dscp     = CL_SOCKET_DSCP_MAX;
+   EXPECT_TRUE (cl_utils_is_socket_profile_valid (&profile));
+   profile.priority = CL_SOCKET_PRIORITY_MAX + 1;
+   EXPECT_FALSE (cl_utils_is_socket_profile_valid (&profile));
+   profile.priority = 0;
+   profile.dscp     = CL_SOCKET_DSCP_MAX + 1;
+   EXPECT_FALSE (cl_utils_is_socket_profile_valid (&profile));
+}
+
+TEST_F (UtilUnitTest, UtilSocketProfileFromClal)
+{
+   const clal_socket_profile_t applied = {50, 100000, 6, 46, true};
+   cl_socket_profile_t profile         = {};
+
+   cl_util_socket_profile_from_clal (&applied, true, &profile);
+   EXPECT_EQ (profile.busy_poll_us, 50U);
+   EXPECT_EQ (profile.receive_buffer_size, 100000U);
+   EXPECT_TRUE (profile.receive_buffer_for_burst);
+   EXPECT_EQ (profile.priority, 6);
+   EXPECT_EQ (profile.dscp, 46);
+   EXPECT_TRUE (profile.enable_error_queue);
+
+   cl_util_socket_profile_from_clal (&applied, false, &profile);
+   EXPECT_FALSE (profile.receive_buffer_for_burst);
+}
+
 TEST_F (UtilUnitTest, UtilCopyMacAddress)
 {
    const cl_macaddr_t original = {0x20, 0x21, 0x22, 0x23, 0x24, 0x25};
@@ -180,6 +212,58 @@ TEST_F (UtilUnitTest, UtilVerifyMacAddressMatcher)
    EXPECT_TRUE (ReversedMacMatch (&mac_e, &mac_e));
 }
 
+TEST_F (UtilUnitTest, UtilCalcChangedBits)
+{
+   const uint8_t zeros[CL_BYTES_PER_BITAREA] = {0};
+   const uint8_t a[CL_BYTES_PER_BITAREA] =
+      {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80};
+   const uint8_t b[CL_BYTES_PER_BITAREA] =
+      {0x03, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x80};
+
+   EXPECT_EQ (cl_util_calc_changed_bits (zeros, zeros), 0U);
+   EXPECT_EQ (cl_util_calc_changed_bits (a, a), 0U);
+   EXPECT_EQ (cl_util_calc_changed_bits (zeros, a), 0x8000000000000001U);
+   EXPECT_EQ (cl_util_calc_changed_bits (a, b), 0x0000000000F00002U);
+   EXPECT_EQ (cl_util_calc_changed_bits (b, a), 0x0000000000F00002U);
+
+   /* Missing next data is treated as zeros */
+   EXPECT_EQ (cl_util_calc_changed_bits (a, nullptr), 0x8000000000000001U);
+   EXPECT_EQ (cl_util_calc_changed_bits (zeros, nullptr), 0U);
+}
+
+TEST_F (UtilUnitTest, UtilCalcChangedWords)
+{
+   uint8_t previous[CL_WORDSIGNALS_PER_AREA * 2]      = {0};
+   uint8_t next[CL_WORDSIGNALS_PER_AREA * 2]          = {0};
+   uint8_t unaligned[CL_WORDSIGNALS_PER_AREA * 2 + 1] = {0};
+
+   EXPECT_EQ (cl_util_calc_changed_words (previous, next), 0U);
+
+   next[0]                               = 0x01;
+   next[3]                               = 0x80;
+   next[CL_WORDSIGNALS_PER_AREA * 2 - 1] = 0x10;
+   EXPECT_EQ (cl_util_calc_changed_words (previous, next), 0x80000003U);
+   EXPECT_EQ (cl_util_calc_changed_words (next, previous), 0x80000003U);
+   EXPECT_EQ (cl_util_calc_changed_words (next, next), 0U);
+
+   /* Registers in other 8-byte blocks, high and low bytes */
+   next[11] = 0x01;
+   next[40] = 0x01;
+   EXPECT_EQ (cl_util_calc_changed_words (previous, next), 0x80100023U);
+   next[11] = 0x00;
+   next[40] = 0x00;
+
+   /* Unaligned data */
+   memcpy (&unaligned[1], next, sizeof (next));
+   EXPECT_EQ (
+      cl_util_calc_changed_words (previous, &unaligned[1]),
+      0x80000003U);
+
+   /* Missing next data is treated as zeros */
+   EXPECT_EQ (cl_util_calc_changed_words (next, nullptr), 0x80000003U);
+   EXPECT_EQ (cl_util_calc_changed_words (previous, nullptr), 0U);
+}
+
 TEST_F (UtilUnitTest, UtilShowBytes)
 {
    const uint8_t buffer[] = {
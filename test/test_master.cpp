@@ -141,6 +141,14 @@ TEST_F (MasterInitExitUnitTest, ValidateMasterConfiguration)
    config = default_config;
    EXPECT_EQ (clm_validate_config (&config), 0);
 
+   /* Number of shards */
+   config.number_of_shards = CLM_MAX_SHARDS + 1;
+   EXPECT_EQ (clm_validate_config (&config), -1);
+   config.number_of_shards = CLM_MAX_SHARDS;
+   EXPECT_EQ (clm_validate_config (&config), 0);
+   config = default_config;
+   EXPECT_EQ (clm_validate_config (&config), 0);
+
    /* Number of slave devices */
    /* TODO test also 16 devices */
    config.hier.groups[0].num_slave_devices = 0;
@@ -200,6 +208,18 @@ TEST_F (MasterInitExitUnitTest, ValidateMasterConfiguration)
    EXPECT_EQ (clm_validate_config (&config), -1);
    config = default_config;
    EXPECT_EQ (clm_validate_config (&config), 0);
+
+   /* Socket profile */
+   config.cciefb_socket_profile.priority = CL_SOCKET_PRIORITY_MAX;
+   config.cciefb_socket_profile.dscp     = CL_SOCKET_DSCP_MAX;
+   EXPECT_EQ (clm_validate_config (&config), 0);
+   config.cciefb_socket_profile.priority = CL_SOCKET_PRIORITY_MAX + 1;
+   EXPECT_EQ (clm_validate_config (&config), -1);
+   config.cciefb_socket_profile.priority = 0;
+   config.cciefb_socket_profile.dscp     = CL_SOCKET_DSCP_MAX + 1;
+   EXPECT_EQ (clm_validate_config (&config), -1);
+   config = default_config;
+   EXPECT_EQ (clm_validate_config (&config), 0);
 }
 
 TEST_F (MasterInitExitUnitTest, MasterConfigShow)
@@ -77,9 +77,244 @@ TEST_F (MasterIntegrationTestNoResponseYet, ApiSlmpInvalidNetmask)
       -1);
 }
 
+TEST_F (MasterUnitTest, ApiSlmpSeparateThread)
+{
+   int i;
+
+   config.use_separate_slmp_thread = true;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 0);
+
+   /* The node search request is sent by the SLMP thread */
+   EXPECT_EQ (clm_perform_node_search (&clm), 0);
+   clm_handle_periodic (&clm);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 0);
+   EXPECT_EQ (clm.node_search_serial, CLM_SLMP_SERIAL_NONE);
+
+   EXPECT_EQ (clm_handle_slmp_periodic (&clm), 0);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 1);
+   EXPECT_NE (clm.node_search_serial, CLM_SLMP_SERIAL_NONE);
+
+   /* Invalid arguments are reported directly */
+   EXPECT_EQ (
+      clm_set_slave_ipaddr (&clm, &remote_mac_addr, new_ip, 0xFF00FF00),
+      -1);
+
+   /* Fill the request queue */
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      EXPECT_EQ (
+         clm_set_slave_ipaddr (&clm, &remote_mac_addr, new_ip, new_netmask),
+         0);
+   }
+   EXPECT_EQ (
+      clm_set_slave_ipaddr (&clm, &remote_mac_addr, new_ip, new_netmask),
+      -1);
+
+   /* Only the first set IP request is sent. The others are reported as
+      failed, as there already is a request in progress. */
+   EXPECT_EQ (clm_handle_slmp_periodic (&clm), 0);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 2);
+   EXPECT_EQ (
+      cb_counters->master_cb_set_ip.calls,
+      CL_COMMAND_QUEUE_SIZE - 1);
+   EXPECT_EQ (
+      cb_counters->master_cb_set_ip.status,
+      CLM_MASTER_SET_IP_STATUS_ERROR);
+   EXPECT_NE (clm.set_ip_request_serial, CLM_SLMP_SERIAL_NONE);
+}
+
+TEST_F (MasterUnitTest, ApiSlmpSeparateThreadWithCommands)
+{
+   clm_command_t command;
+   clal_clear_memory (&command, sizeof (command));
+
+   config.use_separate_slmp_thread = true;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   /* Requests from commands and from direct calls share the queue */
+   command.type = CLM_COMMAND_PERFORM_NODE_SEARCH;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   clm_handle_periodic (&clm);
+   EXPECT_EQ (cb_counters->master_cb_command.result, 0);
+   EXPECT_EQ (
+      clm_set_slave_ipaddr (&clm, &remote_mac_addr, new_ip, new_netmask),
+      0);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 0);
+
+   EXPECT_EQ (clm_handle_slmp_periodic (&clm), 0);
+   EXPECT_EQ (mock_slmp_send_port->number_of_calls_send, 2);
+   EXPECT_NE (clm.node_search_serial, CLM_SLMP_SERIAL_NONE);
+   EXPECT_NE (clm.set_ip_request_serial, CLM_SLMP_SERIAL_NONE);
+}
+
+TEST_F (MasterUnitTest, ApiSubmitCommand)
+{
+   clm_command_t command;
+   int i;
+   clal_clear_memory (&command, sizeof (command));
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   EXPECT_EQ (clm_submit_command (&clm, nullptr), -1);
+
+   /* Commands are executed at the start of the periodic call */
+   command.type               = CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS;
+   command.tag                = 17;
+   command.group_index        = gi;
+   command.slave_device_index = sdi;
+   command.enabled            = false;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   EXPECT_TRUE (clm.groups[gi].slave_devices[sdi].enabled);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 0);
+
+   clm_handle_periodic (&clm);
+   EXPECT_FALSE (clm.groups[gi].slave_devices[sdi].enabled);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 1);
+   EXPECT_EQ (
+      cb_counters->master_cb_command.type,
+      CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 17U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, 0);
+
+   /* Failures are reported in the callback */
+   command.type               = CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT;
+   command.tag                = 18;
+   command.slave_device_index = CLM_MAX_OCCUPIED_STATIONS_PER_GROUP;
+   command.force              = true;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   clm_handle_periodic (&clm);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 2);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 18U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, -1);
+
+   /* Several commands are executed in order */
+   command.type            = CLM_COMMAND_SET_MASTER_APPLICATION_STATUS;
+   command.tag             = 19;
+   command.running         = false;
+   command.stopped_by_user = true;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   command.type = CLM_COMMAND_PERFORM_NODE_SEARCH;
+   command.tag  = 20;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   clm_handle_periodic (&clm);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 4);
+   EXPECT_EQ (
+      cb_counters->master_cb_command.type,
+      CLM_COMMAND_PERFORM_NODE_SEARCH);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 20U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, 0);
+   EXPECT_EQ (
+      clm_get_master_application_status (&clm),
+      CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_STOPPED_BY_USER);
+   EXPECT_NE (clm.node_search_serial, CLM_SLMP_SERIAL_NONE);
+
+   /* Fill the command queue */
+   command.type = CLM_COMMAND_SET_MASTER_APPLICATION_STATUS;
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   }
+   EXPECT_EQ (clm_submit_command (&clm, &command), -1);
+   clm_handle_periodic (&clm);
+   EXPECT_EQ (
+      cb_counters->master_cb_command.calls,
+      4 + CL_COMMAND_QUEUE_SIZE);
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   clm_handle_periodic (&clm);
+}
+
+TEST_F (MasterUnitTest, ApiSubmitCommandWithShards)
+{
+   clm_command_t command;
+   int i;
+   clal_clear_memory (&command, sizeof (command));
+
+#if CLM_MAX_SHARDS < 2
+   GTEST_SKIP() << "Skipping as CLM_MAX_SHARDS is too small";
+#endif
+
+   config.number_of_shards = 2;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   /* Group commands are handed over to the shard running the group */
+   command.type               = CLM_COMMAND_SET_SLAVE_COMMUNICATION_STATUS;
+   command.tag                = 21;
+   command.group_index        = gi;
+   command.slave_device_index = sdi;
+   command.enabled            = false;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   command.type  = CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT;
+   command.tag   = 22;
+   command.force = true;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+
+   /* Invalid commands fail without reaching the shard */
+   command.tag                = 23;
+   command.slave_device_index = CLM_MAX_OCCUPIED_STATIONS_PER_GROUP;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+
+   clm_master_handle_commands (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 1);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 23U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, -1);
+   EXPECT_TRUE (clm.groups[gi].slave_devices[sdi].enabled);
+   EXPECT_FALSE (clm.groups[gi].slave_devices[sdi].force_transmission_bit);
+
+   /* The shard executes the commands, and queues the command callbacks */
+   clm_iefb_shard_periodic (&clm, gi % 2, now);
+   EXPECT_FALSE (clm.groups[gi].slave_devices[sdi].enabled);
+   EXPECT_TRUE (clm.groups[gi].slave_devices[sdi].force_transmission_bit);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 1);
+   EXPECT_EQ (clm_iefb_dispatch_callbacks (&clm), 2);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 3);
+   EXPECT_EQ (
+      cb_counters->master_cb_command.type,
+      CLM_COMMAND_FORCE_CYCLIC_TRANSMISSION_BIT);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 22U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, 0);
+
+   /* The setters also use the shard command queue, without callbacks */
+   EXPECT_EQ (clm_set_slave_communication_status (&clm, gi, sdi, true), 0);
+   EXPECT_EQ (clm_force_cyclic_transmission_bit (&clm, gi, sdi, false), 0);
+   EXPECT_EQ (
+      clm_set_slave_communication_status (
+         &clm,
+         gi,
+         CLM_MAX_OCCUPIED_STATIONS_PER_GROUP,
+         true),
+      -1);
+   EXPECT_EQ (
+      clm_force_cyclic_transmission_bit (&clm, CLM_MAX_GROUPS, 0, true),
+      -1);
+   EXPECT_FALSE (clm.groups[gi].slave_devices[sdi].enabled);
+   clm_iefb_shard_periodic (&clm, gi % 2, now);
+   EXPECT_TRUE (clm.groups[gi].slave_devices[sdi].enabled);
+   EXPECT_FALSE (clm.groups[gi].slave_devices[sdi].force_transmission_bit);
+   EXPECT_EQ (clm_iefb_dispatch_callbacks (&clm), 0);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 3);
+
+   /* Fill the shard command queue */
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      EXPECT_EQ (clm_force_cyclic_transmission_bit (&clm, gi, sdi, true), 0);
+   }
+   EXPECT_EQ (clm_force_cyclic_transmission_bit (&clm, gi, sdi, true), -1);
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   command.slave_device_index = sdi;
+   command.tag                = 24;
+   EXPECT_EQ (clm_submit_command (&clm, &command), 0);
+   clm_master_handle_commands (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_command.calls, 5);
+   EXPECT_EQ (cb_counters->master_cb_command.tag, 24U);
+   EXPECT_EQ (cb_counters->master_cb_command.result, -1);
+   clm_iefb_shard_periodic (&clm, gi % 2, now);
+   EXPECT_EQ (clm_force_cyclic_transmission_bit (&clm, gi, sdi, true), 0);
+}
+
 TEST_F (MasterApiUnitTest, ClmInit)
 {
    clm_group_status_details_t group_details;
+   clm_slave_device_data_t slave_snapshot;
    const clm_slave_device_data_t * slave_connction_details      = nullptr;
    const uint16_t num_occupied                                  = 3;
    uint16_t resulting_occupied                                  = UINT16_MAX;
@@ -167,6 +402,18 @@ TEST_F (MasterApiUnitTest, ClmInit)
    EXPECT_EQ (slave_connction_details->enabled, true);
    EXPECT_TRUE (clm_get_device_connection_details (clm, gi, 1000) == nullptr);
    EXPECT_TRUE (clm_get_device_connection_details (clm, 1000, di) == nullptr);
+   EXPECT_EQ (
+      clm_get_device_connection_snapshot (clm, gi, di, &slave_snapshot),
+      0);
+   EXPECT_EQ (slave_snapshot.enabled, true);
+   EXPECT_EQ (slave_snapshot.device_index, di);
+   EXPECT_EQ (
+      clm_get_device_connection_snapshot (clm, gi, 1000, &slave_snapshot),
+      -1);
+   EXPECT_EQ (
+      clm_get_device_connection_snapshot (clm, 1000, di, &slave_snapshot),
+      -1);
+   EXPECT_EQ (clm_get_device_connection_snapshot (clm, gi, di, nullptr), -1);
 
    EXPECT_EQ (clm_get_master_status (clm, &master_details), 0);
    EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_RUNNING);
@@ -187,6 +434,10 @@ TEST_F (MasterApiUnitTest, ClmInit)
    EXPECT_EQ (clm_get_group_status (nullptr, gi, &group_details), -1);
    EXPECT_EQ (clm_get_group_status (clm, 1000, &group_details), -1);
 
+   /* Double buffered outputs are not enabled */
+   EXPECT_EQ (clm_publish_outputs (clm, gi), -1);
+   EXPECT_EQ (clm_publish_outputs (nullptr, gi), -1);
+
    /* Clean slave communication statistics */
    clm_clear_statistics (clm);
 
@@ -384,11 +635,17 @@ TEST_F (MasterApiUnitTest, ClmIsNull)
 {
    const clm_cfg_t config         = {};
    uint16_t num_occupied_stations = UINT16_MAX;
+   clm_slave_device_data_t device_details;
 
    ASSERT_EQ (clm_init_only (nullptr, &config), -1);
    ASSERT_EQ (clm_exit (nullptr), -1);
+   ASSERT_EQ (clm_handle_slmp_periodic (nullptr), -1);
+   ASSERT_EQ (clm_submit_command (nullptr, nullptr), -1);
 
    ASSERT_TRUE (clm_get_device_connection_details (nullptr, 0, 0) == nullptr);
+   ASSERT_EQ (
+      clm_get_device_connection_snapshot (nullptr, 0, 0, &device_details),
+      -1);
 
    /* Memory areas for a group */
    num_occupied_stations = UINT16_MAX;
@@ -536,3 +793,158 @@ TEST_F (MasterApiUnitTest, ClmInitExit)
    EXPECT_EQ (clm_exit (clm), 0);
    free (clm);
 }
+
+/**
+ * Verify the deadline for next call to clm_handle_periodic()
+ *
+ */
+TEST_F (MasterApiUnitTest, ClmGetNextDeadline)
+{
+   clm_t * clm                                      = nullptr;
+   clm_cfg_t config                                 = {};
+   uint32_t time_to_deadline                        = 0;
+   config.protocol_ver                              = 2;
+   config.arbitration_time                          = 2500;
+   config.master_id                                 = 0x01020304;
+   config.hier.number_of_groups                     = 1;
+   config.hier.groups[0].timeout_value              = 500;
+   config.hier.groups[0].parallel_off_timeout_count = 3;
+   config.hier.groups[0].num_slave_devices          = 1;
+   config.hier.groups[0].slave_devices[0].slave_id  = slave_id;
+   config.hier.groups[0].slave_devices[0].num_occupied_stations = 1;
+
+   EXPECT_EQ (clm_get_next_deadline_us (nullptr, &time_to_deadline), -1);
+
+   /* Start the stack. Arbitration timer is running */
+   clm = clm_init (&config);
+   ASSERT_TRUE (clm != nullptr);
+   EXPECT_EQ (clm_get_next_deadline_us (clm, nullptr), -1);
+   EXPECT_EQ (clm_get_next_deadline_us (clm, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 2500000U);
+
+   mock_data.timestamp_us += tick_size;
+   clm_handle_periodic (clm);
+   EXPECT_EQ (clm_get_next_deadline_us (clm, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 2500000U - tick_size);
+
+   /* Deadline has passed */
+   mock_data.timestamp_us += longer_than_arbitration;
+   EXPECT_EQ (clm_get_next_deadline_us (clm, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 0U);
+
+   /* Arbitration done, link scan started. Waiting for the response. */
+   clm_handle_periodic (clm);
+   EXPECT_EQ (clm_get_master_status (clm, &master_details), 0);
+   EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_RUNNING);
+   EXPECT_EQ (clm_get_next_deadline_us (clm, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 500000U);
+
+   mock_data.timestamp_us += tick_size;
+   EXPECT_EQ (clm_get_next_deadline_us (clm, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 500000U - tick_size);
+
+   /* Close down the stack */
+   EXPECT_EQ (clm_exit (clm), 0);
+   free (clm);
+}
+
+TEST_F (MasterApiUnitTest, ClmGetSockets)
+{
+   clm_t * clm                                      = nullptr;
+   clm_cfg_t config                                 = {};
+   cl_socket_info_t sockets[CL_MAX_SOCKETS]         = {};
+   uint16_t number_of_sockets                       = 0;
+   config.protocol_ver                              = 2;
+   config.arbitration_time                          = 2500;
+   config.master_id                                 = 0x01020304;
+   config.hier.number_of_groups                     = 1;
+   config.hier.groups[0].timeout_value              = 500;
+   config.hier.groups[0].parallel_off_timeout_count = 3;
+   config.hier.groups[0].num_slave_devices          = 1;
+   config.hier.groups[0].slave_devices[0].slave_id  = slave_id;
+   config.hier.groups[0].slave_devices[0].num_occupied_stations = 1;
+
+   EXPECT_EQ (
+      clm_get_sockets (nullptr, sockets, CL_MAX_SOCKETS, &number_of_sockets),
+      -1);
+
+   /* Without separate arbitration socket */
+   clm = clm_init (&config);
+   ASSERT_TRUE (clm != nullptr);
+   EXPECT_EQ (
+      clm_get_sockets (clm, nullptr, CL_MAX_SOCKETS, &number_of_sockets),
+      -1);
+   EXPECT_EQ (clm_get_sockets (clm, sockets, CL_MAX_SOCKETS, nullptr), -1);
+   EXPECT_EQ (
+      clm_get_sockets (clm, sockets, CL_MAX_SOCKETS, &number_of_sockets),
+      0);
+   EXPECT_EQ (number_of_sockets, 2);
+   EXPECT_EQ (sockets[0].handle, clm->cciefb_socket);
+   EXPECT_EQ (sockets[0].role, CL_SOCKET_ROLE_CCIEFB);
+   EXPECT_EQ (sockets[1].handle, clm->slmp_receive_socket);
+   EXPECT_EQ (sockets[1].role, CL_SOCKET_ROLE_SLMP);
+
+   /* Too small list */
+   number_of_sockets = 0;
+   EXPECT_EQ (clm_get_sockets (clm, sockets, 1, &number_of_sockets), -1);
+   EXPECT_EQ (number_of_sockets, 0);
+
+   EXPECT_EQ (clm_exit (clm), 0);
+   free (clm);
+
+   /* With separate arbitration socket */
+   config.use_separate_arbitration_socket = true;
+   clm                                    = clm_init (&config);
+   ASSERT_TRUE (clm != nullptr);
+   EXPECT_EQ (
+      clm_get_sockets (clm, sockets, CL_MAX_SOCKETS, &number_of_sockets),
+      0);
+   EXPECT_EQ (number_of_sockets, 3);
+   EXPECT_EQ (sockets[0].handle, clm->cciefb_socket);
+   EXPECT_EQ (sockets[0].role, CL_SOCKET_ROLE_CCIEFB);
+   EXPECT_EQ (sockets[1].handle, clm->cciefb_arbitration_socket);
+   EXPECT_EQ (sockets[1].role, CL_SOCKET_ROLE_CCIEFB_ARBITRATION);
+   EXPECT_EQ (sockets[2].handle, clm->slmp_receive_socket);
+   EXPECT_EQ (sockets[2].role, CL_SOCKET_ROLE_SLMP);
+
+   EXPECT_EQ (clm_exit (clm), 0);
+   free (clm);
+}
+
+TEST_F (MasterApiUnitTest, ClmHandleReadable)
+{
+   clm_t * clm                                      = nullptr;
+   clm_cfg_t config                                 = {};
+   uint16_t recv_calls                              = 0;
+   config.protocol_ver                              = 2;
+   config.arbitration_time                          = 2500;
+   config.master_id                                 = 0x01020304;
+   config.hier.number_of_groups                     = 1;
+   config.hier.groups[0].timeout_value              = 500;
+   config.hier.groups[0].parallel_off_timeout_count = 3;
+   config.hier.groups[0].num_slave_devices          = 1;
+   config.hier.groups[0].slave_devices[0].slave_id  = slave_id;
+   config.hier.groups[0].slave_devices[0].num_occupied_stations = 1;
+
+   clm = clm_init (&config);
+   ASSERT_TRUE (clm != nullptr);
+   clm_handle_periodic (clm);
+   EXPECT_EQ (clm_get_master_status (clm, &master_details), 0);
+   EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_ARBITRATION);
+
+   /* Sockets are read, but the expired arbitration timer is not handled */
+   mock_data.timestamp_us += longer_than_arbitration;
+   recv_calls = mock_cciefb_port->number_of_calls_recv;
+   clm_handle_cciefb_readable (clm);
+   clm_handle_slmp_readable (clm);
+   EXPECT_GT (mock_cciefb_port->number_of_calls_recv, recv_calls);
+   EXPECT_EQ (clm_get_master_status (clm, &master_details), 0);
+   EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_ARBITRATION);
+
+   clm_handle_periodic (clm);
+   EXPECT_EQ (clm_get_master_status (clm, &master_details), 0);
+   EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_RUNNING);
+
+   EXPECT_EQ (clm_exit (clm), 0);
+   free (clm);
+}
@@ -444,8 +444,9 @@ TEST_F (UnitTest, UpdateSlaveIds)
  */
 TEST_F (MasterUnitTest, CciefbReceivedFromAllDevices)
 {
-   const clm_group_setting_t * group_setting = &clm.config.hier.groups[gi];
-   clm_group_data_t * group_data             = &clm.groups[gi];
+   clm_group_data_t * group_data    = &clm.groups[gi];
+   clm_slave_device_hot_t * device0 = &group_data->slave_devices[sdi0];
+   clm_slave_device_hot_t * device1 = &group_data->slave_devices[sdi];
 
    ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
    ASSERT_TRUE (group_data->slave_devices[sdi0].enabled);
@@ -461,36 +462,41 @@ TEST_F (MasterUnitTest, CciefbReceivedFromAllDevices)
    group_data->slave_devices[sdi0].device_state     = CLM_DEVICE_STATE_WAIT_TD;
    group_data->slave_devices[sdi].transmission_bit  = false;
    group_data->slave_devices[sdi].device_state      = CLM_DEVICE_STATE_WAIT_TD;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state     = CLM_DEVICE_STATE_WAIT_TD;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    /* Consecutive link scans (frame sequence != 0) */
    group_data->frame_sequence_no = 1;
@@ -499,57 +505,65 @@ TEST_F (MasterUnitTest, CciefbReceivedFromAllDevices)
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENDING;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = true;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENDING;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = true;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENDING;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENDING;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = true;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state     = CLM_DEVICE_STATE_WAIT_TD;
    group_data->slave_devices[sdi].transmission_bit  = false;
    group_data->slave_devices[sdi].device_state      = CLM_DEVICE_STATE_WAIT_TD;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = true;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state     = CLM_DEVICE_STATE_WAIT_TD;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    /* Consecutive link scans (frame sequence != 0), one slave disabled */
 
@@ -557,41 +571,112 @@ TEST_F (MasterUnitTest, CciefbReceivedFromAllDevices)
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state     = CLM_DEVICE_STATE_WAIT_TD;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENT;
-   EXPECT_TRUE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_TRUE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = true;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SENDING;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 
    /* Consecutive link scans (frame sequence != 0), all slaves disabled */
    group_data->slave_devices[sdi0].transmission_bit = false;
    group_data->slave_devices[sdi0].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
    group_data->slave_devices[sdi].transmission_bit = false;
    group_data->slave_devices[sdi].device_state = CLM_DEVICE_STATE_CYCLIC_SUSPEND;
-   EXPECT_FALSE (
-      clm_iefb_group_have_received_from_all_devices (group_setting, group_data));
+   clm_iefb_update_awaiting_responses (group_data, device0);
+   clm_iefb_update_awaiting_responses (group_data, device1);
+   EXPECT_FALSE (clm_iefb_group_have_received_from_all_devices (group_data));
 }
 
 /********************** Group state machine ****************************/
 
+TEST_F (MasterUnitTest, CciefbSlaveLookupIndex)
+{
+   const clm_slave_index_entry_t * entry;
+   uint16_t group_index        = 0;
+   uint16_t slave_device_index = 0;
+   cl_ipaddr_t ip_addr         = 0;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   entry = clm_iefb_find_slave (&clm, remote_ip_di0);
+   ASSERT_TRUE (entry != nullptr);
+   EXPECT_EQ (entry->slave_id, remote_ip_di0);
+   EXPECT_EQ (entry->group_index, gi);
+   EXPECT_EQ (entry->device_index, sdi0);
+
+   entry = clm_iefb_find_slave (&clm, remote_ip);
+   ASSERT_TRUE (entry != nullptr);
+   EXPECT_EQ (entry->slave_id, remote_ip);
+   EXPECT_EQ (entry->group_index, gi);
+   EXPECT_EQ (entry->device_index, sdi);
+
+   /* Unknown and invalid IP addresses */
+   EXPECT_TRUE (clm_iefb_find_slave (&clm, my_ip) == nullptr);
+   EXPECT_TRUE (clm_iefb_find_slave (&clm, new_ip) == nullptr);
+   EXPECT_TRUE (clm_iefb_find_slave (&clm, CL_IPADDR_INVALID) == nullptr);
+
+   /* Fill all groups, so that several addresses need probing */
+   clm.config.hier.number_of_groups = CLM_MAX_GROUPS;
+   for (group_index = 0; group_index < CLM_MAX_GROUPS; group_index++)
+   {
+      clm.config.hier.groups[group_index].num_slave_devices =
+         CLM_MAX_OCCUPIED_STATIONS_PER_GROUP;
+      for (slave_device_index = 0;
+           slave_device_index < CLM_MAX_OCCUPIED_STATIONS_PER_GROUP;
+           slave_device_index++)
+      {
+         clm.config.hier.groups[group_index]
+            .slave_devices[slave_device_index]
+            .slave_id = 0x0A000000 + (group_index << 8) + slave_device_index;
+         clm.config.hier.groups[group_index]
+            .slave_devices[slave_device_index]
+            .num_occupied_stations = 1;
+      }
+   }
+   clm_iefb_build_slave_index (&clm);
+
+   for (group_index = 0; group_index < CLM_MAX_GROUPS; group_index++)
+   {
+      for (slave_device_index = 0;
+           slave_device_index < CLM_MAX_OCCUPIED_STATIONS_PER_GROUP;
+           slave_device_index++)
+      {
+         ip_addr = 0x0A000000 + (group_index << 8) + slave_device_index;
+         entry   = clm_iefb_find_slave (&clm, ip_addr);
+         ASSERT_TRUE (entry != nullptr);
+         EXPECT_EQ (entry->slave_id, ip_addr);
+         EXPECT_EQ (entry->group_index, group_index);
+         EXPECT_EQ (entry->device_index, slave_device_index);
+      }
+   }
+
+   /* The previous configuration is no longer in the index */
+   EXPECT_TRUE (clm_iefb_find_slave (&clm, remote_ip_di0) == nullptr);
+   EXPECT_TRUE (clm_iefb_find_slave (&clm, remote_ip) == nullptr);
+}
+
 TEST_F (MasterUnitTest, CciefbGroupStatemachineInStateDown)
 {
    const clm_group_event_t events_without_effect[] = {
@@ -963,7 +1048,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateDown)
       CLM_DEVICE_EVENT_LAST};
    size_t i;
    clm_group_data_t * gd         = &clm.groups[gi];
-   clm_slave_device_data_t * sdd = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd = &clm.groups[gi].slave_devices[sdi];
    sdd->slave_station_no         = 1;
 
    clm_iefb_device_fsm_tables_init (&clm);
@@ -1007,7 +1092,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateListen)
       CLM_DEVICE_EVENT_LAST};
    size_t i;
    clm_group_data_t * gd         = &clm.groups[gi];
-   clm_slave_device_data_t * sdd = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd = &clm.groups[gi].slave_devices[sdi];
    sdd->slave_station_no         = 2;
    sdd->device_index             = 1;
 
@@ -1079,7 +1164,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateWaitTD)
    clm_group_data_t * gd = &clm.groups[gi];
    clm_slave_device_setting_t * device_setting =
       &clm.config.hier.groups[gi].slave_devices[sdi];
-   clm_slave_device_data_t * sdd = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd = &clm.groups[gi].slave_devices[sdi];
 
    sdd->device_index        = sdi;
    sdd->slave_station_no    = 1;
@@ -1157,7 +1242,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateCyclicSending)
       CLM_DEVICE_EVENT_LAST};
    size_t i;
    clm_group_data_t * gd               = &clm.groups[gi];
-   clm_slave_device_data_t * sdd       = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd       = &clm.groups[gi].slave_devices[sdi];
    clm_group_setting_t * group_setting = &clm.config.hier.groups[gi];
    clm_slave_device_setting_t * device_setting =
       &group_setting->slave_devices[sdi];
@@ -1265,7 +1350,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateCyclicSent)
       CLM_DEVICE_EVENT_LAST};
    size_t i;
    clm_group_data_t * gd         = &clm.groups[gi];
-   clm_slave_device_data_t * sdd = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd = &clm.groups[gi].slave_devices[sdi];
    sdd->slave_station_no         = 1;
    sdd->device_index             = sdi;
    clm.config.connect_cb         = my_master_connect_ind;
@@ -1343,7 +1428,7 @@ TEST_F (MasterUnitTest, CciefbDeviceStatemachineInStateCyclicSuspend)
       CLM_DEVICE_EVENT_LAST};
    size_t i;
    clm_group_data_t * gd         = &clm.groups[gi];
-   clm_slave_device_data_t * sdd = &clm.groups[gi].slave_devices[sdi];
+   clm_slave_device_hot_t * sdd = &clm.groups[gi].slave_devices[sdi];
    sdd->slave_station_no         = 1;
 
    clm_iefb_device_fsm_tables_init (&clm);
@@ -1628,7 +1713,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbStartup)
       CLM_DEVICE_STATE_CYCLIC_SENT);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -1708,7 +1793,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbStartup)
    EXPECT_EQ (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -1769,7 +1854,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbStartup)
    EXPECT_EQ (statistics->measured_time.sum, 4 * tick_size);
    EXPECT_EQ (statistics->measured_time.average, 2 * tick_size);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -2119,7 +2204,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbStartupOnlyOneSlaveResponds)
       CLM_DEVICE_STATE_CYCLIC_SENT);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -2700,195 +2785,1131 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbStartupNoResponse)
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
 }
 
-TEST_F (MasterIntegrationTestNotInitialised, CciefbStartupFailsOpenArbitrationSocket)
+TEST_F (MasterIntegrationTestNotInitialised, CciefbRequestFramesSentInBatch)
 {
-   clm_cfg_t config_separate_socket                  = {};
-   cl_mock_udp_port_t * mock_cciefb_arbitration_port = &mock_data.udp_ports[1];
-
-   clal_memcpy (
-      &config_separate_socket,
-      sizeof (config_separate_socket),
-      &config,
-      sizeof (config));
-   config_separate_socket.use_separate_arbitration_socket = true;
-
-   mock_cciefb_arbitration_port->will_fail_open = true;
-
-   ASSERT_FALSE (mock_data.udp_ports[0].in_use);
-   ASSERT_FALSE (mock_data.udp_ports[1].in_use);
-   ASSERT_FALSE (mock_data.udp_ports[2].in_use);
-   ASSERT_FALSE (mock_data.udp_ports[3].in_use);
+   ASSERT_GE (CLM_MAX_GROUPS, 3);
+
+   config.hier.number_of_groups                     = 3;
+   config.hier.groups[1].timeout_value              = timeout_value;
+   config.hier.groups[1].parallel_off_timeout_count = 3;
+   config.hier.groups[1].num_slave_devices          = 1;
+   config.hier.groups[1].slave_devices[0].slave_id  = 0x01020310;
+   config.hier.groups[1].slave_devices[0].num_occupied_stations = 1;
+   config.hier.groups[2].timeout_value              = timeout_value;
+   config.hier.groups[2].parallel_off_timeout_count = 3;
+   config.hier.groups[2].num_slave_devices          = 1;
+   config.hier.groups[2].slave_devices[0].slave_id  = 0x01020311;
+   config.hier.groups[2].slave_devices[0].num_occupied_stations = 1;
 
-   EXPECT_EQ (clm_master_init (&clm, &config_separate_socket, now), -1);
-}
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
 
-TEST_F (MasterIntegrationTestNotInitialised, CciefbFailsToReadParameterFile)
-{
-   uint16_t * p_file_parameter_no  = nullptr;
-   const uint32_t magic            = CC_FROM_BE32 (0x434C4E4B); /* "CLNK" */
-   const uint32_t version          = CC_FROM_BE32 (0x00000001);
-   const uint16_t new_parameter_no = 1;
+   /* Run master stack, arbitration not done yet */
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send_batch, 0);
 
-   /* Clear existing file (containing parameter number) */
-   storage_file->file_size = (size_t)0;
-   clal_clear_memory (
-      &storage_file->file_content,
-      sizeof (storage_file->file_content));
+   /* Arbitration done. All groups start link scan, and the request
+      frames are sent in one batch. */
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[0].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (clm.groups[1].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (clm.groups[2].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send_batch, 1);
+   EXPECT_EQ (clm.cciefb_send_queue.count, 0);
+   EXPECT_FALSE (clm.cciefb_send_queue.deferred);
 
-   /* Start master */
-   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
-   EXPECT_EQ (clm.parameter_no, new_parameter_no);
+   /* No response. All groups time out and send new requests in one batch */
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send_batch, 2);
 
-   /* Verify updated file */
-   EXPECT_EQ (storage_file->file_size, expected_filesize);
-   EXPECT_EQ (memcmp (storage_file->file_content, &magic, 4), 0);
-   EXPECT_EQ (memcmp (storage_file->file_content + 4, &version, 4), 0);
-   p_file_parameter_no = (uint16_t *)&storage_file->file_content + 4;
-   EXPECT_EQ (*p_file_parameter_no, new_parameter_no);
+   /* Sending fails */
+   mock_cciefb_port->will_fail_send = true;
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send_batch, 3);
+   EXPECT_EQ (clm.cciefb_send_queue.count, 0);
 }
 
-TEST_F (MasterIntegrationTestNotInitialised, CciefbNoLinkscanCallback)
+TEST_F (MasterIntegrationTestNotInitialised, CciefbAsyncCallbacks)
 {
-   config.linkscan_cb = nullptr;
+   clm_master_status_details_t master_details;
+   clm_callback_record_t * record = nullptr;
+   uint16_t i;
+   clal_clear_memory (&master_details, sizeof (master_details));
+
+   config.use_async_callbacks         = true;
+   config.coalesce_linkscan_callbacks = true;
 
    ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
-   ASSERT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   ASSERT_EQ (mock_cciefb_port->total_sent_bytes, (size_t)0);
-   ASSERT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
-   EXPECT_EQ (clm.parameter_no, parameter_no);
-   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_state.calls, 2);
-   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_ARBITRATION);
-   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+   EXPECT_EQ (clm_dispatch_callbacks (nullptr), -1);
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), 0);
 
-   /* Run master stack, arbitration done */
+   /* Arbitration done. Start link scan. */
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
    now += longer_than_arbitration_us;
    clm_iefb_periodic (&clm, now);
-
    EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
 
-   EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
-   EXPECT_EQ (mock_cciefb_port->total_recv_bytes, (size_t)0);
-   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
+   /* No response. The link scan callbacks are queued, and the identical
+      ones are merged. */
+   for (i = 0; i < 3; i++)
+   {
+      now += longer_than_timeout_us;
+      clm_iefb_periodic (&clm, now);
+   }
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   EXPECT_EQ (clm_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.coalesced_linkscan_callbacks, 2U);
+   EXPECT_EQ (master_details.callback_queue_overflows, 0U);
 
-   /* Link scan times out */
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), 1);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 1);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.group_index, gi);
+   EXPECT_FALSE (cb_counters->master_cb_linkscan.success);
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), 0);
+
+   /* A new callback is queued once the previous one has been delivered */
    now += longer_than_timeout_us;
    clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), 1);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 2);
 
-   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
+   /* Not merged if another callback was queued after it */
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+   i      = clm.callback_queue.write_count & (CLM_CALLBACK_QUEUE_SIZE - 1);
+   record = &clm.callback_queue.records[i];
+   record->type        = CLM_CALLBACK_DISCONNECT;
+   record->group_index = gi;
+   clm.callback_queue.write_count++;
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.coalesced_linkscan_callbacks, 3U);
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), 3);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 4);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 1);
+
+   /* Without coalescing, callbacks are dropped when the queue is full */
+   clm.config.coalesce_linkscan_callbacks = false;
+   for (i = 0; i < CLM_CALLBACK_QUEUE_SIZE + 2; i++)
+   {
+      now += longer_than_timeout_us;
+      clm_iefb_periodic (&clm, now);
+   }
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 4);
+   EXPECT_EQ (clm_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.coalesced_linkscan_callbacks, 3U);
+   EXPECT_EQ (master_details.callback_queue_overflows, 2U);
+
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), CLM_CALLBACK_QUEUE_SIZE);
    EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
-   EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 2);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
-   EXPECT_EQ (mock_cciefb_port->total_recv_bytes, (size_t)0);
-   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_REQUEST_3_SLAVES);
-   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_state.calls, 3);
-   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
-   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
+      cb_counters->master_cb_linkscan.calls,
+      4 + CLM_CALLBACK_QUEUE_SIZE);
+
+   clm.config.use_async_callbacks = false;
+   EXPECT_EQ (clm_dispatch_callbacks (&clm), -1);
 }
 
-TEST_F (MasterIntegrationTestNotInitialised, CciefbForceTransmissionBits)
+TEST_F (MasterIntegrationTestNotInitialised, CciefbShards)
 {
-   config.linkscan_cb = nullptr;
+   const clm_slave_device_data_t * slave_device_connection_details = nullptr;
+   clm_master_status_details_t master_details;
+   uint32_t time_to_deadline = 0;
+   clal_clear_memory (&master_details, sizeof (master_details));
 
-   cl_mock_cyclic_request_result_t result;
-   clal_clear_memory (&result, sizeof (result));
+#if CLM_MAX_SHARDS < 2
+   GTEST_SKIP() << "Skipping as CLM_MAX_SHARDS is too small";
+#endif
+   ASSERT_GE (CLM_MAX_GROUPS, 2);
+
+   config.number_of_shards                          = 2;
+   config.hier.number_of_groups                     = 2;
+   config.hier.groups[1].timeout_value              = timeout_value;
+   config.hier.groups[1].parallel_off_timeout_count = 3;
+   config.hier.groups[1].num_slave_devices          = 1;
+   config.hier.groups[1].slave_devices[0].slave_id  = 0x01020310;
+   config.hier.groups[1].slave_devices[0].num_occupied_stations = 1;
 
    ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   slave_device_connection_details =
+      clm_iefb_get_device_connection_details (&clm, gi, sdi);
+   ASSERT_TRUE (slave_device_connection_details != nullptr);
 
-   ASSERT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   ASSERT_EQ (mock_cciefb_port->total_sent_bytes, (size_t)0);
-   ASSERT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].device_state,
-      CLM_DEVICE_STATE_LISTEN);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi].device_state,
-      CLM_DEVICE_STATE_LISTEN);
-   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_state.calls, 2);
-   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_ARBITRATION);
-   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+   EXPECT_EQ (clm_handle_shard_periodic (nullptr, 0), -1);
+   EXPECT_EQ (clm_handle_shard_periodic (&clm, 2), -1);
+   EXPECT_EQ (clm_get_shard_next_deadline_us (&clm, 2, &time_to_deadline), -1);
+   EXPECT_EQ (clm_get_shard_next_deadline_us (&clm, 0, nullptr), -1);
 
-   clm_iefb_force_cyclic_transmission_bit (&clm, gi, sdi, true);
+   /* The master state is updated from the shards when the master runs */
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 0);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 1);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_ARBITRATION);
 
-   /* Run master stack, arbitration done */
+   /* Arbitration done. The event is queued to the shards. */
    now += longer_than_arbitration_us;
    clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[0].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
+   EXPECT_EQ (clm.groups[1].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
 
-   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
-   EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
+   /* Each shard starts the link scan for its own group */
+   clm_iefb_shard_periodic (&clm, 0, now);
+   EXPECT_EQ (clm.groups[0].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (clm.groups[1].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
-   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_state.calls, 3);
-   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
-   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
-   ASSERT_EQ (mock_analyze_cyclic_request (mock_cciefb_port, &result), 0);
-   EXPECT_EQ (result.frame_sequence_no, frame_sequenceno_startup);
-   EXPECT_EQ (result.group_no, group_number);
-   EXPECT_EQ (result.cyclic_transmission_state, 0x0002); /* Slave 1 */
+   EXPECT_EQ (clm.shards[0].send_queue.count, 0);
 
-   clm_iefb_force_cyclic_transmission_bit (&clm, gi, sdi, false);
+   clm_iefb_shard_periodic (&clm, 1, now);
+   EXPECT_EQ (clm.groups[1].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+   EXPECT_EQ (clm.cciefb_send_queue.count, 0);
 
-   /* Time out, so a new frame will be sent*/
-   now += longer_than_timeout_us;
+   EXPECT_EQ (clm_get_shard_next_deadline_us (&clm, 0, &time_to_deadline), 0);
+   EXPECT_EQ (clm_get_shard_next_deadline_us (&clm, 1, &time_to_deadline), 0);
+
+   now += tick_size;
    clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 2);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
 
-   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   /* Slave responds. The frame is steered to the shard of the group. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.shards[0].frame_write_count, 1U);
+   EXPECT_EQ (clm.shards[1].frame_write_count, 0U);
    EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
+      slave_device_connection_details->statistics.number_of_incoming_frames,
+      0U);
+
+   clm_iefb_shard_periodic (&clm, 1, now);
    EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi].device_state,
-      CLM_DEVICE_STATE_WAIT_TD);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
-   ASSERT_EQ (mock_analyze_cyclic_request (mock_cciefb_port, &result), 0);
-   EXPECT_EQ (result.frame_sequence_no, frame_sequenceno_startup + 1);
-   EXPECT_EQ (result.group_no, group_number);
+      slave_device_connection_details->statistics.number_of_incoming_frames,
+      0U);
+
+   EXPECT_EQ (clm_handle_shard_periodic (&clm, 0), 0);
+   EXPECT_EQ (clm.shards[0].frame_read_count, 1U);
    EXPECT_EQ (
-      result.cyclic_transmission_state,
-      CL_CCIEFB_CYCLIC_REQ_DATA_HEADER_CYCLIC_TR_STATE_ALL_OFF);
+      slave_device_connection_details->statistics.number_of_incoming_frames,
+      1U);
    EXPECT_EQ (
-      result.master_local_unit_info,
-      CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_RUNNING);
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_CYCLIC_SENT);
+
+   /* Link scan timeout. The callbacks are queued by the shard, and called
+      by the master. */
+   now += longer_than_timeout_us;
+   clm_iefb_shard_periodic (&clm, 0, now);
+   EXPECT_GT (clm.shards[0].callback_queue.write_count, 0U);
    EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
-   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 1);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 1);
+   EXPECT_EQ (
+      clm.shards[0].callback_queue.read_count,
+      clm.shards[0].callback_queue.write_count);
+
+   EXPECT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_RUNNING);
+   EXPECT_EQ (master_details.shard_queue_overflows, 0U);
+   EXPECT_EQ (master_details.callback_queue_overflows, 0U);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbShardFrameQueueFull)
+{
+   clm_master_status_details_t master_details;
+   uint32_t i;
+
+#if CLM_MAX_SHARDS < 2
+   GTEST_SKIP() << "Skipping as CLM_MAX_SHARDS is too small";
+#endif
+   /* Fits more than one link scan of a full group */
+   ASSERT_GT (CLM_SHARD_FRAME_QUEUE_SIZE, CLM_MAX_OCCUPIED_STATIONS_PER_GROUP);
+
+   config.number_of_shards = 2;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   clm_iefb_shard_periodic (&clm, 0, now);
+   EXPECT_EQ (clm.groups[0].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+
+   /* Fill the queue of the shard, which is not running */
+   for (i = 0; i < CLM_SHARD_FRAME_QUEUE_SIZE; i++)
+   {
+      mock_set_udp_fakedata (
+         mock_cciefb_port,
+         remote_ip,
+         CL_CCIEFB_PORT,
+         (uint8_t *)&response_payload_di1,
+         SIZE_RESPONSE_2_SLAVES);
+      now += tick_size;
+      clm_iefb_periodic (&clm, now);
+      EXPECT_EQ (mock_cciefb_port->input_data_size, 0U);
+   }
+   EXPECT_EQ (clm.shards[0].frame_write_count, CLM_SHARD_FRAME_QUEUE_SIZE);
+   EXPECT_EQ (clm.shards[0].frame_read_count, 0U);
+
+   /* The queue is full. The next frame is read from the socket, and
+      dropped. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->input_data_size, 0U);
+   EXPECT_EQ (clm.shards[0].frame_write_count, CLM_SHARD_FRAME_QUEUE_SIZE);
+   EXPECT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.shard_queue_overflows, 1U);
+
+   /* Frames are queued again when the shard has caught up */
+   EXPECT_EQ (clm_handle_shard_periodic (&clm, 0), 0);
+   EXPECT_EQ (clm.shards[0].frame_read_count, CLM_SHARD_FRAME_QUEUE_SIZE);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->input_data_size, 0U);
+   EXPECT_EQ (clm.shards[0].frame_write_count, CLM_SHARD_FRAME_QUEUE_SIZE + 1);
+
+   EXPECT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.shard_queue_overflows, 1U);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbResponseTimeFromTimestamps)
+{
+   const clm_slave_device_data_t * slave_device_connection_details = nullptr;
+   const uint32_t transmission_delay                               = 300;
+   const uint32_t reception_delay                                  = 700;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   slave_device_connection_details =
+      clm_iefb_get_device_connection_details (&clm, gi, sdi0);
+   ASSERT_TRUE (slave_device_connection_details != nullptr);
+
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+
+   /* Arbitration done. Request is sent. The transmission timestamp from
+      the port is read later from the error queue. */
+   now += longer_than_arbitration_us;
+
+   mock_cciefb_port->use_timestamps  = true;
+   mock_cciefb_port->tx_timestamp_us = now + transmission_delay;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (clm.groups[gi].timestamp_link_scan_start, now);
+   EXPECT_EQ (clm.groups[gi].timestamp_request_sent, now);
+   EXPECT_FALSE (clm.groups[gi].timestamp_request_transmitted_valid);
+   EXPECT_EQ (mock_cciefb_port->error_queue_count, 1U);
+
+   /* Response with a reception timestamp from the port. The response time
+      does not depend on the tick. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   mock_cciefb_port->rx_timestamp_us = now + reception_delay;
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->error_queue_count, 0U);
+   EXPECT_TRUE (clm.groups[gi].timestamp_request_transmitted_valid);
+   EXPECT_EQ (
+      clm.groups[gi].timestamp_request_transmitted,
+      clm.groups[gi].timestamp_request_sent + transmission_delay);
+   EXPECT_TRUE (slave_device_connection_details->latest_frame.has_been_received);
+   EXPECT_EQ (
+      slave_device_connection_details->latest_frame.response_time,
+      reception_delay - transmission_delay);
+   EXPECT_EQ (
+      slave_device_connection_details->statistics.measured_time.max,
+      reception_delay - transmission_delay);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbResponseTimeFromTicks)
+{
+   const clm_slave_device_data_t * slave_device_connection_details = nullptr;
+   const uint32_t reception_delay                                  = 700;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   slave_device_connection_details =
+      clm_iefb_get_device_connection_details (&clm, gi, sdi0);
+   ASSERT_TRUE (slave_device_connection_details != nullptr);
+
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (mock_cciefb_port->error_queue_count, 0U);
+
+   /* Only the reception is timestamped by the port. The application ticks
+      are used on both sides. */
+   mock_cciefb_port->use_timestamps = true;
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   mock_cciefb_port->rx_timestamp_us = now + reception_delay;
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_FALSE (clm.groups[gi].timestamp_request_transmitted_valid);
+   EXPECT_TRUE (slave_device_connection_details->latest_frame.has_been_received);
+   EXPECT_EQ (
+      slave_device_connection_details->latest_frame.response_time,
+      tick_size);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbDroppedFrames)
+{
+   const clm_slave_device_data_t * slave_device_connection_details = nullptr;
+   clm_master_status_details_t master_details;
+   const size_t too_short_size = 5;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   slave_device_connection_details =
+      clm_iefb_get_device_connection_details (&clm, gi, sdi0);
+   ASSERT_TRUE (slave_device_connection_details != nullptr);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_FALSE (master_details.cciefb_socket_statistics.drops_available);
+
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+
+   /* No frames dropped yet */
+   mock_cciefb_port->use_drop_count = true;
+   mock_cciefb_port->drop_count     = 0;
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_TRUE (slave_device_connection_details->latest_frame.has_been_received);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_TRUE (master_details.cciefb_socket_statistics.drops_available);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_dropped_frames,
+      0U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_drop_events,
+      0U);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
+
+   /* The operating system reports dropped frames. The drop counter is
+      reported also for frames that are not valid. */
+   mock_cciefb_port->drop_count = 5;
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      too_short_size);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_dropped_frames,
+      5U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_drop_events,
+      1U);
+   EXPECT_EQ (master_details.cciefb_socket_statistics.os_drop_counter, 5U);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 1);
+   EXPECT_EQ (
+      cb_counters->master_cb_error.error_message,
+      CLM_ERROR_CCIEFB_FRAMES_DROPPED);
+   EXPECT_EQ (cb_counters->master_cb_error.ip_addr, my_ip);
+   EXPECT_EQ (cb_counters->master_cb_error.argument_2, 5);
+
+   /* Same counter value, no new drops */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      too_short_size);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_dropped_frames,
+      5U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_drop_events,
+      1U);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 1);
+
+   /* Clearing the statistics keeps the operating system counter */
+   clm_iefb_statistics_clear_all (&clm);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_TRUE (master_details.cciefb_socket_statistics.drops_available);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_dropped_frames,
+      0U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_drop_events,
+      0U);
+   EXPECT_EQ (master_details.cciefb_socket_statistics.os_drop_counter, 5U);
+
+   mock_cciefb_port->drop_count = 7;
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      too_short_size);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_dropped_frames,
+      2U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_drop_events,
+      1U);
+   EXPECT_FALSE (master_details.arbitration_socket_statistics.drops_available);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbStartupFailsOpenArbitrationSocket)
+{
+   clm_cfg_t config_separate_socket                  = {};
+   cl_mock_udp_port_t * mock_cciefb_arbitration_port = &mock_data.udp_ports[1];
+
+   clal_memcpy (
+      &config_separate_socket,
+      sizeof (config_separate_socket),
+      &config,
+      sizeof (config));
+   config_separate_socket.use_separate_arbitration_socket = true;
+
+   mock_cciefb_arbitration_port->will_fail_open = true;
+
+   ASSERT_FALSE (mock_data.udp_ports[0].in_use);
+   ASSERT_FALSE (mock_data.udp_ports[1].in_use);
+   ASSERT_FALSE (mock_data.udp_ports[2].in_use);
+   ASSERT_FALSE (mock_data.udp_ports[3].in_use);
+
+   EXPECT_EQ (clm_master_init (&clm, &config_separate_socket, now), -1);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbWildcardSocket)
+{
+   const clm_slave_device_data_t * slave_device_connection_details = nullptr;
+   const cl_ipaddr_t other_ip = 0x01020399; /* Other IP address on host */
+
+   config.use_separate_arbitration_socket = true;
+   config.use_wildcard_cciefb_socket      = true;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   /* One CCIEFB socket bound to all interfaces. No arbitration socket. */
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   ASSERT_EQ (&mock_data.udp_ports[1], mock_slmp_port);
+   EXPECT_TRUE (mock_cciefb_port->is_open);
+   EXPECT_EQ (mock_cciefb_port->ip_addr, CL_IPADDR_ANY);
+   EXPECT_EQ (mock_cciefb_port->port_number, CL_CCIEFB_PORT);
+   EXPECT_EQ (mock_slmp_port->port_number, CL_SLMP_PORT);
+   EXPECT_FALSE (mock_data.udp_ports[2].in_use);
+   EXPECT_EQ (clm.cciefb_arbitration_socket, -1);
+
+   slave_device_connection_details =
+      clm_iefb_get_device_connection_details (&clm, gi, sdi0);
+   ASSERT_TRUE (slave_device_connection_details != nullptr);
+
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 1);
+
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+
+   /* Response sent to another IP address on this host is dropped */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      other_ip,
+      my_ifindex,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_FALSE (slave_device_connection_details->latest_frame.has_been_received);
+
+   /* Response sent to our IP address is handled */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_TRUE (slave_device_connection_details->latest_frame.has_been_received);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbSocketProfile)
+{
+   cl_mock_udp_port_t * mock_cciefb_arbitration_port = &mock_data.udp_ports[1];
+   clm_master_status_details_t master_details;
+   clal_udp_error_queue_entry_t * entry = nullptr;
+   /* Responses for 1 and 2 occupied stations, plus overhead */
+   const uint32_t burst_size =
+      131 + 203 + 2 * CL_SOCKET_RECEIVE_OVERHEAD_PER_FRAME;
+
+   config.use_separate_arbitration_socket                = true;
+   config.cciefb_socket_profile.busy_poll_us             = 50;
+   config.cciefb_socket_profile.receive_buffer_size      = 100000;
+   config.cciefb_socket_profile.receive_buffer_for_burst = true;
+   config.cciefb_socket_profile.priority                 = 6;
+   config.cciefb_socket_profile.dscp                     = 46;
+   config.cciefb_socket_profile.enable_error_queue       = true;
+   EXPECT_EQ (clm_iefb_calc_receive_buffer_size (&config), burst_size);
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   /* Profile applied to both CCIEFB sockets, with resolved buffer size */
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_set_profile, 1);
+   EXPECT_EQ (mock_cciefb_port->profile.busy_poll_us, 50U);
+   EXPECT_EQ (mock_cciefb_port->profile.receive_buffer_size, burst_size);
+   EXPECT_EQ (mock_cciefb_port->profile.priority, 6);
+   EXPECT_EQ (mock_cciefb_port->profile.dscp, 46);
+   EXPECT_EQ (mock_cciefb_arbitration_port->number_of_calls_set_profile, 1);
+   EXPECT_EQ (
+      mock_cciefb_arbitration_port->profile.receive_buffer_size,
+      burst_size);
+
+   /* Applied settings are reported in the master status */
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.cciefb_socket_profile.busy_poll_us, 50U);
+   EXPECT_EQ (
+      master_details.cciefb_socket_profile.receive_buffer_size,
+      burst_size);
+   EXPECT_TRUE (master_details.cciefb_socket_profile.receive_buffer_for_burst);
+   EXPECT_EQ (master_details.cciefb_socket_profile.priority, 6);
+   EXPECT_EQ (master_details.cciefb_socket_profile.dscp, 46);
+   EXPECT_TRUE (master_details.cciefb_socket_profile.enable_error_queue);
+   EXPECT_EQ (
+      master_details.arbitration_socket_profile.receive_buffer_size,
+      burst_size);
+   EXPECT_TRUE (master_details.arbitration_socket_profile.enable_error_queue);
+
+   /* ICMP errors are read from the error queues of both sockets */
+   entry              = &mock_cciefb_port->error_queue[0];
+   entry->type        = CLAL_UDP_ERROR_QUEUE_ICMP_ERROR;
+   entry->offender_ip = remote_ip;
+   entry              = &mock_cciefb_port->error_queue[1];
+   entry->type        = CLAL_UDP_ERROR_QUEUE_ICMP_ERROR;
+   entry->offender_ip = remote_ip_di0;
+   entry              = &mock_cciefb_arbitration_port->error_queue[0];
+   entry->type        = CLAL_UDP_ERROR_QUEUE_ICMP_ERROR;
+   mock_cciefb_port->error_queue_count             = 2;
+   mock_cciefb_arbitration_port->error_queue_count = 1;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->error_queue_count, 0U);
+   EXPECT_EQ (mock_cciefb_arbitration_port->error_queue_count, 0U);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (
+      master_details.cciefb_socket_statistics.number_of_icmp_errors,
+      2U);
+   EXPECT_EQ (
+      master_details.arbitration_socket_statistics.number_of_icmp_errors,
+      1U);
+   clm_iefb_statistics_clear_all (&clm);
+   EXPECT_EQ (clm.cciefb_socket_statistics.number_of_icmp_errors, 0U);
+   EXPECT_EQ (clm_master_exit (&clm), 0);
+
+   /* Failing to apply the profile is not fatal */
+   mock_data.will_fail_set_socket_profile = true;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (master_details.cciefb_socket_profile.busy_poll_us, 0U);
+   EXPECT_EQ (master_details.cciefb_socket_profile.receive_buffer_size, 0U);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbDoubleBufferedOutputs)
+{
+   cl_rww_t * resulting_rww_area = nullptr;
+   cl_ry_t * resulting_ry_area   = nullptr;
+   cl_rww_t * rww_area           = nullptr;
+   uint8_t * staging_buffer      = nullptr;
+   uint16_t total_occupied       = 0;
+   const uint16_t registernumber = 3;
+   const uint16_t bitnumber      = 5;
+   const uint16_t value_A        = 0x1234;
+   const uint16_t value_B        = 0x5678;
+
+   config.use_double_buffered_outputs = true;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
+
+   /* Written to the inactive frame, but not yet published */
+   clm_set_rww_value (&clm, gi, sdi0, registernumber, value_A);
+   clm_set_ry_bit (&clm, gi, sdi0, bitnumber, true);
+   EXPECT_EQ (clm_get_rww_value (&clm, gi, sdi0, registernumber), value_A);
+   EXPECT_TRUE (clm_get_ry_bit (&clm, gi, sdi0, bitnumber));
+
+   /* Both slaves respond. Master sends next request. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_CYCLIC_SENDING);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+   resulting_rww_area =
+      mock_analyze_cyclic_request_rww (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_rww_area, nullptr);
+   EXPECT_EQ (CC_FROM_LE16 (resulting_rww_area->words[registernumber]), 0);
+   resulting_ry_area =
+      mock_analyze_cyclic_request_ry (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_ry_area, nullptr);
+   EXPECT_EQ (resulting_ry_area->bytes[0], 0x00);
+
+   /* Publish. Inactive frame keeps the published values. */
+   EXPECT_EQ (clm_publish_outputs (&clm, gi), 0);
+   EXPECT_EQ (clm_get_rww_value (&clm, gi, sdi0, registernumber), value_A);
+   EXPECT_TRUE (clm_get_ry_bit (&clm, gi, sdi0, bitnumber));
+   clm_set_rww_value (&clm, gi, sdi0, registernumber, value_B);
+
+   /* Both slaves respond. Published values are sent. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di0_next_sequence_number,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
+   resulting_rww_area =
+      mock_analyze_cyclic_request_rww (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_rww_area, nullptr);
+   EXPECT_EQ (CC_FROM_LE16 (resulting_rww_area->words[registernumber]), value_A);
+   resulting_ry_area =
+      mock_analyze_cyclic_request_ry (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_ry_area, nullptr);
+   EXPECT_EQ (resulting_ry_area->bytes[0], 0x20);
+   EXPECT_EQ (clm_get_rww_value (&clm, gi, sdi0, registernumber), value_B);
+
+   /* Only stations marked as changed are copied to the new inactive
+      frame. Getting the pointer marks all stations in the group. */
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0001);
+   rww_area = clm_get_first_rww_area (&clm, gi, &total_occupied);
+   ASSERT_NE (rww_area, nullptr);
+   ASSERT_EQ (total_occupied, 3U);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0007);
+   rww_area[1].words[0] = CC_TO_LE16 (value_A);
+   rww_area[2].words[0] = CC_TO_LE16 (value_B);
+   EXPECT_EQ (clm_publish_outputs (&clm, gi), 0);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0000);
+   rww_area = clm_get_first_rww_area (&clm, gi, &total_occupied);
+   ASSERT_NE (rww_area, nullptr);
+   EXPECT_EQ (CC_FROM_LE16 (rww_area[0].words[registernumber]), value_B);
+   EXPECT_EQ (CC_FROM_LE16 (rww_area[1].words[0]), value_A);
+   EXPECT_EQ (CC_FROM_LE16 (rww_area[2].words[0]), value_B);
+
+   /* Both frames are initialised when the group parameters are updated */
+   staging_buffer = clm.groups[gi].staging_req_frame.buffer;
+   clm_iefb_reflect_group_parameters (&clm, &clm.groups[gi]);
+   EXPECT_EQ (clm.groups[gi].staging_req_frame.buffer, staging_buffer);
+   EXPECT_NE (clm.groups[gi].req_frame.buffer, staging_buffer);
+   rww_area = clm_get_first_rww_area (&clm, gi, &total_occupied);
+   ASSERT_NE (rww_area, nullptr);
+   EXPECT_EQ (CC_FROM_LE16 (rww_area[1].words[0]), 0);
+   EXPECT_EQ (CC_FROM_LE16 (rww_area[2].words[0]), 0);
+
+   /* Invalid group */
+   EXPECT_EQ (clm_publish_outputs (&clm, config.hier.number_of_groups), -1);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbPublishOutputsNotEnabled)
+{
+   ASSERT_FALSE (config.use_double_buffered_outputs);
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   EXPECT_EQ (clm_publish_outputs (&clm, gi), -1);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbOutputDirtyTracking)
+{
+   cl_rww_t * resulting_rww_area = nullptr;
+   cl_rww_t * rww_area           = nullptr;
+   uint16_t total_occupied       = 0;
+   const uint16_t registernumber = 3;
+   const uint16_t value_A        = 0x1234;
+   const uint16_t value_B        = 0x5678;
+   uint8_t response_di1_higher_sequence_number[SIZE_RESPONSE_2_SLAVES] = {};
+
+   clal_memcpy (
+      response_di1_higher_sequence_number,
+      sizeof (response_di1_higher_sequence_number),
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   response_di1_higher_sequence_number[57] = 0x02;
+
+   config.use_output_dirty_tracking = true;
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   clm_iefb_periodic (&clm, now);
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
+
+   /* Getting the pointer marks all stations in the group as changed */
+   clm.groups[gi].dirty_outputs = 0;
+   rww_area = clm_get_first_rww_area (&clm, gi, &total_occupied);
+   ASSERT_NE (rww_area, nullptr);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0007);
+   clm.groups[gi].dirty_outputs = 0;
+   EXPECT_NE (
+      clm_get_first_device_rww_area (&clm, gi, sdi, &total_occupied),
+      nullptr);
+   EXPECT_EQ (total_occupied, 2U);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0006);
+   clm.groups[gi].dirty_outputs = 0x0007;
+
+   /* Written with the convenience function. Automatically marked. */
+   clm_set_rww_value (&clm, gi, sdi0, registernumber, value_A);
+
+   /* Both slaves respond. Master sends next request. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di0,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_CYCLIC_SENDING);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0);
+   resulting_rww_area =
+      mock_analyze_cyclic_request_rww (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_rww_area, nullptr);
+   EXPECT_EQ (
+      CC_FROM_LE16 (resulting_rww_area->words[registernumber]),
+      value_A);
+
+   /* Written via a pointer fetched before the link scan, but not marked.
+      Old value is sent. */
+   rww_area->words[registernumber] = CC_TO_LE16 (value_B);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di0_next_sequence_number,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
+   resulting_rww_area =
+      mock_analyze_cyclic_request_rww (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_rww_area, nullptr);
+   EXPECT_EQ (
+      CC_FROM_LE16 (resulting_rww_area->words[registernumber]),
+      value_A);
+
+   /* Mark the area as changed. New value is sent in next request. */
+   EXPECT_EQ (clm_mark_outputs_dirty (&clm, gi, 0, 1), 0);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0x0001);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di0_next_next_sequence_number,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_higher_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
+   EXPECT_EQ (clm.groups[gi].dirty_outputs, 0);
+   resulting_rww_area =
+      mock_analyze_cyclic_request_rww (mock_cciefb_port, slaves_in_group, 1);
+   ASSERT_NE (resulting_rww_area, nullptr);
+   EXPECT_EQ (
+      CC_FROM_LE16 (resulting_rww_area->words[registernumber]),
+      value_B);
+
+   /* Invalid arguments */
+   total_occupied = clm.groups[gi].total_occupied;
+   EXPECT_EQ (clm_mark_outputs_dirty (&clm, gi, 0, total_occupied), 0);
+   EXPECT_EQ (clm_mark_outputs_dirty (&clm, gi, 1, total_occupied), -1);
+   EXPECT_EQ (clm_mark_outputs_dirty (&clm, gi, total_occupied + 1, 0), -1);
+   EXPECT_EQ (
+      clm_mark_outputs_dirty (&clm, config.hier.number_of_groups, 0, 1),
+      -1);
+   EXPECT_EQ (clm_mark_outputs_dirty (nullptr, gi, 0, 1), -1);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbFailsToReadParameterFile)
+{
+   uint16_t * p_file_parameter_no  = nullptr;
+   const uint32_t magic            = CC_FROM_BE32 (0x434C4E4B); /* "CLNK" */
+   const uint32_t version          = CC_FROM_BE32 (0x00000001);
+   const uint16_t new_parameter_no = 1;
+
+   /* Clear existing file (containing parameter number) */
+   storage_file->file_size = (size_t)0;
+   clal_clear_memory (
+      &storage_file->file_content,
+      sizeof (storage_file->file_content));
+
+   /* Start master */
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   EXPECT_EQ (clm.parameter_no, new_parameter_no);
+
+   /* Verify updated file */
+   EXPECT_EQ (storage_file->file_size, expected_filesize);
+   EXPECT_EQ (memcmp (storage_file->file_content, &magic, 4), 0);
+   EXPECT_EQ (memcmp (storage_file->file_content + 4, &version, 4), 0);
+   p_file_parameter_no = (uint16_t *)&storage_file->file_content + 4;
+   EXPECT_EQ (*p_file_parameter_no, new_parameter_no);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbNoLinkscanCallback)
+{
+   config.linkscan_cb = nullptr;
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+   ASSERT_EQ (mock_cciefb_port->number_of_calls_open, 1);
+   ASSERT_EQ (mock_cciefb_port->total_sent_bytes, (size_t)0);
+   ASSERT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
+   EXPECT_EQ (clm.parameter_no, parameter_no);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 2);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_ARBITRATION);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+
+   /* Run master stack, arbitration done */
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+
+   EXPECT_EQ (mock_cciefb_port->is_open, true);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 1);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
+   EXPECT_EQ (mock_cciefb_port->total_recv_bytes, (size_t)0);
+   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
+
+   /* Link scan times out */
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (mock_cciefb_port->is_open, true);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 2);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+   EXPECT_EQ (mock_cciefb_port->total_recv_bytes, (size_t)0);
+   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_REQUEST_3_SLAVES);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 3);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
+}
+
+TEST_F (MasterIntegrationTestNotInitialised, CciefbForceTransmissionBits)
+{
+   config.linkscan_cb = nullptr;
+
+   cl_mock_cyclic_request_result_t result;
+   clal_clear_memory (&result, sizeof (result));
+
+   ASSERT_EQ (clm_master_init (&clm, &config, now), 0);
+
+   ASSERT_EQ (mock_cciefb_port->number_of_calls_open, 1);
+   ASSERT_EQ (mock_cciefb_port->total_sent_bytes, (size_t)0);
+   ASSERT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_ARBITRATION);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_LISTEN);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_LISTEN);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 2);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_ARBITRATION);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+
+   clm_iefb_force_cyclic_transmission_bit (&clm, gi, sdi, true);
+
+   /* Run master stack, arbitration done */
+   now += longer_than_arbitration_us;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_state.calls, 3);
+   EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_alarm.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_node_search.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
+   ASSERT_EQ (mock_analyze_cyclic_request (mock_cciefb_port, &result), 0);
+   EXPECT_EQ (result.frame_sequence_no, frame_sequenceno_startup);
+   EXPECT_EQ (result.group_no, group_number);
+   EXPECT_EQ (result.cyclic_transmission_state, 0x0002); /* Slave 1 */
+
+   clm_iefb_force_cyclic_transmission_bit (&clm, gi, sdi, false);
+
+   /* Time out, so a new frame will be sent*/
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi0].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_WAIT_TD);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+   ASSERT_EQ (mock_analyze_cyclic_request (mock_cciefb_port, &result), 0);
+   EXPECT_EQ (result.frame_sequence_no, frame_sequenceno_startup + 1);
+   EXPECT_EQ (result.group_no, group_number);
+   EXPECT_EQ (
+      result.cyclic_transmission_state,
+      CL_CCIEFB_CYCLIC_REQ_DATA_HEADER_CYCLIC_TR_STATE_ALL_OFF);
+   EXPECT_EQ (
+      result.master_local_unit_info,
+      CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_RUNNING);
+   EXPECT_EQ (cb_counters->master_cb_connect.calls, 0);
+   EXPECT_EQ (cb_counters->master_cb_disconnect.calls, 0);
    EXPECT_EQ (cb_counters->master_cb_state.calls, 3);
    EXPECT_EQ (cb_counters->master_cb_state.state, CLM_MASTER_STATE_RUNNING);
    EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 0);
@@ -3087,7 +4108,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbArbitrationFails)
       CLM_DEVICE_STATE_LISTEN);
 
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 2);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, (size_t)0);
@@ -3378,7 +4399,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbConstantLinkTime)
       CLM_DEVICE_STATE_CYCLIC_SENT);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -3396,7 +4417,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbConstantLinkTime)
       CLM_DEVICE_STATE_CYCLIC_SENT);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -3415,7 +4436,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbConstantLinkTime)
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_REQUEST_3_SLAVES);
@@ -3637,20 +4658,20 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbMultipleMastersStartup)
 TEST_F (MasterIntegrationTestNoResponseYet, CciefbClearStatistics)
 {
    /* Clear statistics for one slave device */
-   clm.groups[gi].slave_devices[sdi0].statistics.number_of_connects   = 0x42;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_connects    = 0x43;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_disconnects = 0x44;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_timeouts    = 0x45;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_sent_frames = 0x46;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_frames = 0x47;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_invalid_frames =
+   clm.groups[gi].device_details[sdi0].statistics.number_of_connects   = 0x42;
+   clm.groups[gi].device_details[sdi].statistics.number_of_connects    = 0x43;
+   clm.groups[gi].device_details[sdi].statistics.number_of_disconnects = 0x44;
+   clm.groups[gi].device_details[sdi].statistics.number_of_timeouts    = 0x45;
+   clm.groups[gi].device_details[sdi].statistics.number_of_sent_frames = 0x46;
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_frames = 0x47;
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_invalid_frames =
       0x48;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_alarm_frames =
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_alarm_frames =
       0x49;
    EXPECT_EQ (statistics->number_of_connects, 0x43U);
-   clm_iefb_statistics_clear (&clm.groups[gi].slave_devices[sdi].statistics);
+   clm_iefb_statistics_clear (&clm.groups[gi].device_details[sdi].statistics);
    EXPECT_EQ (
-      clm.groups[gi].slave_devices[sdi0].statistics.number_of_connects,
+      clm.groups[gi].device_details[sdi0].statistics.number_of_connects,
       0x42U);
    EXPECT_EQ (statistics->number_of_connects, 0U);
    EXPECT_EQ (statistics->number_of_disconnects, 0U);
@@ -3661,17 +4682,17 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbClearStatistics)
    EXPECT_EQ (statistics->number_of_incoming_alarm_frames, 0U);
 
    /* Clear statistics for all slave devices */
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_connects    = 0x43;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_disconnects = 0x44;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_timeouts    = 0x45;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_sent_frames = 0x46;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_frames = 0x47;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_invalid_frames =
+   clm.groups[gi].device_details[sdi].statistics.number_of_connects    = 0x43;
+   clm.groups[gi].device_details[sdi].statistics.number_of_disconnects = 0x44;
+   clm.groups[gi].device_details[sdi].statistics.number_of_timeouts    = 0x45;
+   clm.groups[gi].device_details[sdi].statistics.number_of_sent_frames = 0x46;
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_frames = 0x47;
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_invalid_frames =
       0x48;
-   clm.groups[gi].slave_devices[sdi].statistics.number_of_incoming_alarm_frames =
+   clm.groups[gi].device_details[sdi].statistics.number_of_incoming_alarm_frames =
       0x49;
    clm_iefb_statistics_clear_all (&clm);
-   EXPECT_EQ (clm.groups[gi].slave_devices[sdi0].statistics.number_of_connects, 0U);
+   EXPECT_EQ (clm.groups[gi].device_details[sdi0].statistics.number_of_connects, 0U);
    EXPECT_EQ (statistics->number_of_connects, 0U);
    EXPECT_EQ (statistics->number_of_disconnects, 0U);
    EXPECT_EQ (statistics->number_of_timeouts, 0U);
@@ -3690,7 +4711,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbParseCyclicData)
 {
    uint16_t resulting_occupied = 0;
    clm_device_framevalues_t * framevalues =
-      &clm.groups[gi].slave_devices[sdi].latest_frame;
+      &clm.groups[gi].device_details[sdi].latest_frame;
    const cl_rx_t * first_group_rx_area;
    const cl_rwr_t * first_group_rwr_area;
    const cl_rx_t * first_device_rx_area;
@@ -3739,7 +4760,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbParseCyclicData)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -3766,7 +4787,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbParseCyclicData)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -3839,7 +4860,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbParseCyclicData)
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
 
    /* Clear statistics */
-   clm_iefb_statistics_clear (&clm.groups[gi].slave_devices[sdi].statistics);
+   clm_iefb_statistics_clear (&clm.groups[gi].device_details[sdi].statistics);
    EXPECT_EQ (statistics->number_of_connects, 0U);
    EXPECT_EQ (statistics->number_of_disconnects, 0U);
    EXPECT_EQ (statistics->number_of_incoming_frames, 0U);
@@ -4032,7 +5053,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbSlaveAlarmWrongNumberOccupied)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_2_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_REQUEST_3_SLAVES);
@@ -4063,7 +5084,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbSlaveAlarmWrongNumberOccupied)
    EXPECT_EQ (cb_counters->master_cb_set_ip.calls, 0);
 
    /* Application reads out diagnostic information */
-   EXPECT_EQ (clm_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
    EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_RUNNING);
    EXPECT_EQ (master_details.node_search_serial, -1);
    EXPECT_EQ (master_details.set_ip_request_serial, -1);
@@ -4141,7 +5162,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbSlaveAlarmWrongNumberOccupied)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -4199,7 +5220,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbSlaveAlarmWrongNumberOccupied)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -4236,7 +5257,7 @@ TEST_F (MasterIntegrationTestNoResponseYet, CciefbSlaveAlarmWrongNumberOccupied)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 11);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -4466,7 +5487,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbParseCyclicData)
 {
    uint16_t resulting_occupied = 0;
    clm_device_framevalues_t * framevalues =
-      &clm.groups[gi].slave_devices[sdi].latest_frame;
+      &clm.groups[gi].device_details[sdi].latest_frame;
    const cl_rx_t * first_group_rx_area;
    const cl_rwr_t * first_group_rwr_area;
    const cl_rx_t * first_device_rx_area;
@@ -4480,7 +5501,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbParseCyclicData)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -4517,7 +5538,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbParseCyclicData)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENT);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -4695,7 +5716,7 @@ TEST_F (
    ASSERT_TRUE (clm.groups[gi].slave_devices[sdi].transmission_bit);
    EXPECT_EQ (clm.parameter_no, parameter_no);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -5156,7 +6177,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterApplicationStoppe
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (clm.parameter_no, parameter_no);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -5563,7 +6584,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbNewConfig)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -5665,7 +6686,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbOneSlaveLost)
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (clm.parameter_no, parameter_no);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -6258,7 +7279,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_REQUEST_1_SLAVE);
@@ -6335,7 +7356,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
    EXPECT_EQ (
       clm.groups[gi].slave_devices[sdi0].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_REQUEST_1_SLAVE);
@@ -6398,7 +7419,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
    EXPECT_EQ (statistics->measured_time.sum, 2 * tick_size);
    EXPECT_EQ (statistics->measured_time.average, tick_size);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_REQUEST_1_SLAVE);
@@ -6439,7 +7460,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
    EXPECT_EQ (statistics->measured_time.sum, 2 * tick_size);
    EXPECT_EQ (statistics->measured_time.average, tick_size);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_REQUEST_1_SLAVE);
@@ -6498,7 +7519,7 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
    EXPECT_EQ (statistics->measured_time.sum, 2 * tick_size);
    EXPECT_EQ (statistics->measured_time.average, tick_size);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 13);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_RESPONSE_1_SLAVE);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_REQUEST_1_SLAVE);
@@ -6512,6 +7533,81 @@ TEST_F (MasterIntegrationTestNotInitialised, CciefbSlaveIdDuplicationSingleSlave
  * @req REQ_CLM_CONFORMANCE_14
  *
  */
+TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMissingResponses)
+{
+   clm_group_status_details_t group_details;
+   const uint16_t bit_di0 = 1U << sdi0;
+   const uint16_t bit_di1 = 1U << sdi;
+   uint8_t response_di1_higher_sequence_number[SIZE_RESPONSE_2_SLAVES] = {};
+
+   clal_memcpy (
+      response_di1_higher_sequence_number,
+      sizeof (response_di1_higher_sequence_number),
+      (uint8_t *)&response_payload_di1,
+      SIZE_RESPONSE_2_SLAVES);
+   response_di1_higher_sequence_number[57] = 0x02;
+
+   ASSERT_EQ (clm.groups[gi].group_state, CLM_GROUP_STATE_MASTER_LINK_SCAN);
+   ASSERT_EQ (cb_counters->master_cb_linkscan.calls, 1);
+   ASSERT_EQ (clm_get_group_status (&clm, gi, &group_details), 0);
+   EXPECT_EQ (group_details.awaiting_responses, bit_di0 | bit_di1);
+   EXPECT_EQ (group_details.missing_responses, 0);
+
+   /* Slave device index 1 responds */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+
+   ASSERT_EQ (clm_get_group_status (&clm, gi, &group_details), 0);
+   EXPECT_EQ (group_details.awaiting_responses, bit_di0);
+   EXPECT_EQ (group_details.missing_responses, 0);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 1);
+
+   /* Slave device index 0 does not respond. Timeout. */
+   now += longer_than_timeout_us;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 2);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.success, false);
+   ASSERT_EQ (clm_get_group_status (&clm, gi, &group_details), 0);
+   EXPECT_EQ (group_details.missing_responses, bit_di0);
+   EXPECT_EQ (group_details.awaiting_responses, bit_di0 | bit_di1);
+
+   /* Both respond in the next link scan */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di0_next_next_sequence_number,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+
+   ASSERT_EQ (clm_get_group_status (&clm, gi, &group_details), 0);
+   EXPECT_EQ (group_details.awaiting_responses, bit_di1);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 2);
+
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_higher_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+
+   EXPECT_EQ (cb_counters->master_cb_linkscan.calls, 3);
+   EXPECT_EQ (cb_counters->master_cb_linkscan.success, true);
+   ASSERT_EQ (clm_get_group_status (&clm, gi, &group_details), 0);
+   EXPECT_EQ (group_details.missing_responses, 0);
+   EXPECT_EQ (group_details.awaiting_responses, bit_di0 | bit_di1);
+}
+
 TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveStationDuplication)
 {
    cl_mock_cyclic_request_result_t result;
@@ -6544,7 +7640,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveStationDuplication
    ASSERT_TRUE (clm.groups[gi].slave_devices[sdi].transmission_bit);
    EXPECT_EQ (clm.parameter_no, parameter_no);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -6905,7 +8001,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbTooShortResponse)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -6923,7 +8019,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbTooShortResponse)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -6959,7 +8055,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbTooShortResponseValidHe
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -6977,7 +8073,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbTooShortResponseValidHe
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7012,7 +8108,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidHeader)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7030,7 +8126,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidHeader)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7060,7 +8156,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveDisabled)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7082,7 +8178,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveDisabled)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7127,7 +8223,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongSequenceNumber)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7148,7 +8244,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongSequenceNumber)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7176,7 +8272,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterIpInvalid)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7199,7 +8295,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterIpInvalid)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7237,7 +8333,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidProtocolVersion)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7258,7 +8354,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidProtocolVersion)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7302,7 +8398,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidGroup)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7325,7 +8421,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInvalidGroup)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7363,7 +8459,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongSlaveIp)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7384,7 +8480,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongSlaveIp)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7425,7 +8521,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbCustomSlaveInfo)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7462,7 +8558,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbCustomSlaveInfo)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7503,7 +8599,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbCustomSlaveInfo)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 11);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7533,7 +8629,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbCustomSlaveInfo)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 13);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7593,7 +8689,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveIndicatesError)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7625,7 +8721,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveIndicatesError)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7666,7 +8762,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveIndicatesError)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 11);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7700,7 +8796,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveIndicatesError)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 13);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7752,7 +8848,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveWantsToDisconnect)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7784,7 +8880,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveWantsToDisconnect)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7827,7 +8923,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveWantsToDisconnect)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 11);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -7861,7 +8957,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSlaveWantsToDisconnect)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 13);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8030,7 +9126,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSameIpAddressAsMaster)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8051,7 +9147,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbSameIpAddressAsMaster)
    clm_iefb_periodic (&clm, now);
 
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8086,7 +9182,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterTimesOut)
    ASSERT_EQ (clm.groups[gi].slave_devices[sdi0].timeout_count, 0);
    ASSERT_EQ (clm.groups[gi].slave_devices[sdi].timeout_count, 0);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8129,7 +9225,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterTimesOut)
    EXPECT_EQ (clm.groups[gi].slave_devices[sdi0].timeout_count, 0);
    EXPECT_EQ (clm.groups[gi].slave_devices[sdi].timeout_count, 0);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 5);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8183,7 +9279,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterTimesOutOnce)
    ASSERT_EQ (clm.groups[gi].slave_devices[sdi0].timeout_count, 0);
    ASSERT_EQ (clm.groups[gi].slave_devices[sdi].timeout_count, 0);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8230,7 +9326,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterTimesOutOnce)
    /* Check that timeout count has been reset for slave device index 0 */
    EXPECT_EQ (clm.groups[gi].slave_devices[sdi0].timeout_count, 0);
    EXPECT_EQ (clm.groups[gi].slave_devices[sdi].timeout_count, 1);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8332,6 +9428,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterDuplicationAlarm)
    clm_master_status_details_t master_details;
    clm_group_status_details_t group_details;
    const clm_slave_device_data_t * resulting_devicedata;
+   clm_slave_device_data_t device_snapshot;
 
    /* Prepare response with "Master duplication" end code */
    clal_memcpy (
@@ -8350,7 +9447,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterDuplicationAlarm)
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8388,7 +9485,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterDuplicationAlarm)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8459,7 +9556,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterDuplicationAlarm)
    EXPECT_EQ (cb_counters->master_cb_error.calls, 1);
 
    /* Application reads out diagnostic information */
-   EXPECT_EQ (clm_get_master_status (&clm, &master_details), 0);
+   EXPECT_EQ (clm_iefb_get_master_status (&clm, &master_details), 0);
    EXPECT_EQ (master_details.master_state, CLM_MASTER_STATE_STANDBY);
    EXPECT_EQ (master_details.node_search_serial, -1);
    EXPECT_EQ (master_details.set_ip_request_serial, -1);
@@ -8481,6 +9578,14 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbMasterDuplicationAlarm)
    EXPECT_TRUE (resulting_devicedata->transmission_bit);
    EXPECT_EQ (resulting_devicedata->slave_station_no, 2);
    EXPECT_EQ (resulting_devicedata->timeout_count, 0);
+   EXPECT_EQ (
+      clm_get_device_connection_snapshot (&clm, gi, sdi, &device_snapshot),
+      0);
+   EXPECT_EQ (device_snapshot.device_state, resulting_devicedata->device_state);
+   EXPECT_TRUE (device_snapshot.transmission_bit);
+   EXPECT_EQ (
+      device_snapshot.statistics.number_of_incoming_frames,
+      resulting_devicedata->statistics.number_of_incoming_frames);
    EXPECT_EQ (
       resulting_devicedata->statistics.number_of_incoming_invalid_frames,
       0U);
@@ -8545,7 +9650,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongNumberOfOccupied)
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_TRUE (clm.groups[gi].slave_devices[sdi].transmission_bit);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8570,7 +9675,7 @@ TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbWrongNumberOfOccupied)
    now += tick_size;
    clm_iefb_periodic (&clm, now);
    EXPECT_EQ (cb_counters->master_cb_error.calls, 0);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8619,7 +9724,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8695,7 +9800,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8721,7 +9826,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8752,7 +9857,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8778,7 +9883,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8801,7 +9906,7 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
@@ -8827,10 +9932,224 @@ TEST_F (
       clm.groups[gi].slave_devices[sdi].device_state,
       CLM_DEVICE_STATE_CYCLIC_SENDING);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (
       mock_cciefb_port->total_recv_bytes,
       SIZE_RESPONSE_1_SLAVE + SIZE_RESPONSE_2_SLAVES + size_short_request);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_REQUEST_3_SLAVES);
 }
+
+TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInputSnapshot)
+{
+   clm_input_snapshot_t snapshot = {};
+   const uint16_t first_word     = 0x0100; /* Little endian in frame */
+   uint32_t sequence             = 0;
+
+   /* Slave (device index 1) responds with cyclic data */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   ASSERT_EQ (clm_get_rwr_value (&clm, gi, sdi, 0), first_word);
+
+   /* Whole group */
+   EXPECT_EQ (clm_get_group_input_snapshot (&clm, gi, &snapshot), 0);
+   EXPECT_EQ (snapshot.num_occupied_stations, slaves_in_group);
+   EXPECT_EQ (snapshot.frame_sequence_no, frame_sequenceno_startup + 1);
+   EXPECT_EQ (
+      snapshot.timestamp_link_scan_start,
+      clm.groups[gi].timestamp_link_scan_start);
+   EXPECT_EQ (CC_FROM_LE16 (snapshot.rwr[0].words[0]), 0);
+   EXPECT_EQ (CC_FROM_LE16 (snapshot.rwr[1].words[0]), first_word);
+   EXPECT_EQ (snapshot.rx[1].bytes[0], 0x80);
+   EXPECT_EQ (snapshot.rx[2].bytes[7], 0x8F);
+
+   /* One slave device */
+   snapshot = {};
+   EXPECT_EQ (clm_get_device_input_snapshot (&clm, gi, sdi, &snapshot), 0);
+   EXPECT_EQ (snapshot.num_occupied_stations, 2);
+   EXPECT_EQ (snapshot.frame_sequence_no, frame_sequenceno_startup + 1);
+   EXPECT_EQ (CC_FROM_LE16 (snapshot.rwr[0].words[0]), first_word);
+   EXPECT_EQ (snapshot.rx[0].bytes[0], 0x80);
+   EXPECT_EQ (snapshot.rx[1].bytes[0], 0x88);
+
+   /* The stack is updating the incoming data */
+   sequence                      = clm.groups[gi].input_sequence;
+   clm.groups[gi].input_sequence = sequence + 1;
+   EXPECT_EQ (clm_get_group_input_snapshot (&clm, gi, &snapshot), -1);
+   EXPECT_EQ (clm_get_device_input_snapshot (&clm, gi, sdi, &snapshot), -1);
+   clm.groups[gi].input_sequence = sequence + 2;
+   EXPECT_EQ (clm_get_device_input_snapshot (&clm, gi, sdi, &snapshot), 0);
+
+   /* Invalid arguments */
+   EXPECT_EQ (
+      clm_get_group_input_snapshot (&clm, CLM_MAX_GROUPS, &snapshot),
+      -1);
+   EXPECT_EQ (clm_get_group_input_snapshot (nullptr, gi, &snapshot), -1);
+   EXPECT_EQ (clm_get_group_input_snapshot (&clm, gi, nullptr), -1);
+   EXPECT_EQ (clm_get_device_input_snapshot (&clm, gi, 1000, &snapshot), -1);
+   EXPECT_EQ (clm_get_device_input_snapshot (nullptr, gi, sdi, &snapshot), -1);
+}
+
+TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbBulkAccessors)
+{
+   const uint16_t num_bits  = 2 * CL_BITSIGNALS_PER_AREA;
+   const uint16_t num_words = 2 * CL_WORDSIGNALS_PER_AREA;
+   bool bits[2 * CL_BITSIGNALS_PER_AREA]       = {};
+   uint16_t words[2 * CL_WORDSIGNALS_PER_AREA] = {};
+   uint16_t i;
+
+   /* Slave (device index 1) responds with cyclic data */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+
+   /* Read RX and RWr */
+   EXPECT_EQ (clm_get_rx_bits (&clm, gi, sdi, 0, num_bits, bits), 0);
+   for (i = 0; i < num_bits; i++)
+   {
+      EXPECT_EQ (bits[i], clm_get_rx_bit (&clm, gi, sdi, i)) << "RX" << i;
+   }
+   EXPECT_TRUE (bits[7]);
+   EXPECT_TRUE (bits[67]);
+   EXPECT_TRUE (bits[71]);
+   EXPECT_EQ (clm_get_rx_bits (&clm, gi, sdi, 67, 2, bits), 0);
+   EXPECT_TRUE (bits[0]);
+   EXPECT_FALSE (bits[1]);
+
+   EXPECT_EQ (clm_get_rwr_values (&clm, gi, sdi, 0, num_words, words), 0);
+   for (i = 0; i < num_words; i++)
+   {
+      EXPECT_EQ (words[i], clm_get_rwr_value (&clm, gi, sdi, i)) << "RWr" << i;
+   }
+   EXPECT_EQ (words[0], 0x0100);
+
+   /* Write RY and RWw, spanning both stations of the device */
+   for (i = 0; i < num_bits; i++)
+   {
+      bits[i] = (i % 5) == 0;
+   }
+   EXPECT_EQ (clm_set_ry_bits (&clm, gi, sdi, 3, num_bits - 3, bits), 0);
+   EXPECT_FALSE (clm_get_ry_bit (&clm, gi, sdi, 0));
+   for (i = 3; i < num_bits; i++)
+   {
+      EXPECT_EQ (clm_get_ry_bit (&clm, gi, sdi, i), bits[i - 3]) << "RY" << i;
+   }
+
+   for (i = 0; i < num_words; i++)
+   {
+      words[i] = (uint16_t)(0x1000 + i);
+   }
+   EXPECT_EQ (clm_set_rww_values (&clm, gi, sdi, 1, num_words - 1, words), 0);
+   EXPECT_EQ (clm_get_rww_value (&clm, gi, sdi, 0), 0);
+   for (i = 1; i < num_words; i++)
+   {
+      EXPECT_EQ (clm_get_rww_value (&clm, gi, sdi, i), words[i - 1])
+         << "RWw" << i;
+   }
+
+   /* Invalid arguments */
+   EXPECT_EQ (clm_get_rx_bits (&clm, gi, sdi, 1, num_bits, bits), -1);
+   EXPECT_EQ (clm_set_ry_bits (&clm, gi, sdi, num_bits, 1, bits), -1);
+   EXPECT_EQ (clm_get_rwr_values (&clm, gi, sdi, 0, num_words + 1, words), -1);
+   EXPECT_EQ (clm_set_rww_values (&clm, gi, sdi, 1, num_words, words), -1);
+   EXPECT_EQ (clm_get_rx_bits (&clm, gi, 1000, 0, 1, bits), -1);
+   EXPECT_EQ (clm_set_ry_bits (&clm, CLM_MAX_GROUPS, sdi, 0, 1, bits), -1);
+   EXPECT_EQ (clm_get_rwr_values (nullptr, gi, sdi, 0, 1, words), -1);
+   EXPECT_EQ (clm_set_rww_values (&clm, gi, sdi, 0, 1, nullptr), -1);
+}
+
+TEST_F (MasterIntegrationTestBothDevicesResponded, CciefbInputsChanged)
+{
+   cl_changed_signals_t changed = {};
+   uint8_t response_di1_same_data[SIZE_RESPONSE_2_SLAVES] = {};
+
+   /* No data stored yet, as the devices were not connected */
+   EXPECT_EQ (cb_counters->master_cb_inputs_changed.calls, 0);
+
+   /* Slave (device index 1) responds with cyclic data */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (cb_counters->master_cb_inputs_changed.calls, 1);
+   EXPECT_EQ (cb_counters->master_cb_inputs_changed.group_index, gi);
+   EXPECT_EQ (cb_counters->master_cb_inputs_changed.slave_device_index, sdi);
+   EXPECT_EQ (
+      cb_counters->master_cb_inputs_changed.changed.num_occupied_stations,
+      2);
+   EXPECT_EQ (
+      cb_counters->master_cb_inputs_changed.changed.words[0],
+      0xFFFFFFFFU);
+   EXPECT_EQ (
+      cb_counters->master_cb_inputs_changed.changed.bits[1],
+      0x8F8E8D8C8B8A8988U);
+
+   /* Accumulated changes are cleared when read */
+   EXPECT_EQ (clm_get_changed_inputs (&clm, gi, sdi, &changed), 0);
+   EXPECT_EQ (changed.num_occupied_stations, 2);
+   EXPECT_EQ (changed.words[1], 0xFFFFFFFFU);
+   EXPECT_EQ (changed.bits[0], 0x8786858483828180U);
+   EXPECT_EQ (clm_get_changed_inputs (&clm, gi, sdi, &changed), 0);
+   EXPECT_EQ (changed.words[0], 0U);
+   EXPECT_EQ (changed.words[1], 0U);
+   EXPECT_EQ (changed.bits[0], 0U);
+   EXPECT_EQ (changed.bits[1], 0U);
+
+   /* Slave (device index 0) responds. Next link scan starts. */
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip_di0,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di0_next_sequence_number,
+      SIZE_RESPONSE_1_SLAVE);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_EQ (clm.groups[gi].frame_sequence_no, frame_sequenceno_startup + 2);
+
+   /* Slave (device index 1) responds with the same data */
+   clal_memcpy (
+      response_di1_same_data,
+      sizeof (response_di1_same_data),
+      (uint8_t *)&response_di1_next_sequence_number,
+      SIZE_RESPONSE_2_SLAVES);
+   response_di1_same_data[57] = frame_sequenceno_startup + 2;
+   cb_counters->master_cb_inputs_changed.calls = 0;
+   mock_set_udp_fakedata (
+      mock_cciefb_port,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&response_di1_same_data,
+      SIZE_RESPONSE_2_SLAVES);
+   now += tick_size;
+   clm_iefb_periodic (&clm, now);
+   EXPECT_TRUE (
+      clm.groups[gi].device_details[sdi].latest_frame.has_been_received);
+   EXPECT_EQ (
+      clm.groups[gi].slave_devices[sdi].device_state,
+      CLM_DEVICE_STATE_CYCLIC_SENT);
+   EXPECT_EQ (cb_counters->master_cb_inputs_changed.calls, 0);
+   EXPECT_EQ (clm_get_changed_inputs (&clm, gi, sdi, &changed), 0);
+   EXPECT_EQ (changed.words[0], 0U);
+   EXPECT_EQ (changed.bits[0], 0U);
+
+   /* Invalid arguments */
+   EXPECT_EQ (clm_get_changed_inputs (&clm, gi, 1000, &changed), -1);
+   EXPECT_EQ (clm_get_changed_inputs (&clm, 1000, sdi, &changed), -1);
+   EXPECT_EQ (clm_get_changed_inputs (nullptr, gi, sdi, &changed), -1);
+   EXPECT_EQ (clm_get_changed_inputs (&clm, gi, sdi, nullptr), -1);
+}
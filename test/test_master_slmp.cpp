@@ -512,6 +512,34 @@ TEST_F (MasterIntegrationTestNotConnected, SlmpNodeSearchNoCallback)
    EXPECT_EQ (db->stored, 1);
 }
 
+TEST_F (MasterIntegrationTestNotConnected, SlmpNodeSearchResponseOnSendSocket)
+{
+   const clm_node_search_db_t * db;
+
+   EXPECT_EQ (clm_slmp_perform_node_search (&clm, now), 0);
+   now += tick_size;
+   clm_slmp_periodic (&clm, now);
+   EXPECT_EQ (mock_slmp_send_port->port_number, CL_SLMP_PORT);
+
+   /* Slave response is delivered to the more specific send socket */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_slmp_send_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_SLMP_PORT,
+      (uint8_t *)&response_node_search,
+      SIZE_RESPONSE_NODE_SEARCH);
+   now += tick_size;
+   clm.node_search_serial = pending_slmp_serial;
+   clm_slmp_periodic (&clm, now);
+
+   EXPECT_EQ (mock_slmp_send_port->input_data_size, 0U);
+   db = clm_slmp_get_node_search_result (&clm);
+   EXPECT_EQ (db->count, 1);
+   EXPECT_EQ (db->stored, 1);
+}
+
 TEST_F (MasterIntegrationTestNotConnected, SlmpNodeSearchSingleSocket)
 {
    const clm_node_search_db_t * db;
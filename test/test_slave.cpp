@@ -50,8 +50,12 @@ TEST_F (InitExitUnitTest, ValidateSlaveConfiguration)
       .master_running_cb           = nullptr,
       .node_search_cb              = nullptr,
       .set_ip_cb                   = nullptr,
+      .inputs_changed_cb           = nullptr,
+      .command_cfm_cb              = nullptr,
       .iefb_ip_addr                = CL_IPADDR_ANY,
-      .use_slmp_directed_broadcast = false};
+      .use_slmp_directed_broadcast = false,
+      .use_separate_slmp_thread    = false,
+      .cciefb_socket_profile       = {}};
 
    EXPECT_EQ (cls_validate_config (&config), 0);
 
@@ -80,6 +84,18 @@ TEST_F (InitExitUnitTest, ValidateSlaveConfiguration)
    EXPECT_EQ (cls_validate_config (&config), 0);
    config.iefb_ip_addr = 0x01020304;
    EXPECT_EQ (cls_validate_config (&config), 0);
+
+   /* Socket profile */
+   config.cciefb_socket_profile.priority = CL_SOCKET_PRIORITY_MAX;
+   config.cciefb_socket_profile.dscp     = CL_SOCKET_DSCP_MAX;
+   EXPECT_EQ (cls_validate_config (&config), 0);
+   config.cciefb_socket_profile.priority = CL_SOCKET_PRIORITY_MAX + 1;
+   EXPECT_EQ (cls_validate_config (&config), -1);
+   config.cciefb_socket_profile.priority = 0;
+   config.cciefb_socket_profile.dscp     = CL_SOCKET_DSCP_MAX + 1;
+   EXPECT_EQ (cls_validate_config (&config), -1);
+   config.cciefb_socket_profile.dscp = 0;
+   EXPECT_EQ (cls_validate_config (&config), 0);
 }
 
 TEST_F (InitExitUnitTest, SlaveConfigShow)
@@ -98,8 +114,12 @@ TEST_F (InitExitUnitTest, SlaveConfigShow)
       .master_running_cb           = nullptr,
       .node_search_cb              = nullptr,
       .set_ip_cb                   = nullptr,
+      .inputs_changed_cb           = nullptr,
+      .command_cfm_cb              = nullptr,
       .iefb_ip_addr                = CL_IPADDR_ANY,
-      .use_slmp_directed_broadcast = false};
+      .use_slmp_directed_broadcast = false,
+      .use_separate_slmp_thread    = false,
+      .cciefb_socket_profile       = {}};
 
    cls_slave_config_show (&config);
 
@@ -123,8 +143,12 @@ TEST_F (InitExitUnitTest, SlaveInternalsShow)
       .master_running_cb           = nullptr,
       .node_search_cb              = nullptr,
       .set_ip_cb                   = nullptr,
+      .inputs_changed_cb           = nullptr,
+      .command_cfm_cb              = nullptr,
       .iefb_ip_addr                = CL_IPADDR_ANY,
-      .use_slmp_directed_broadcast = false};
+      .use_slmp_directed_broadcast = false,
+      .use_separate_slmp_thread    = false,
+      .cciefb_socket_profile       = {}};
 
    ASSERT_EQ (cls_slave_init (&cls, &config, 0), 0);
 
@@ -160,8 +184,12 @@ TEST_F (InitExitUnitTest, SlaveInitExit)
       .master_running_cb           = nullptr,
       .node_search_cb              = nullptr,
       .set_ip_cb                   = nullptr,
+      .inputs_changed_cb           = nullptr,
+      .command_cfm_cb              = nullptr,
       .iefb_ip_addr                = CL_IPADDR_ANY,
-      .use_slmp_directed_broadcast = true};
+      .use_slmp_directed_broadcast = true,
+      .use_separate_slmp_thread    = false,
+      .cciefb_socket_profile       = {}};
    const cls_cfg_t default_config = config;
 
    /* Valid configuration */
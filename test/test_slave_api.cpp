@@ -228,6 +228,8 @@ TEST_F (SlaveApiUnitTest, ClsIsNull)
 
    ASSERT_EQ (cls_init_only (nullptr, &config), -1);
    ASSERT_EQ (cls_exit (nullptr), -1);
+   ASSERT_EQ (cls_handle_slmp_periodic (nullptr), -1);
+   ASSERT_EQ (cls_submit_command (nullptr, nullptr), -1);
 
    ASSERT_TRUE (cls_get_first_ry_area (nullptr) == nullptr);
    ASSERT_TRUE (cls_get_first_rx_area (nullptr) == nullptr);
@@ -238,3 +240,132 @@ TEST_F (SlaveApiUnitTest, ClsIsNull)
 
    ASSERT_EQ (cls_get_master_timestamp (nullptr, &timestamp), -1);
 }
+
+TEST_F (SlaveApiUnitTest, ClsGetNextDeadline)
+{
+   cls_cfg_t config          = {};
+   cls_t * cls               = nullptr;
+   uint32_t time_to_deadline = 0;
+
+   config.num_occupied_stations = 1;
+
+   EXPECT_EQ (cls_get_next_deadline_us (nullptr, &time_to_deadline), -1);
+
+   cls = cls_init (&config);
+   ASSERT_TRUE (cls != nullptr);
+   cls_handle_periodic (cls);
+   EXPECT_EQ (cls_get_next_deadline_us (cls, nullptr), -1);
+
+   /* No master connected, no timer running */
+   EXPECT_EQ (cls_get_next_deadline_us (cls, &time_to_deadline), -1);
+
+   /* Earliest of the running timers */
+   cl_timer_start (&cls->receive_timer, 3000, mock_data.timestamp_us);
+   cl_timer_start (
+      &cls->node_search.response_timer,
+      2000,
+      mock_data.timestamp_us);
+   EXPECT_EQ (cls_get_next_deadline_us (cls, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 2000U);
+
+   mock_data.timestamp_us += 500;
+   EXPECT_EQ (cls_get_next_deadline_us (cls, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 1500U);
+
+   cl_timer_stop (&cls->node_search.response_timer);
+   EXPECT_EQ (cls_get_next_deadline_us (cls, &time_to_deadline), 0);
+   EXPECT_EQ (time_to_deadline, 2500U);
+
+   EXPECT_EQ (cls_exit (cls), 0);
+   free (cls);
+}
+
+TEST_F (SlaveApiUnitTest, ClsGetSockets)
+{
+   cls_cfg_t config                         = {};
+   cls_t * cls                              = nullptr;
+   cl_socket_info_t sockets[CL_MAX_SOCKETS] = {};
+   uint16_t number_of_sockets               = 0;
+
+   config.num_occupied_stations = 1;
+
+   EXPECT_EQ (
+      cls_get_sockets (nullptr, sockets, CL_MAX_SOCKETS, &number_of_sockets),
+      -1);
+
+   cls = cls_init (&config);
+   ASSERT_TRUE (cls != nullptr);
+   EXPECT_EQ (
+      cls_get_sockets (cls, nullptr, CL_MAX_SOCKETS, &number_of_sockets),
+      -1);
+   EXPECT_EQ (cls_get_sockets (cls, sockets, CL_MAX_SOCKETS, nullptr), -1);
+   EXPECT_EQ (
+      cls_get_sockets (cls, sockets, CL_MAX_SOCKETS, &number_of_sockets),
+      0);
+   EXPECT_EQ (number_of_sockets, 2);
+   EXPECT_EQ (sockets[0].handle, cls->cciefb_socket);
+   EXPECT_EQ (sockets[0].role, CL_SOCKET_ROLE_CCIEFB);
+   EXPECT_EQ (sockets[1].handle, cls->slmp_receive_socket);
+   EXPECT_EQ (sockets[1].role, CL_SOCKET_ROLE_SLMP);
+
+   /* Too small list */
+   number_of_sockets = 0;
+   EXPECT_EQ (cls_get_sockets (cls, sockets, 1, &number_of_sockets), -1);
+   EXPECT_EQ (number_of_sockets, 0);
+
+   /* Readable handlers do not start any timers */
+   cls_handle_cciefb_readable (cls);
+   cls_handle_slmp_readable (cls);
+   EXPECT_EQ (cls->state, CLS_SLAVE_STATE_MASTER_NONE);
+   EXPECT_FALSE (cl_timer_is_running (&cls->receive_timer));
+
+   EXPECT_EQ (cls_exit (cls), 0);
+   free (cls);
+}
+
+TEST_F (SlaveIntegrationTestNotConnected, ApiSubmitCommand)
+{
+   cls_command_t command;
+   int i;
+   clal_clear_memory (&command, sizeof (command));
+
+   EXPECT_EQ (cls_submit_command (&cls, nullptr), -1);
+
+   /* Commands are executed at the start of the periodic call */
+   command.type           = CLS_COMMAND_SET_SLAVE_ERROR_CODE;
+   command.tag            = 5;
+   command.slave_err_code = 0x1234;
+   EXPECT_EQ (cls_submit_command (&cls, &command), 0);
+   command.type                  = CLS_COMMAND_SET_LOCAL_MANAGEMENT_INFO;
+   command.tag                   = 6;
+   command.local_management_info = 0x56789ABC;
+   EXPECT_EQ (cls_submit_command (&cls, &command), 0);
+   command.type                     = CLS_COMMAND_SET_SLAVE_APPLICATION_STATUS;
+   command.tag                      = 7;
+   command.slave_application_status = CL_SLAVE_APPL_OPERATION_STATUS_STOPPED;
+   EXPECT_EQ (cls_submit_command (&cls, &command), 0);
+   EXPECT_EQ (cls_get_slave_error_code (&cls), 0);
+   EXPECT_EQ (mock_data.slave_cb_command.calls, 0);
+
+   cls_handle_periodic (&cls);
+   EXPECT_EQ (cls_get_slave_error_code (&cls), 0x1234);
+   EXPECT_EQ (cls_get_local_management_info (&cls), 0x56789ABCU);
+   EXPECT_EQ (
+      cls_get_slave_application_status (&cls),
+      CL_SLAVE_APPL_OPERATION_STATUS_STOPPED);
+   EXPECT_EQ (mock_data.slave_cb_command.calls, 3);
+   EXPECT_EQ (
+      mock_data.slave_cb_command.type,
+      CLS_COMMAND_SET_SLAVE_APPLICATION_STATUS);
+   EXPECT_EQ (mock_data.slave_cb_command.tag, 7U);
+   EXPECT_EQ (mock_data.slave_cb_command.result, 0);
+
+   /* Fill the command queue */
+   for (i = 0; i < CL_COMMAND_QUEUE_SIZE; i++)
+   {
+      EXPECT_EQ (cls_submit_command (&cls, &command), 0);
+   }
+   EXPECT_EQ (cls_submit_command (&cls, &command), -1);
+   cls_handle_periodic (&cls);
+   EXPECT_EQ (mock_data.slave_cb_command.calls, 3 + CL_COMMAND_QUEUE_SIZE);
+}
@@ -562,6 +562,7 @@ TEST_F (SlaveUnitTest, CliefCopyCyclicDataFromRequest)
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
 
@@ -1166,6 +1167,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbStatemachineInStateMasterNone)
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
 
@@ -1230,6 +1232,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbStatemachineInStateMasterControl)
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
 
@@ -1322,6 +1325,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbStatemachineInStateWaitDisabling
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
 
@@ -1394,6 +1398,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbStatemachineInStateSlaveDisabled
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
 
@@ -1533,7 +1538,7 @@ TEST_F (SlaveUnitTest, CciefbStartup)
    ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 2);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_data.slave_cb_state.calls, 2);
    EXPECT_EQ (mock_data.slave_cb_state.state, CLS_SLAVE_STATE_MASTER_CONTROL);
@@ -1615,7 +1620,7 @@ TEST_F (SlaveUnitTest, CciefbStartup)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -1711,7 +1716,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectAndCyclic)
    ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_data.slave_cb_state.calls, 2);
    EXPECT_EQ (mock_data.slave_cb_state.state, CLS_SLAVE_STATE_MASTER_CONTROL);
@@ -1783,7 +1788,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectAndCyclic)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -1854,7 +1859,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbNoConnectCallback)
    ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_RESPONSE_2_SLAVES);
@@ -1973,7 +1978,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbNoMasterTimestamp)
    ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_data.slave_cb_state.calls, 2);
    EXPECT_EQ (mock_data.slave_cb_state.state, CLS_SLAVE_STATE_MASTER_CONTROL);
@@ -2035,7 +2040,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbNoMasterTimestamp)
    EXPECT_EQ (mock_data.slave_cb_master_running.calls, 2);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -2089,7 +2094,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbNoMasterTimestamp)
    EXPECT_EQ (mock_data.slave_cb_master_running.calls, 2);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -2174,7 +2179,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectWrongSlaveID)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2231,7 +2236,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectWrongGroup)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2285,7 +2290,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectWrongCommand)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2339,7 +2344,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectWrongSubcommand)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2394,7 +2399,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectInvalidHeader)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2449,7 +2454,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectInvalidCyclicHeader)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2493,7 +2498,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbConnectTooShortFrame)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4U);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2546,7 +2551,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbSlaveDuplication)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2576,7 +2581,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbSlaveDuplication)
    now += tick_size;
    cls_iefb_periodic (&cls, now);
 
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2626,7 +2631,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbNoErrorCallback)
 
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 0);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 0U);
@@ -2699,7 +2704,7 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbRunningWrongNumberOccupied)
    EXPECT_EQ (mock_data.slave_cb_master_running.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 1);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, SIZE_RESPONSE_2_SLAVES);
@@ -2735,8 +2740,248 @@ TEST_F (SlaveIntegrationTestNotConnected, CciefbRunningWrongNumberOccupied)
    EXPECT_EQ (cyclic_response_result.frame_sequence_no, frame_sequence_no);
 }
 
+TEST_F (SlaveUnitTest, CciefbSocketProfile)
+{
+   /* Largest request frame is 67 + 16 * 76 bytes */
+   const uint32_t burst_size =
+      CLS_CCIEFB_MAX_FRAMES_PER_TICK *
+      (1283 + CL_SOCKET_RECEIVE_OVERHEAD_PER_FRAME);
+
+   config.cciefb_socket_profile.busy_poll_us             = 50;
+   config.cciefb_socket_profile.receive_buffer_for_burst = true;
+   config.cciefb_socket_profile.priority                 = 5;
+   config.cciefb_socket_profile.dscp                     = 46;
+   config.cciefb_socket_profile.enable_error_queue       = true;
+   EXPECT_EQ (cls_iefb_calc_receive_buffer_size (), burst_size);
+
+   ASSERT_EQ (cls_slave_init (&cls, &config, now), 0);
+   ASSERT_EQ (&mock_data.udp_ports[0], mock_cciefb_port);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_set_profile, 1);
+   EXPECT_EQ (mock_cciefb_port->profile.busy_poll_us, 50U);
+   EXPECT_EQ (mock_cciefb_port->profile.receive_buffer_size, burst_size);
+   EXPECT_EQ (mock_cciefb_port->profile.priority, 5);
+   EXPECT_EQ (mock_cciefb_port->profile.dscp, 46);
+   EXPECT_TRUE (mock_cciefb_port->profile.enable_error_queue);
+   EXPECT_EQ (cls.cciefb_socket_profile.receive_buffer_size, burst_size);
+   EXPECT_TRUE (cls.cciefb_socket_profile.receive_buffer_for_burst);
+   EXPECT_EQ (mock_slmp_port->number_of_calls_set_profile, 0);
+   EXPECT_EQ (cls_slave_exit (&cls), 0);
+
+   /* Failing to apply the profile is not fatal */
+   mock_data.will_fail_set_socket_profile = true;
+   ASSERT_EQ (cls_slave_init (&cls, &config, now), 0);
+   EXPECT_EQ (cls.cciefb_socket_profile.busy_poll_us, 0U);
+   EXPECT_EQ (cls.cciefb_socket_profile.receive_buffer_size, 0U);
+}
+
 /************** Integration tests with master connected ********************/
 
+TEST_F (SlaveIntegrationTestConnected, CciefbFrameBudgetPerTick)
+{
+   const cls_cciefb_receive_statistics_t * statistics = nullptr;
+   const uint16_t budget = CLS_CCIEFB_MAX_FRAMES_PER_TICK;
+
+   ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   statistics = cls_get_cciefb_receive_statistics (&cls);
+   ASSERT_TRUE (statistics != nullptr);
+   EXPECT_EQ (statistics->processed_latest, 1);
+   EXPECT_EQ (statistics->processed_max, 1);
+   EXPECT_EQ (statistics->processed_total, 2U);
+   EXPECT_EQ (statistics->deferred_ticks, 0U);
+
+   /* No incoming frames */
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (statistics->processed_latest, 0);
+   EXPECT_EQ (statistics->processed_max, 1);
+   EXPECT_EQ (statistics->processed_total, 2U);
+   EXPECT_EQ (statistics->deferred_ticks, 0U);
+
+   /* More frames waiting than the budget allows */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&request_payload_running,
+      SIZE_REQUEST_3_SLAVES);
+   mock_cciefb_port->input_repeat_count   = budget + 1;
+   mock_cciefb_port->number_of_calls_recv = 0;
+   mock_cciefb_port->number_of_calls_send = 0;
+
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, budget);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, budget);
+   EXPECT_EQ (statistics->processed_latest, budget);
+   EXPECT_EQ (statistics->processed_max, budget);
+   EXPECT_EQ (statistics->processed_total, 2U + budget);
+   EXPECT_EQ (statistics->deferred_ticks, 1U);
+
+   /* The remaining two frames are handled in the next tick */
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, budget + 3);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, budget + 2);
+   EXPECT_EQ (statistics->processed_latest, 2);
+   EXPECT_EQ (statistics->processed_max, budget);
+   EXPECT_EQ (statistics->processed_total, 4U + budget);
+   EXPECT_EQ (statistics->deferred_ticks, 1U);
+
+   cls_clear_cciefb_receive_statistics (&cls);
+   EXPECT_EQ (statistics->processed_latest, 0);
+   EXPECT_EQ (statistics->processed_max, 0);
+   EXPECT_EQ (statistics->processed_total, 0U);
+   EXPECT_EQ (statistics->deferred_ticks, 0U);
+
+   EXPECT_TRUE (cls_get_cciefb_receive_statistics (nullptr) == nullptr);
+}
+
+TEST_F (SlaveIntegrationTestConnected, CciefbIcmpErrors)
+{
+   const cls_cciefb_receive_statistics_t * statistics = nullptr;
+   clal_udp_error_queue_entry_t * entry = &mock_cciefb_port->error_queue[0];
+
+   ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   statistics = cls_get_cciefb_receive_statistics (&cls);
+   ASSERT_TRUE (statistics != nullptr);
+   EXPECT_EQ (statistics->icmp_errors, 0U);
+
+   /* Port unreachable from the master */
+   entry->type                         = CLAL_UDP_ERROR_QUEUE_ICMP_ERROR;
+   entry->error                        = 111;
+   entry->offender_ip                  = remote_ip;
+   mock_cciefb_port->error_queue_count = 1;
+
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (mock_cciefb_port->error_queue_count, 0U);
+   EXPECT_EQ (statistics->icmp_errors, 1U);
+   EXPECT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+
+   cls_clear_cciefb_receive_statistics (&cls);
+   EXPECT_EQ (statistics->icmp_errors, 0U);
+}
+
+TEST_F (SlaveIntegrationTestConnected, CciefbInputsChanged)
+{
+   cl_changed_signals_t changed = {};
+
+   /* Cyclic data was received when connecting */
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.calls, 1);
+   EXPECT_EQ (
+      mock_data.slave_cb_inputs_changed.changed.num_occupied_stations,
+      2);
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.changed.words[0], 0x00000003U);
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.changed.words[1], 0x80000003U);
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.changed.bits[0], 0xFFU);
+   EXPECT_EQ (
+      mock_data.slave_cb_inputs_changed.changed.bits[1],
+      0x0800000000000000U);
+
+   /* Accumulated changes are cleared when read */
+   EXPECT_EQ (cls_get_changed_inputs (&cls, &changed), 0);
+   EXPECT_EQ (changed.num_occupied_stations, 2);
+   EXPECT_EQ (changed.words[0], 0x00000003U);
+   EXPECT_EQ (changed.bits[1], 0x0800000000000000U);
+   EXPECT_EQ (cls_get_changed_inputs (&cls, &changed), 0);
+   EXPECT_EQ (changed.words[0], 0U);
+   EXPECT_EQ (changed.words[1], 0U);
+   EXPECT_EQ (changed.bits[0], 0U);
+   EXPECT_EQ (changed.bits[1], 0U);
+
+   /* Same data again */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&request_payload_running,
+      SIZE_REQUEST_3_SLAVES);
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.calls, 1);
+
+   /* Cyclic transmission is off for us. Data is cleared. */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&request_payload_initial,
+      SIZE_REQUEST_3_SLAVES);
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+   EXPECT_EQ (mock_data.slave_cb_inputs_changed.calls, 2);
+   EXPECT_EQ (cls_get_changed_inputs (&cls, &changed), 0);
+   EXPECT_EQ (changed.words[1], 0x80000003U);
+   EXPECT_EQ (changed.bits[0], 0xFFU);
+   EXPECT_EQ (cls_get_rww_value (&cls, 0), 0);
+
+   EXPECT_EQ (cls_get_changed_inputs (nullptr, &changed), -1);
+   EXPECT_EQ (cls_get_changed_inputs (&cls, nullptr), -1);
+}
+
+TEST_F (SlaveIntegrationTestConnected, CciefbBulkAccessors)
+{
+   const uint16_t num_bits  = 2 * CL_BITSIGNALS_PER_AREA;
+   const uint16_t num_words = 2 * CL_WORDSIGNALS_PER_AREA;
+   bool bits[2 * CL_BITSIGNALS_PER_AREA]       = {};
+   uint16_t words[2 * CL_WORDSIGNALS_PER_AREA] = {};
+   uint16_t i;
+
+   /* Read RY and RWw */
+   EXPECT_EQ (cls_get_ry_bits (&cls, 0, num_bits, bits), 0);
+   for (i = 0; i < num_bits; i++)
+   {
+      EXPECT_EQ (bits[i], cls_get_ry_bit (&cls, i)) << "RY" << i;
+   }
+   EXPECT_TRUE (bits[0]);
+   EXPECT_TRUE (bits[123]);
+
+   EXPECT_EQ (cls_get_rww_values (&cls, 0, num_words, words), 0);
+   for (i = 0; i < num_words; i++)
+   {
+      EXPECT_EQ (words[i], cls_get_rww_value (&cls, i)) << "RWw" << i;
+   }
+   EXPECT_EQ (words[0], 0x0022);
+
+   /* Write RX and RWr, spanning both stations */
+   for (i = 0; i < num_bits; i++)
+   {
+      bits[i] = (i % 3) == 1;
+   }
+   EXPECT_EQ (cls_set_rx_bits (&cls, 2, num_bits - 2, bits), 0);
+   EXPECT_FALSE (cls_get_rx_bit (&cls, 0));
+   for (i = 2; i < num_bits; i++)
+   {
+      EXPECT_EQ (cls_get_rx_bit (&cls, i), bits[i - 2]) << "RX" << i;
+   }
+
+   for (i = 0; i < num_words; i++)
+   {
+      words[i] = (uint16_t)(0xA000 + i);
+   }
+   EXPECT_EQ (cls_set_rwr_values (&cls, 0, num_words, words), 0);
+   for (i = 0; i < num_words; i++)
+   {
+      EXPECT_EQ (cls_get_rwr_value (&cls, i), words[i]) << "RWr" << i;
+   }
+
+   /* Invalid arguments */
+   EXPECT_EQ (cls_set_rx_bits (&cls, 0, num_bits + 1, bits), -1);
+   EXPECT_EQ (cls_get_ry_bits (&cls, num_bits, 1, bits), -1);
+   EXPECT_EQ (cls_set_rwr_values (&cls, 1, num_words, words), -1);
+   EXPECT_EQ (cls_get_rww_values (&cls, num_words, 1, words), -1);
+   EXPECT_EQ (cls_get_rww_values (nullptr, 0, 1, words), -1);
+   EXPECT_EQ (cls_set_rx_bits (&cls, 0, 1, nullptr), -1);
+}
+
 /**
  * Verify watchdog for incoming requests
  *
@@ -2770,7 +3015,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterTimesOut)
    EXPECT_EQ (cls.master.parameter_no, parameter_no);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -2815,7 +3060,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterTimesOut)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -2895,7 +3140,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongMaster)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -2928,7 +3173,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongMaster)
    EXPECT_EQ (mock_data.slave_cb_master_running.calls, 2);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -3166,7 +3411,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbChangedLocalManagementInfo)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -3207,6 +3452,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSearchParametersInvalidState)
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
    request.slave_ip_addr = CL_IPADDR_INVALID;
@@ -3244,6 +3490,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSearchParametersWrongMaster)
          remote_ip,
          123, /* remote_port */
          my_ip,
+         nullptr,
          &request),
       0);
    cls.master.master_id = 0x01020355;
@@ -3264,7 +3511,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongStateForIncomingFrames)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
 
    /* Force to other state */
@@ -3292,7 +3539,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongStateForIncomingFrames)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
 
    /* Force to other state */
@@ -3321,7 +3568,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongStateForIncomingFrames)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
 }
 
@@ -3368,7 +3615,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbChangedSlaveErrorCode)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -3503,7 +3750,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbRunningOtherGroup)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3532,7 +3779,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbRunningOtherGroup)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3571,7 +3818,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbRunningWrongNumberOccupied)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3606,7 +3853,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbRunningWrongNumberOccupied)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -3651,7 +3898,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongTotalNumberOccupied)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3684,7 +3931,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongTotalNumberOccupied)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3692,6 +3939,59 @@ TEST_F (SlaveIntegrationTestConnected, CciefbWrongTotalNumberOccupied)
    EXPECT_EQ (mock_cciefb_port->remote_destination_port, CL_CCIEFB_PORT);
 }
 
+/**
+ * Slave reuses its cached station assignment, and searches the slave
+ * parameters again when the number of occupied stations changes
+ *
+ */
+TEST_F (SlaveIntegrationTestConnected, CciefbCachedStationAssignment)
+{
+   ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   EXPECT_EQ (cls.expected_request_size, SIZE_REQUEST_3_SLAVES);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
+
+   /* Cyclic data. Use cached station assignment. */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&request_payload_running,
+      SIZE_REQUEST_3_SLAVES);
+
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+
+   EXPECT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
+   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
+
+   /* Simulate a cached assignment from a group with another number of
+      occupied stations. Search parameters, and as our transmission state
+      still is enabled the frame is dropped. */
+   cls.expected_request_size = SIZE_REQUEST_1_SLAVE;
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_cciefb_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_CCIEFB_PORT,
+      (uint8_t *)&request_payload_running,
+      SIZE_REQUEST_3_SLAVES);
+
+   now += tick_size;
+   cls_iefb_periodic (&cls, now);
+
+   EXPECT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
+   EXPECT_EQ (cls.expected_request_size, SIZE_REQUEST_1_SLAVE);
+   EXPECT_EQ (mock_data.slave_cb_error.calls, 0);
+   EXPECT_EQ (mock_data.slave_cb_connect.calls, 1);
+   EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
+   EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
+}
+
 /**
  * Slave disconnects due to user action
  *
@@ -3714,7 +4014,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3732,7 +4032,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -3765,7 +4065,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
       CL_CCIEFB_MASTER_LOCAL_UNIT_INFO_STOPPED);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -3822,7 +4122,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
 
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -3878,7 +4178,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 12);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 5 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -3896,7 +4196,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 13);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 5 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -3922,7 +4222,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 9);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 15);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 6 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -3948,7 +4248,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 17);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 7 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -3980,7 +4280,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopNoError)
    ASSERT_EQ (cls.state, CLS_SLAVE_STATE_MASTER_CONTROL);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 11);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 19);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 5);
    EXPECT_EQ (mock_data.slave_cb_state.calls, 6);
    EXPECT_EQ (mock_data.slave_cb_state.state, CLS_SLAVE_STATE_MASTER_CONTROL);
@@ -4044,7 +4344,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4060,7 +4360,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopError)
    EXPECT_EQ (mock_data.slave_cb_state.state, CLS_SLAVE_STATE_WAIT_DISABLING_SLAVE);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4087,7 +4387,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbApplicationStopError)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 1);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4149,7 +4449,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbFrameSequenceRestartsAtZero)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4179,7 +4479,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbFrameSequenceRestartsAtZero)
    EXPECT_EQ (mock_data.slave_cb_connect.calls, 1);
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4217,7 +4517,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveDisabled)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4246,7 +4546,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveDisabled)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4282,7 +4582,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbNewParameterNumber)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4312,7 +4612,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbNewParameterNumber)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4380,7 +4680,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterStateChanged)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4416,7 +4716,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterStateChanged)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4474,7 +4774,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterStateChanged)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
@@ -4536,7 +4836,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterStoppedByUser)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4573,7 +4873,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterStoppedByUser)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4621,7 +4921,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveIdInvalid)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 2 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4651,7 +4951,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveIdInvalid)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
@@ -4680,7 +4980,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveIdInvalid)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4711,7 +5011,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbSlaveIdInvalid)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 7);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 12);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 5 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4766,7 +5066,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterDisconnectsSlave)
    EXPECT_EQ (mock_data.slave_cb_connect.calls, 1);
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 2 * SIZE_RESPONSE_2_SLAVES);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 4);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 2);
 
    /* Set input data in slave */
@@ -4795,7 +5095,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterDisconnectsSlave)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 5);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 8);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 3);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 3 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 3 * SIZE_RESPONSE_2_SLAVES);
@@ -4860,7 +5160,7 @@ TEST_F (SlaveIntegrationTestConnected, CciefbMasterDisconnectsSlave)
    EXPECT_EQ (mock_data.slave_cb_disconnect.calls, 0);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_open, 1);
    EXPECT_EQ (mock_cciefb_port->is_open, true);
-   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 6);
+   EXPECT_EQ (mock_cciefb_port->number_of_calls_recv, 10);
    EXPECT_EQ (mock_cciefb_port->number_of_calls_send, 4);
    EXPECT_EQ (mock_cciefb_port->total_recv_bytes, 4 * SIZE_REQUEST_3_SLAVES);
    EXPECT_EQ (mock_cciefb_port->total_sent_bytes, 4 * SIZE_RESPONSE_2_SLAVES);
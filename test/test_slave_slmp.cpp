@@ -107,7 +107,7 @@ TEST_F (SlaveIntegrationTestNotConnected, SlmpNodeSearch)
    ASSERT_TRUE (mock_data.udp_ports[1].in_use);
    ASSERT_TRUE (mock_data.udp_ports[1].is_open);
    ASSERT_TRUE (mock_data.udp_ports[2].in_use);
-   ASSERT_FALSE (mock_data.udp_ports[2].is_open);
+   ASSERT_TRUE (mock_data.udp_ports[2].is_open);
    ASSERT_FALSE (mock_data.udp_ports[3].in_use);
 
    EXPECT_EQ (mock_slmp_port->number_of_calls_open, 1);
@@ -142,6 +142,24 @@ TEST_F (SlaveIntegrationTestNotConnected, SlmpNodeSearch)
    EXPECT_EQ (result.model_code, config.model_code);
    EXPECT_EQ (result.equipment_ver, config.equipment_ver);
    EXPECT_EQ (result.slave_status, CL_SLMP_NODE_SEARCH_RESP_SERVER_STATUS_NORMAL);
+
+   /* The send socket has the same source address as before */
+   EXPECT_EQ (mock_slmp_send_port->port_number, CL_SLMP_PORT);
+   EXPECT_EQ (mock_slmp_send_port->ip_addr, my_ip);
+
+   /* Frames delivered to the send socket are also handled */
+   mock_set_udp_fakedata_with_local_ipaddr (
+      mock_slmp_send_port,
+      my_ip,
+      my_ifindex,
+      remote_ip,
+      CL_SLMP_PORT,
+      (uint8_t *)&request_node_search,
+      SIZE_REQUEST_NODE_SEARCH);
+   now += tick_size;
+   cls_slmp_periodic (&cls, now);
+   EXPECT_EQ (mock_slmp_send_port->input_data_size, 0U);
+   EXPECT_EQ (mock_data.slave_cb_nodesearch.calls, 2);
 }
 
 /**
@@ -119,6 +119,31 @@ void my_slave_set_ip_ind (
    cl_util_copy_mac (&mock->slave_cb_set_ip.master_mac_addr, master_mac_addr);
 }
 
+void my_slave_inputs_changed_ind (
+   cls_t * cls,
+   void * arg,
+   const cl_changed_signals_t * changed)
+{
+   auto * mock = static_cast<cl_mock_data_t *> (arg);
+
+   mock->slave_cb_inputs_changed.calls++;
+   mock->slave_cb_inputs_changed.changed = *changed;
+}
+
+void my_slave_command_cfm (
+   cls_t * cls,
+   void * arg,
+   const cls_command_t * command,
+   int result)
+{
+   auto * mock = static_cast<cl_mock_data_t *> (arg);
+
+   mock->slave_cb_command.calls++;
+   mock->slave_cb_command.type   = command->type;
+   mock->slave_cb_command.tag    = command->tag;
+   mock->slave_cb_command.result = result;
+}
+
 /************************* Callbacks in master ******************************/
 
 void my_master_state_ind (clm_t * clm, void * arg, clm_master_state_t state)
@@ -226,6 +251,21 @@ void my_master_changed_slave_info_ind (
       local_management_info;
 }
 
+void my_master_inputs_changed_ind (
+   clm_t * clm,
+   void * arg,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   const cl_changed_signals_t * changed)
+{
+   auto * counters = static_cast<cl_mock_master_callback_counters_t *> (arg);
+
+   counters->master_cb_inputs_changed.calls++;
+   counters->master_cb_inputs_changed.group_index        = group_index;
+   counters->master_cb_inputs_changed.slave_device_index = slave_device_index;
+   counters->master_cb_inputs_changed.changed            = *changed;
+}
+
 void my_master_node_search_result_cfm (
    clm_t * clm,
    void * arg,
@@ -248,3 +288,17 @@ void my_master_set_ip_cfm (clm_t * clm, void * arg, clm_master_setip_status_t st
    counters->master_cb_set_ip.calls++;
    counters->master_cb_set_ip.status = status;
 }
+
+void my_master_command_cfm (
+   clm_t * clm,
+   void * arg,
+   const clm_command_t * command,
+   int result)
+{
+   auto * counters = static_cast<cl_mock_master_callback_counters_t *> (arg);
+
+   counters->master_cb_command.calls++;
+   counters->master_cb_command.type   = command->type;
+   counters->master_cb_command.tag    = command->tag;
+   counters->master_cb_command.result = result;
+}
@@ -167,6 +167,17 @@ void my_slave_set_ip_ind (
    bool ip_setting_allowed,
    bool did_set_ip);
 
+void my_slave_inputs_changed_ind (
+   cls_t * cls,
+   void * arg,
+   const cl_changed_signals_t * changed);
+
+void my_slave_command_cfm (
+   cls_t * cls,
+   void * arg,
+   const cls_command_t * command,
+   int result);
+
 /************************* Master callbacks *******************************/
 
 void my_master_state_ind (clm_t * clm, void * arg, clm_master_state_t state);
@@ -216,6 +227,13 @@ void my_master_changed_slave_info_ind (
    uint16_t slave_err_code,
    uint32_t local_management_info);
 
+void my_master_inputs_changed_ind (
+   clm_t * clm,
+   void * arg,
+   uint16_t group_index,
+   uint16_t slave_device_index,
+   const cl_changed_signals_t * changed);
+
 void my_master_node_search_result_cfm (
    clm_t * clm,
    void * arg,
@@ -223,6 +241,12 @@ void my_master_node_search_result_cfm (
 
 void my_master_set_ip_cfm (clm_t * clm, void * arg, clm_master_setip_status_t status);
 
+void my_master_command_cfm (
+   clm_t * clm,
+   void * arg,
+   const clm_command_t * command,
+   int result);
+
 /************************* Data frames **************************************/
 
 inline uint8_t request_node_search[] = {
@@ -876,6 +900,8 @@ class SlaveUnitTest : public UnitTest
       config.master_running_cb           = my_slave_master_running_ind;
       config.node_search_cb              = my_slave_node_search_ind;
       config.set_ip_cb                   = my_slave_set_ip_ind;
+      config.inputs_changed_cb           = my_slave_inputs_changed_ind;
+      config.command_cfm_cb              = my_slave_command_cfm;
       config.cb_arg                      = &mock_data;
       config.use_slmp_directed_broadcast = false;
 
@@ -966,8 +992,10 @@ class MasterUnitTest : public UnitTest
       config.alarm_cb                     = my_master_alarm_ind;
       config.error_cb                     = my_master_error_ind;
       config.changed_slave_info_cb        = my_master_changed_slave_info_ind;
+      config.inputs_changed_cb            = my_master_inputs_changed_ind;
       config.node_search_cfm_cb           = my_master_node_search_result_cfm;
       config.set_ip_cfm_cb                = my_master_set_ip_cfm;
+      config.command_cfm_cb               = my_master_command_cfm;
       config.cb_arg                       = cb_counters;
       config.use_slmp_directed_broadcast  = false;
       config.protocol_ver                 = 2;